@@ -778,6 +778,11 @@ public:
     uint64_t PseudoProbeLooseMatchedSampleCount{0};
     ///   the count of call matched samples
     uint64_t CallMatchedSampleCount{0};
+    ///   the number of functions whose stale profile was dropped because
+    ///   inference could not be applied after matching
+    uint32_t NumDroppedStaleFuncs{0};
+    ///   the count of samples in the profiles of dropped functions
+    uint64_t DroppedStaleSampleCount{0};
   } Stats;
 
   // Original binary execution count stats.
@@ -27,6 +27,11 @@ namespace CacheMetrics {
 void printAll(raw_ostream &OS,
               const std::vector<BinaryFunction *> &BinaryFunctions);
 
+/// Write the same metrics, plus the placement of every profiled function, as
+/// a JSON object suitable for comparing the layouts of two builds
+void printJSON(raw_ostream &OS,
+               const std::vector<BinaryFunction *> &BinaryFunctions);
+
 } // namespace CacheMetrics
 } // namespace bolt
 } // namespace llvm
@@ -359,7 +359,6 @@ void DIEBuilder::buildCompileUnits(const std::vector<DWARFUnit *> &CUs) {
 }
 
 void DIEBuilder::buildDWOUnit(DWARFUnit &U) {
-  BuilderState.release();
   BuilderState = std::make_unique<State>();
   buildTypeUnits(nullptr, false);
   getState().Type = ProcessingType::CUs;
@@ -544,13 +544,19 @@ bool ReorderBasicBlocks::modifyFunctionLayout(BinaryFunction &BF,
 }
 
 Error FixupBranches::runOnFunctions(BinaryContext &BC) {
-  for (auto &It : BC.getBinaryFunctions()) {
-    BinaryFunction &Function = It.second;
-    if (!BC.shouldEmit(Function) || !Function.isSimple())
-      continue;
+  // fixBranches() only touches the function's own CFG and takes the context
+  // lock around the MCContext updates, so functions can be fixed in parallel.
+  ParallelUtilities::WorkFuncTy WorkFun = [&](BinaryFunction &BF) {
+    BF.fixBranches();
+  };
 
-    Function.fixBranches();
-  }
+  ParallelUtilities::PredicateTy SkipPredicate = [&](const BinaryFunction &BF) {
+    return !BC.shouldEmit(BF) || !BF.isSimple();
+  };
+
+  ParallelUtilities::runOnEachFunction(
+      BC, ParallelUtilities::SchedulingPolicy::SP_BB_LINEAR, WorkFun,
+      SkipPredicate, "FixupBranches");
   return Error::success();
 }
 
@@ -1593,6 +1599,14 @@ Error PrintProgramStats::runOnFunctions(BinaryContext &BC) {
         100.0 * BC.Stats.LooseMatchedSampleCount / BC.Stats.StaleSampleCount,
         BC.Stats.LooseMatchedSampleCount, BC.Stats.StaleSampleCount);
   }
+  if (BC.Stats.NumDroppedStaleFuncs) {
+    BC.outs() << format(
+        "BOLT-INFO: dropped stale profile for %u functions after matching,"
+        " responsible for %.2f%% samples (%zu out of %zu stale)\n",
+        BC.Stats.NumDroppedStaleFuncs,
+        100.0 * BC.Stats.DroppedStaleSampleCount / BC.Stats.StaleSampleCount,
+        BC.Stats.DroppedStaleSampleCount, BC.Stats.StaleSampleCount);
+  }
 
   if (const uint64_t NumUnusedObjects = BC.getNumUnusedProfiledObjects()) {
     BC.outs() << "BOLT-INFO: profile for " << NumUnusedObjects
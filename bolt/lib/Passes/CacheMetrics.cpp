@@ -14,6 +14,7 @@
 #include "bolt/Passes/CacheMetrics.h"
 #include "bolt/Core/BinaryBasicBlock.h"
 #include "bolt/Core/BinaryFunction.h"
+#include "llvm/Support/JSON.h"
 #include <unordered_map>
 
 using namespace llvm;
@@ -210,72 +211,126 @@ double expectedCacheHitRatio(
   return 100.0 * (1.0 - Misses / TotalSamples);
 }
 
-} // namespace
-
-void CacheMetrics::printAll(raw_ostream &OS,
-                            const std::vector<BinaryFunction *> &BFs) {
-  // Stats related to hot-cold code splitting
+/// Code size and layout statistics shared by the text and JSON reports.
+struct LayoutSummary {
   size_t NumFunctions = 0;
   size_t NumProfiledFunctions = 0;
   size_t NumHotFunctions = 0;
   size_t NumBlocks = 0;
   size_t NumHotBlocks = 0;
+  size_t HotCodeSize = 0;
+  size_t TotalCodeSize = 0;
+  double ITLBHitRatio = 0.0;
+  uint64_t TSPScore = 0;
+  uint64_t TSPJumpCount = 0;
+};
+
+LayoutSummary summarize(const std::vector<BinaryFunction *> &BFs) {
+  LayoutSummary Summary;
 
+  // Stats related to hot-cold code splitting
   size_t TotalCodeMinAddr = std::numeric_limits<size_t>::max();
   size_t TotalCodeMaxAddr = 0;
   size_t HotCodeMinAddr = std::numeric_limits<size_t>::max();
   size_t HotCodeMaxAddr = 0;
 
   for (BinaryFunction *BF : BFs) {
-    NumFunctions++;
+    Summary.NumFunctions++;
     if (BF->hasProfile())
-      NumProfiledFunctions++;
+      Summary.NumProfiledFunctions++;
     if (BF->hasValidIndex())
-      NumHotFunctions++;
+      Summary.NumHotFunctions++;
     for (const BinaryBasicBlock &BB : *BF) {
-      NumBlocks++;
+      Summary.NumBlocks++;
       size_t BBAddrMin = BB.getOutputAddressRange().first;
       size_t BBAddrMax = BB.getOutputAddressRange().second;
       TotalCodeMinAddr = std::min(TotalCodeMinAddr, BBAddrMin);
       TotalCodeMaxAddr = std::max(TotalCodeMaxAddr, BBAddrMax);
       if (BF->hasValidIndex() && !BB.isCold()) {
-        NumHotBlocks++;
+        Summary.NumHotBlocks++;
         HotCodeMinAddr = std::min(HotCodeMinAddr, BBAddrMin);
         HotCodeMaxAddr = std::max(HotCodeMaxAddr, BBAddrMax);
       }
     }
   }
 
-  OS << format("  There are %zu functions;", NumFunctions)
-     << format(" %zu (%.2lf%%) are in the hot section,", NumHotFunctions,
-               100.0 * NumHotFunctions / NumFunctions)
-     << format(" %zu (%.2lf%%) have profile\n", NumProfiledFunctions,
-               100.0 * NumProfiledFunctions / NumFunctions);
-  OS << format("  There are %zu basic blocks;", NumBlocks)
-     << format(" %zu (%.2lf%%) are in the hot section\n", NumHotBlocks,
-               100.0 * NumHotBlocks / NumBlocks);
-
   assert(TotalCodeMinAddr <= TotalCodeMaxAddr && "incorrect output addresses");
-  size_t HotCodeSize = HotCodeMaxAddr - HotCodeMinAddr;
-  size_t TotalCodeSize = TotalCodeMaxAddr - TotalCodeMinAddr;
-
-  size_t HugePage2MB = 2 << 20;
-  OS << format("  Hot code takes %.2lf%% of binary (%zu bytes out of %zu, "
-               "%.2lf huge pages)\n",
-               100.0 * HotCodeSize / TotalCodeSize, HotCodeSize, TotalCodeSize,
-               double(HotCodeSize) / HugePage2MB);
+  Summary.HotCodeSize = HotCodeMaxAddr - HotCodeMinAddr;
+  Summary.TotalCodeSize = TotalCodeMaxAddr - TotalCodeMinAddr;
 
   // Stats related to expected cache performance
   std::unordered_map<BinaryBasicBlock *, uint64_t> BBAddr;
   std::unordered_map<BinaryBasicBlock *, uint64_t> BBSize;
   extractBasicBlockInfo(BFs, BBAddr, BBSize);
 
+  Summary.ITLBHitRatio = expectedCacheHitRatio(BFs, BBAddr, BBSize);
+  std::tie(Summary.TSPScore, Summary.TSPJumpCount) =
+      calcTSPScore(BFs, BBAddr, BBSize);
+  return Summary;
+}
+
+} // namespace
+
+void CacheMetrics::printAll(raw_ostream &OS,
+                            const std::vector<BinaryFunction *> &BFs) {
+  const LayoutSummary S = summarize(BFs);
+
+  OS << format("  There are %zu functions;", S.NumFunctions)
+     << format(" %zu (%.2lf%%) are in the hot section,", S.NumHotFunctions,
+               100.0 * S.NumHotFunctions / S.NumFunctions)
+     << format(" %zu (%.2lf%%) have profile\n", S.NumProfiledFunctions,
+               100.0 * S.NumProfiledFunctions / S.NumFunctions);
+  OS << format("  There are %zu basic blocks;", S.NumBlocks)
+     << format(" %zu (%.2lf%%) are in the hot section\n", S.NumHotBlocks,
+               100.0 * S.NumHotBlocks / S.NumBlocks);
+
+  size_t HugePage2MB = 2 << 20;
+  OS << format("  Hot code takes %.2lf%% of binary (%zu bytes out of %zu, "
+               "%.2lf huge pages)\n",
+               100.0 * S.HotCodeSize / S.TotalCodeSize, S.HotCodeSize,
+               S.TotalCodeSize, double(S.HotCodeSize) / HugePage2MB);
+
   OS << "  Expected i-TLB cache hit ratio: "
-     << format("%.2lf%%\n", expectedCacheHitRatio(BFs, BBAddr, BBSize));
+     << format("%.2lf%%\n", S.ITLBHitRatio);
 
-  auto Stats = calcTSPScore(BFs, BBAddr, BBSize);
   OS << "  TSP score: "
      << format("%.2lf%% (%zu out of %zu)\n",
-               100.0 * Stats.first / std::max<uint64_t>(Stats.second, 1),
-               Stats.first, Stats.second);
+               100.0 * S.TSPScore / std::max<uint64_t>(S.TSPJumpCount, 1),
+               S.TSPScore, S.TSPJumpCount);
+}
+
+void CacheMetrics::printJSON(raw_ostream &OS,
+                             const std::vector<BinaryFunction *> &BFs) {
+  const LayoutSummary S = summarize(BFs);
+
+  json::OStream J(OS, /*IndentSize=*/2);
+  J.object([&] {
+    J.attribute("functions", S.NumFunctions);
+    J.attribute("profiled-functions", S.NumProfiledFunctions);
+    J.attribute("hot-functions", S.NumHotFunctions);
+    J.attribute("blocks", S.NumBlocks);
+    J.attribute("hot-blocks", S.NumHotBlocks);
+    J.attribute("hot-code-size", S.HotCodeSize);
+    J.attribute("total-code-size", S.TotalCodeSize);
+    J.attribute("itlb-hit-ratio", S.ITLBHitRatio);
+    J.attribute("tsp-score", S.TSPScore);
+    J.attribute("tsp-jump-count", S.TSPJumpCount);
+    // Per-function placement of the profiled code, so that layouts of two
+    // builds can be compared function by function.
+    J.attributeArray("profiled", [&] {
+      for (const BinaryFunction *BF : BFs) {
+        if (!BF->hasProfile() || BF->getLayout().block_empty())
+          continue;
+        J.object([&] {
+          J.attribute("name", BF->getOneName());
+          J.attribute("exec-count", BF->getKnownExecutionCount());
+          J.attribute("hot", BF->hasValidIndex());
+          std::pair<uint64_t, uint64_t> Range =
+              BF->getLayout().block_front()->getOutputAddressRange();
+          J.attribute("address", Range.first);
+        });
+      }
+    });
+  });
+  OS << '\n';
 }
@@ -58,6 +58,9 @@ Error PatchEntries::runOnFunctions(BinaryContext &BC) {
     PatchSize = BC.computeCodeSize(Seq.begin(), Seq.end());
   }
 
+  uint64_t NumPatchedFunctions = 0;
+  uint64_t NumPatchedEntries = 0;
+
   for (auto &BFI : BC.getBinaryFunctions()) {
     BinaryFunction &Function = BFI.second;
 
@@ -107,6 +110,8 @@ Error PatchEntries::runOnFunctions(BinaryContext &BC) {
       continue;
     }
 
+    ++NumPatchedFunctions;
+    NumPatchedEntries += PendingPatches.size();
     for (Patch &Patch : PendingPatches) {
       // Add instruction patch to the binary.
       InstructionListType Instructions;
@@ -122,6 +127,10 @@ Error PatchEntries::runOnFunctions(BinaryContext &BC) {
       assert(HotSize <= PatchSize && "max patch size exceeded");
     }
   }
+
+  if (opts::Verbosity >= 1)
+    BC.outs() << "BOLT-INFO: patched " << NumPatchedEntries
+              << " entry points in " << NumPatchedFunctions << " functions\n";
   return Error::success();
 }
 
@@ -16,6 +16,7 @@
 // - estimate temporal locality by looking at CFG?
 
 #include "bolt/Passes/ReorderData.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/MapVector.h"
 #include <algorithm>
 
@@ -129,6 +130,21 @@ bool filterSymbol(const BinaryData *BD) {
   return IsValid;
 }
 
+/// Return the number of distinct \p UnitSize-aligned units (cache lines or
+/// pages) covered by the given [start, size) ranges.
+uint64_t countSpannedUnits(ArrayRef<std::pair<uint64_t, uint64_t>> Ranges,
+                           uint64_t UnitSize) {
+  DenseSet<uint64_t> Units;
+  for (const auto &[Start, Size] : Ranges) {
+    if (!Size)
+      continue;
+    const uint64_t LastUnit = (Start + Size - 1) / UnitSize;
+    for (uint64_t Unit = Start / UnitSize; Unit <= LastUnit; ++Unit)
+      Units.insert(Unit);
+  }
+  return Units.size();
+}
+
 } // namespace
 
 using DataOrder = ReorderData::DataOrder;
@@ -335,6 +351,12 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
                                   DataOrder::iterator Begin,
                                   DataOrder::iterator End) {
   std::vector<BinaryData *> NewOrder;
+  // Locations of the sampled symbols before and after reordering, used to
+  // estimate the change in the number of cache lines and pages they touch.
+  // New locations are offsets, i.e. the output section is assumed to start
+  // on a page boundary.
+  std::vector<std::pair<uint64_t, uint64_t>> OldHotRanges;
+  std::vector<std::pair<uint64_t, uint64_t>> NewHotRanges;
   unsigned NumReordered = 0;
   uint64_t Offset = 0;
   uint64_t Count = 0;
@@ -389,6 +411,11 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
       }
     }
 
+    if (Begin->second) {
+      OldHotRanges.emplace_back(BD->getAddress(), BD->getSize());
+      NewHotRanges.emplace_back(Offset, BD->getSize());
+    }
+
     Offset += BD->getSize();
     Count += Begin->second;
     NewOrder.push_back(BD);
@@ -399,6 +426,18 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
   BC.outs() << "BOLT-INFO: reorder-data: " << Count << "/" << TotalCount
             << format(" (%.1f%%)", 100.0 * Count / TotalCount) << " events, "
             << Offset << " hot bytes\n";
+
+  if (!OldHotRanges.empty()) {
+    constexpr uint64_t CacheLineSize = 64;
+    constexpr uint64_t PageSize = 4096;
+    BC.outs() << "BOLT-INFO: reorder-data: sampled symbols span "
+              << countSpannedUnits(NewHotRanges, CacheLineSize)
+              << " cache lines in " << countSpannedUnits(NewHotRanges, PageSize)
+              << " pages (was "
+              << countSpannedUnits(OldHotRanges, CacheLineSize)
+              << " cache lines in " << countSpannedUnits(OldHotRanges, PageSize)
+              << " pages)\n";
+  }
 }
 
 bool ReorderData::markUnmoveableSymbols(BinaryContext &BC,
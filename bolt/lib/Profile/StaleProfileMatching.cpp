@@ -1005,17 +1005,23 @@ bool YAMLProfileReader::inferStaleProfile(
   FlowFunction Func = createFlowFunction(BlockOrder);
 
   // Match as many block/jump counts from the stale profile as possible
+  BinaryContext &BC = BF.getBinaryContext();
+  const uint64_t PrevStaleSampleCount = BC.Stats.StaleSampleCount;
   size_t MatchedBlocks =
-      matchWeights(BF.getBinaryContext(), BlockOrder, YamlBF, Func,
-                   YamlBP.Header.HashFunction, IdToYamLBF, BF, ProbeMatchSpecs);
+      matchWeights(BC, BlockOrder, YamlBF, Func, YamlBP.Header.HashFunction,
+                   IdToYamLBF, BF, ProbeMatchSpecs);
 
   // Adjust the flow function by marking unreachable blocks Unlikely so that
   // they don't get any counts assigned.
   preprocessUnreachableBlocks(Func);
 
   // Check if profile inference can be applied for the instance.
-  if (!canApplyInference(Func, YamlBF, MatchedBlocks))
+  if (!canApplyInference(Func, YamlBF, MatchedBlocks)) {
+    ++BC.Stats.NumDroppedStaleFuncs;
+    BC.Stats.DroppedStaleSampleCount +=
+        BC.Stats.StaleSampleCount - PrevStaleSampleCount;
     return false;
+  }
 
   // Apply the profile inference algorithm.
   applyInference(Func);
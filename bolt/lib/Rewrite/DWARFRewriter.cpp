@@ -761,9 +761,14 @@ void DWARFRewriter::updateDebugInfo() {
                        DWOName, DwarfOutputPath, DWODIEBuilder);
       });
     }
+    // The workers add cross-CU DIEs to DebugNamesTable, so the whole batch has
+    // to finish before the main thread updates the table. Drop each DIE tree
+    // as soon as it has been indexed rather than at the end of the batch.
     ThreadPool.wait();
-    for (std::unique_ptr<DIEBuilder> &DWODIEBuilderPtr : DWODIEBuildersByCU)
+    for (std::unique_ptr<DIEBuilder> &DWODIEBuilderPtr : DWODIEBuildersByCU) {
       DWODIEBuilderPtr->updateDebugNamesTable();
+      DWODIEBuilderPtr.reset();
+    }
     for (DWARFUnit *CU : DIEBlder.getProcessedCUs())
       processMainBinaryCU(*CU, DIEBlder);
     finalizeCompileUnits(DIEBlder, *Streamer, OffsetMap,
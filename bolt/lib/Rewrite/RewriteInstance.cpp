@@ -3801,6 +3801,12 @@ void RewriteInstance::emitAndLink() {
     BC->outs() << "BOLT-INFO: cache metrics after emitting functions:\n";
     CacheMetrics::printAll(BC->outs(), BC->getSortedFunctions());
   }
+  if (!opts::CacheMetricsJSON.empty()) {
+    std::error_code EC;
+    raw_fd_ostream OS(opts::CacheMetricsJSON, EC, sys::fs::OF_Text);
+    check_error(EC, "cannot create cache metrics file");
+    CacheMetrics::printJSON(OS, BC->getSortedFunctions());
+  }
 }
 
 void RewriteInstance::finalizeMetadataPreEmit() {
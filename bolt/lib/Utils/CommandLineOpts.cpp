@@ -240,6 +240,12 @@ PerfDataA("p",
   cl::aliasopt(PerfData),
   cl::cat(AggregatorCategory));
 
+cl::opt<std::string> CacheMetricsJSON(
+    "cache-metrics-json",
+    cl::desc("write instruction cache metrics and the placement of profiled "
+             "functions to the given file in JSON format"),
+    cl::value_desc("filename"), cl::cat(BoltOptCategory));
+
 cl::opt<bool> PrintCacheMetrics(
     "print-cache-metrics",
     cl::desc("calculate and print various metrics for instruction cache"),
@@ -263,6 +263,27 @@ bool isYAML(const StringRef Filename) {
   return false;
 }
 
+/// Read a YAML profile from \p Filename into \p BP, exiting on failure.
+void parseYAMLProfile(const std::string &Filename, BinaryProfile &BP) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> MB =
+      MemoryBuffer::getFileOrSTDIN(Filename);
+  if (std::error_code EC = MB.getError())
+    report_error(Filename, EC);
+  yaml::Input YamlInput(MB.get()->getBuffer());
+  YamlInput.setAllowUnknownKeys(true);
+
+  YamlInput >> BP;
+  if (YamlInput.error())
+    report_error(Filename, YamlInput.error());
+
+  // Sanity check.
+  if (BP.Header.Version != 1) {
+    errs() << "Unable to merge data from profile using version "
+           << BP.Header.Version << '\n';
+    exit(1);
+  }
+}
+
 void mergeLegacyProfiles(const SmallVectorImpl<std::string> &Filenames) {
   errs() << "Using legacy profile format.\n";
   std::optional<bool> BoltedCollection;
@@ -412,48 +433,47 @@ int main(int argc, char **argv) {
   // Merged information for all functions.
   StringMap<BinaryFunctionProfile> MergedBFs;
 
+  // Parse the inputs in parallel, one batch at a time, and fold each batch into
+  // the merged profile in input order. Only a batch worth of parsed profiles
+  // is kept in memory, independent of the number of inputs.
+  DefaultThreadPool Pool(optimal_concurrency(Inputs.size()));
+  const size_t BatchSize = Pool.getMaxConcurrency();
+  std::vector<BinaryProfile> Batch;
+
   bool FirstHeader = true;
-  for (std::string &InputDataFilename : Inputs) {
-    ErrorOr<std::unique_ptr<MemoryBuffer>> MB =
-        MemoryBuffer::getFileOrSTDIN(InputDataFilename);
-    if (std::error_code EC = MB.getError())
-      report_error(InputDataFilename, EC);
-    yaml::Input YamlInput(MB.get()->getBuffer());
-    YamlInput.setAllowUnknownKeys(true);
-
-    errs() << "Merging data from " << InputDataFilename << "...\n";
-
-    BinaryProfile BP;
-    YamlInput >> BP;
-    if (YamlInput.error())
-      report_error(InputDataFilename, YamlInput.error());
-
-    // Sanity check.
-    if (BP.Header.Version != 1) {
-      errs() << "Unable to merge data from profile using version "
-             << BP.Header.Version << '\n';
-      exit(1);
-    }
+  for (size_t Begin = 0; Begin < Inputs.size(); Begin += BatchSize) {
+    const size_t Count = std::min(BatchSize, Inputs.size() - Begin);
+    ArrayRef<std::string> BatchInputs = ArrayRef(Inputs).slice(Begin, Count);
+    Batch.clear();
+    Batch.resize(BatchInputs.size());
+    for (auto [InputDataFilename, BP] : llvm::zip_equal(BatchInputs, Batch))
+      Pool.async(parseYAMLProfile, std::cref(InputDataFilename), std::ref(BP));
+    Pool.wait();
+
+    for (auto [InputDataFilename, BP] : llvm::zip_equal(BatchInputs, Batch)) {
+      errs() << "Merging data from " << InputDataFilename << "...\n";
+
+      // Merge the header.
+      if (FirstHeader) {
+        MergedHeader = BP.Header;
+        FirstHeader = false;
+      } else {
+        mergeProfileHeaders(MergedHeader, BP.Header);
+      }
 
-    // Merge the header.
-    if (FirstHeader) {
-      MergedHeader = BP.Header;
-      FirstHeader = false;
-    } else {
-      mergeProfileHeaders(MergedHeader, BP.Header);
-    }
+      // Do the function merge.
+      for (BinaryFunctionProfile &BF : BP.Functions) {
+        if (!MergedBFs.count(BF.Name)) {
+          MergedBFs.insert(std::make_pair(BF.Name, std::move(BF)));
+          continue;
+        }
 
-    // Do the function merge.
-    for (BinaryFunctionProfile &BF : BP.Functions) {
-      if (!MergedBFs.count(BF.Name)) {
-        MergedBFs.insert(std::make_pair(BF.Name, BF));
-        continue;
+        BinaryFunctionProfile &MergedBF = MergedBFs.find(BF.Name)->second;
+        mergeFunctionProfile(MergedBF, std::move(BF));
       }
-
-      BinaryFunctionProfile &MergedBF = MergedBFs.find(BF.Name)->second;
-      mergeFunctionProfile(MergedBF, std::move(BF));
     }
   }
+  Batch.clear();
 
   if (!opts::SuppressMergedDataOutput) {
     yaml::Output YamlOut(output());
@@ -411,6 +411,36 @@ static CheckersList getAnalyzerCheckersAndPackages(ClangTidyContext &Context,
 }
 #endif // CLANG_TIDY_ENABLE_STATIC_ANALYZER
 
+// Returns whether the lines spanned by \p Range overlap \p LineFilter. Ranges
+// that can't be attributed to a single file are assumed to overlap.
+static bool overlapsLineFilter(const SourceManager &SM, SourceRange Range,
+                               ArrayRef<FileFilter> LineFilter) {
+  const CharSourceRange Expansion = SM.getExpansionRange(Range);
+  const SourceLocation Begin = Expansion.getBegin();
+  const SourceLocation End = Expansion.getEnd();
+  if (Begin.isInvalid() || End.isInvalid() ||
+      !SM.isWrittenInSameFile(Begin, End))
+    return true;
+  const StringRef FileName = SM.getFilename(Begin);
+  if (FileName.empty())
+    return true;
+
+  const unsigned BeginLine = SM.getExpansionLineNumber(Begin);
+  const unsigned EndLine = SM.getExpansionLineNumber(End);
+  for (const FileFilter &Filter : LineFilter) {
+    if (!FileName.ends_with(Filter.Name))
+      continue;
+    if (Filter.LineRanges.empty())
+      return true;
+    return llvm::any_of(Filter.LineRanges,
+                        [&](const FileFilter::LineRange &Lines) {
+                          return Lines.first <= EndLine &&
+                                 BeginLine <= Lines.second;
+                        });
+  }
+  return false;
+}
+
 std::unique_ptr<clang::ASTConsumer>
 ClangTidyASTConsumerFactory::createASTConsumer(
     clang::CompilerInstance &Compiler, StringRef File) {
@@ -447,6 +477,14 @@ ClangTidyASTConsumerFactory::createASTConsumer(
   if (!Context.getOptions().SystemHeaders.value_or(false))
     FinderOptions.IgnoreSystemHeaders = true;
 
+  const ClangTidyGlobalOptions &GlobalOptions = Context.getGlobalOptions();
+  if (GlobalOptions.SkipDeclsOutsideLineFilter &&
+      !GlobalOptions.LineFilter.empty())
+    FinderOptions.TopLevelDeclFilter = [SM, &GlobalOptions](const Decl &D) {
+      return overlapsLineFilter(*SM, D.getSourceRange(),
+                                GlobalOptions.LineFilter);
+    };
+
   std::unique_ptr<ast_matchers::MatchFinder> Finder(
       new ast_matchers::MatchFinder(std::move(FinderOptions)));
 
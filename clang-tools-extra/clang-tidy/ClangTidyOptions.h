@@ -44,6 +44,9 @@ struct ClangTidyGlobalOptions {
   /// Output warnings from certain line ranges of certain files only.
   /// If empty, no warnings will be filtered.
   std::vector<FileFilter> LineFilter;
+
+  /// Only match namespace-scope declarations that overlap the LineFilter.
+  bool SkipDeclsOutsideLineFilter = false;
 };
 
 /// Contains options for clang-tidy. These options may be read from
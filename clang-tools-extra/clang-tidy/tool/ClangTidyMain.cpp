@@ -183,6 +183,18 @@ entire 'file2.h'.
                                        cl::init(""),
                                        cl::cat(ClangTidyCategory));
 
+static cl::opt<bool>
+    SkipDeclsOutsideLineFilter("skip-decls-outside-line-filter", desc(R"(
+Only run the AST matchers on namespace-scope
+declarations that overlap the ranges of -line-filter,
+so that the time spent on a large file depends on
+the size of the changed ranges rather than of the
+file. Checks that relate several declarations, such
+as misc-unused-using-decls, see only the matched
+declarations and may report spurious diagnostics.
+)"),
+                               cl::init(false), cl::cat(ClangTidyCategory));
+
 static cl::opt<bool> Fix("fix", desc(R"(
 Apply suggested fixes. Without -fix-errors
 clang-tidy will bail out if any compilation
@@ -395,6 +407,7 @@ createOptionsProvider(llvm::IntrusiveRefCntPtr<vfs::FileSystem> FS) {
     llvm::cl::PrintHelpMessage(/*Hidden=*/false, /*Categorized=*/true);
     return nullptr;
   }
+  GlobalOptions.SkipDeclsOutsideLineFilter = SkipDeclsOutsideLineFilter;
 
   ClangTidyOptions DefaultOptions;
   DefaultOptions.Checks = DefaultChecks;
@@ -87,7 +87,7 @@ def find_compilation_database(path: str) -> str:
 
 
 def get_tidy_invocation(
-    f: Optional[str],
+    files: List[str],
     clang_tidy_binary: str,
     checks: str,
     tmpdir: Optional[str],
@@ -151,8 +151,7 @@ def get_tidy_invocation(
     if store_check_profile:
         start.append("--enable-check-profile")
         start.append(f"--store-check-profile={store_check_profile}")
-    if f:
-        start.append(f)
+    start.extend(files)
     return start
 
 
@@ -348,7 +347,7 @@ async def run_with_semaphore(
 
 @dataclass
 class ClangTidyResult:
-    filename: str
+    filenames: List[str]
     invocation: List[str]
     returncode: int
     stdout: str
@@ -358,17 +357,17 @@ class ClangTidyResult:
 
 async def run_tidy(
     args: argparse.Namespace,
-    name: str,
+    names: List[str],
     clang_tidy_binary: str,
     tmpdir: str,
     build_path: str,
     store_check_profile: Optional[str],
 ) -> ClangTidyResult:
     """
-    Runs clang-tidy on a single file and returns the result.
+    Runs a single clang-tidy process on the given files and returns the result.
     """
     invocation = get_tidy_invocation(
-        name,
+        names,
         clang_tidy_binary,
         args.checks,
         tmpdir,
@@ -403,7 +402,7 @@ async def run_tidy(
 
     assert process.returncode is not None
     return ClangTidyResult(
-        name,
+        names,
         invocation,
         process.returncode,
         stdout.decode("UTF-8"),
@@ -510,6 +509,16 @@ async def main() -> None:
         default=0,
         help="Number of tidy instances to be run in parallel.",
     )
+    parser.add_argument(
+        "-files-per-process",
+        type=int,
+        default=1,
+        help="Number of files to be processed by each clang-tidy instance. "
+        "Files in the same directory are grouped together. Larger batches "
+        "save process startup and reuse cached header contents, and a "
+        "diagnostic in a header shared by files of a batch is reported "
+        "only once.",
+    )
     parser.add_argument(
         "files",
         nargs="*",
@@ -629,7 +638,7 @@ async def main() -> None:
 
     try:
         invocation = get_tidy_invocation(
-            None,
+            [],
             clang_tidy_binary,
             args.checks,
             None,
@@ -692,6 +701,15 @@ async def main() -> None:
             f"out of {number_files_in_database} in compilation database ..."
         )
 
+    # Sorting keeps files of the same directory, which tend to include the same
+    # headers, in the same batch.
+    files_per_process = max(args.files_per_process, 1)
+    sorted_files = sorted(files)
+    batches = [
+        sorted_files[i : i + files_per_process]
+        for i in range(0, len(sorted_files), files_per_process)
+    ]
+
     returncode = 0
     semaphore = asyncio.Semaphore(max_task)
     tasks = [
@@ -700,14 +718,14 @@ async def main() -> None:
                 semaphore,
                 run_tidy,
                 args,
-                f,
+                batch,
                 clang_tidy_binary,
                 export_fixes_dir,
                 build_path,
                 profile_dir,
             )
         )
-        for f in files
+        for batch in batches
     ]
 
     try:
@@ -716,8 +734,8 @@ async def main() -> None:
             if result.returncode != 0:
                 returncode = 1
                 if result.returncode < 0:
-                    result.stderr += f"{result.filename}: terminated by signal {-result.returncode}\n"
-            progress = f"[{i + 1: >{len(f'{len(files)}')}}/{len(files)}]"
+                    result.stderr += f"{' '.join(result.filenames)}: terminated by signal {-result.returncode}\n"
+            progress = f"[{i + 1: >{len(f'{len(batches)}')}}/{len(batches)}]"
             runtime = f"[{result.elapsed:.1f}s]"
             if not args.hide_progress:
                 print(f"{progress}{runtime} {' '.join(result.invocation)}")
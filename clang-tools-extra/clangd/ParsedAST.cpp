@@ -752,11 +752,9 @@ ParsedAST::build(llvm::StringRef Filename, const ParseInputs &Inputs,
   // Add diagnostics from the preamble, if any.
   if (Preamble)
     llvm::append_range(Diags, Patch->patchedDiags());
-  // Finally, add diagnostics coming from the AST.
-  {
-    std::vector<Diag> D = ASTDiags.take(&*CTContext);
-    Diags.insert(Diags.end(), D.begin(), D.end());
-  }
+  // Finally, add diagnostics coming from the AST. There can be many of these
+  // and each one owns its message, notes and fixes, so move them over.
+  llvm::move(ASTDiags.take(&*CTContext), std::back_inserter(Diags));
   ParsedAST Result(Filename, Inputs.Version, std::move(Preamble),
                    std::move(Clang), std::move(Action), std::move(Tokens),
                    std::move(Macros), std::move(Marks), std::move(ParsedDecls),
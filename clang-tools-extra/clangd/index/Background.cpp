@@ -366,7 +366,7 @@ BackgroundIndex::loadProject(std::vector<std::string> MainFiles) {
     });
   Rebuilder.startLoading();
   // Load shards for all of the mainfiles.
-  const std::vector<LoadedShard> Result =
+  std::vector<LoadedShard> Result =
       loadIndexShards(MainFiles, IndexStorageFactory, CDB);
   size_t LoadedShards = 0;
   {
@@ -394,6 +394,10 @@ BackgroundIndex::loadProject(std::vector<std::string> MainFiles) {
       IndexedSymbols.update(URI::create(LS.AbsolutePath).toString(),
                             std::move(SS), std::move(RS), std::move(RelS),
                             LS.CountReferences);
+      // The rest of the shard (its include graph and compile command) is not
+      // needed anymore. Free it now rather than keeping every loaded shard
+      // alive until the whole project is loaded.
+      LS.Shard.reset();
     }
   }
   Rebuilder.loadedShard(LoadedShards);
@@ -361,6 +361,9 @@ class ASTContext : public RefCountedBase<ASTContext> {
   /// Mapping from APValues to the corresponding TemplateParamObjects.
   mutable llvm::FoldingSet<TemplateParamObjectDecl> TemplateParamObjectDecls;
 
+  /// Results of constexpr function calls, keyed by the profile of the call.
+  llvm::DenseMap<llvm::FoldingSetNodeID, APValue *> ConstexprCallResults;
+
   /// A cache mapping a string value to a StringLiteral object with the same
   /// value.
   ///
@@ -3540,10 +3543,24 @@ public:
   /// SYCL kernel name. Returns a null pointer otherwise.
   const SYCLKernelInfo *findSYCLKernelInfo(QualType T) const;
 
+  /// Returns the result of an earlier constexpr function call with the given
+  /// profile, or null if there is none. The profile identifies the callee, the
+  /// evaluation mode and the argument values.
+  const APValue *getCachedConstexprCallResult(const llvm::FoldingSetNodeID &ID);
+
+  /// Remembers the result of a constexpr function call with the given profile,
+  /// unless -fconstexpr-cache-limit results have been cached already.
+  void cacheConstexprCallResult(const llvm::FoldingSetNodeID &ID,
+                                const APValue &Result);
+
   //===--------------------------------------------------------------------===//
   //                    Statistics
   //===--------------------------------------------------------------------===//
 
+  /// The number of constexpr function calls whose result was found in, or
+  /// was looked up but missing from, the constexpr call cache.
+  unsigned NumConstexprCallCacheHits = 0, NumConstexprCallCacheMisses = 0;
+
   /// The number of implicitly-declared default constructors.
   unsigned NumImplicitDefaultConstructors = 0;
 
@@ -44,6 +44,7 @@
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/Timer.h"
+#include <functional>
 #include <optional>
 
 namespace clang {
@@ -144,6 +145,11 @@ public:
 
     /// Avoids matching declarations in system headers.
     bool IgnoreSystemHeaders{false};
+
+    /// If set, namespace-scope declarations for which this returns false are
+    /// neither matched nor traversed. Namespaces and linkage specifications
+    /// are always traversed, so this sees the declarations they contain.
+    std::function<bool(const Decl &)> TopLevelDeclFilter;
   };
 
   MatchFinder(MatchFinderOptions Options = MatchFinderOptions());
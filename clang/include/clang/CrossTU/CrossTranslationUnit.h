@@ -214,7 +214,7 @@ private:
                                                      StringRef IndexName,
                                                      bool DisplayCTUProgress);
   template <typename T>
-  const T *findDefInDeclContext(const DeclContext *DC,
+  const T *findDefInDeclContext(const TranslationUnitDecl *TU,
                                 StringRef LookupName);
   template <typename T>
   llvm::Expected<const T *> importDefinitionImpl(const T *D, ASTUnit *Unit);
@@ -224,6 +224,10 @@ private:
 
   ImporterMapTy ASTUnitImporterMap;
 
+  /// The function and variable definitions of each loaded unit by USR.
+  llvm::DenseMap<const TranslationUnitDecl *, llvm::StringMap<const Decl *>>
+      DefinitionIndex;
+
   ASTContext &Context;
   std::shared_ptr<ASTImporterSharedState> ImporterSharedSt;
 
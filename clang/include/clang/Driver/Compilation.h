@@ -126,6 +126,22 @@ class Compilation {
   /// Whether to keep temporary files regardless of -save-temps.
   bool ForceKeepTempFiles = false;
 
+  /// Print \p C if the command line asks for it (-v, CC_PRINT_OPTIONS).
+  /// \return False if the log file could not be opened.
+  bool LogCommand(const Command &C) const;
+
+  /// Report the outcome of having executed \p C.
+  /// \return The result code of the subprocess.
+  int FinishCommand(const Command &C, int Res, StringRef Error,
+                    bool ExecutionFailed, const Command *&FailingCommand) const;
+
+  /// Execute \p Jobs on up to \p NumThreads threads, starting each job once
+  /// the jobs producing its inputs have finished.
+  void ExecuteJobsInParallel(
+      const JobList &Jobs,
+      SmallVectorImpl<std::pair<int, const Command *>> &FailingCommands,
+      unsigned NumThreads) const;
+
 public:
   Compilation(const Driver &D, const ToolChain &DefaultToolChain,
               llvm::opt::InputArgList *Args,
@@ -13952,7 +13952,13 @@ public:
   public:
     LocalEagerInstantiationScope(Sema &S, bool AtEndOfTU)
         : S(S), AtEndOfTU(AtEndOfTU) {
-      SavedPendingLocalImplicitInstantiations.swap(
+      // Only set aside the enclosing scope's instantiations if there are any;
+      // constructing the saved queue allocates with some standard libraries,
+      // and this scope is entered for every function being instantiated.
+      if (S.PendingLocalImplicitInstantiations.empty())
+        return;
+      SavedPendingLocalImplicitInstantiations.emplace();
+      SavedPendingLocalImplicitInstantiations->swap(
           S.PendingLocalImplicitInstantiations);
     }
 
@@ -13964,14 +13970,15 @@ public:
     ~LocalEagerInstantiationScope() {
       assert(S.PendingLocalImplicitInstantiations.empty() &&
              "there shouldn't be any pending local implicit instantiations");
-      SavedPendingLocalImplicitInstantiations.swap(
-          S.PendingLocalImplicitInstantiations);
+      if (SavedPendingLocalImplicitInstantiations)
+        SavedPendingLocalImplicitInstantiations->swap(
+            S.PendingLocalImplicitInstantiations);
     }
 
   private:
     Sema &S;
     bool AtEndOfTU;
-    std::deque<PendingImplicitInstantiation>
+    std::optional<std::deque<PendingImplicitInstantiation>>
         SavedPendingLocalImplicitInstantiations;
   };
 
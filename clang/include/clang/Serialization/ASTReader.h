@@ -1216,6 +1216,14 @@ private:
   unsigned NumTULocalVisibleDeclContexts = 0,
            TotalTULocalVisibleDeclContexts = 0;
 
+  /// Number of times all specializations of a template were loaded at once,
+  /// and number of lookups for the specializations matching a specific list of
+  /// template arguments.
+  unsigned NumSpecializationFullLoads = 0, NumSpecializationLookups = 0;
+
+  /// Number of specializations deserialized through the lookup tables.
+  unsigned NumSpecializationsRead = 0;
+
   /// Total size of modules, in bits, currently loaded
   uint64_t TotalModulesSizeInBits = 0;
 
@@ -13,13 +13,19 @@
 #include "clang/Lex/DependencyDirectivesScanner.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringMap.h"
+#include "llvm/CAS/ActionCache.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/VirtualFileSystem.h"
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <variant>
 
+namespace llvm::cas {
+class ObjectStore;
+} // namespace llvm::cas
+
 namespace clang {
 namespace tooling {
 namespace dependencies {
@@ -250,9 +256,43 @@ public:
   std::vector<OutOfDateEntry>
   getOutOfDateEntries(llvm::vfs::FileSystem &UnderlyingFS) const;
 
+  /// Persist scanned directive tokens in \p CAS, indexed in \p Cache by the
+  /// hash of the file contents, so that later scanning processes can reuse
+  /// them for files that have not changed.
+  void setDirectivesCache(std::shared_ptr<llvm::cas::ObjectStore> CAS,
+                          std::shared_ptr<llvm::cas::ActionCache> Cache) {
+    DirectivesCAS = std::move(CAS);
+    DirectivesActionCache = std::move(Cache);
+  }
+
+  /// Returns the key under which the directives of \p Contents are persisted,
+  /// or \c std::nullopt if no directives cache has been set.
+  std::optional<llvm::cas::CacheKey>
+  getDirectivesCacheKey(StringRef Contents) const;
+
+  /// Loads previously persisted directives of the file whose contents produced
+  /// \p Key. Offsets in the result refer to those contents of \p Size bytes.
+  ///
+  /// \returns true on success, false if nothing usable was cached.
+  bool
+  loadDirectives(const llvm::cas::CacheKey &Key, size_t Size,
+                 SmallVectorImpl<dependency_directives_scan::Token> &Tokens,
+                 SmallVectorImpl<dependency_directives_scan::Directive>
+                     &Directives) const;
+
+  /// Persists the directives scanned from the file contents that produced
+  /// \p Key. Failures are ignored, the directives are only a cache.
+  void
+  storeDirectives(const llvm::cas::CacheKey &Key,
+                  ArrayRef<dependency_directives_scan::Token> Tokens,
+                  ArrayRef<dependency_directives_scan::Directive> Directives);
+
 private:
   std::unique_ptr<CacheShard[]> CacheShards;
   unsigned NumShards;
+
+  std::shared_ptr<llvm::cas::ObjectStore> DirectivesCAS;
+  std::shared_ptr<llvm::cas::ActionCache> DirectivesActionCache;
 };
 
 /// This class is a local cache, that caches the 'stat' and 'open' calls to the
@@ -11,6 +11,7 @@
 
 #include "clang/Serialization/ModuleCache.h"
 #include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
 
 #include <mutex>
 #include <shared_mutex>
@@ -26,6 +27,9 @@ struct ModuleCacheEntry {
 struct ModuleCacheEntries {
   std::mutex Mutex;
   llvm::StringMap<std::unique_ptr<ModuleCacheEntry>> Map;
+  /// Module cache directories that have already been considered for pruning
+  /// by some compilation sharing these entries.
+  llvm::StringSet<> PrunedPaths;
 };
 
 IntrusiveRefCntPtr<ModuleCache>
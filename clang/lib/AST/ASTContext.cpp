@@ -979,6 +979,12 @@ void ASTContext::PrintStats() const {
                << NumImplicitDestructors
                << " implicit destructors created\n";
 
+  if (getLangOpts().ConstexprCacheLimit)
+    llvm::errs() << NumConstexprCallCacheHits << "/"
+                 << NumConstexprCallCacheHits + NumConstexprCallCacheMisses
+                 << " constexpr call results reused, "
+                 << ConstexprCallResults.size() << " cached\n";
+
   if (ExternalSource) {
     llvm::errs() << "\n";
     ExternalSource->PrintStats();
@@ -15013,6 +15019,29 @@ const SYCLKernelInfo *ASTContext::findSYCLKernelInfo(QualType T) const {
   return nullptr;
 }
 
+const APValue *
+ASTContext::getCachedConstexprCallResult(const llvm::FoldingSetNodeID &ID) {
+  auto It = ConstexprCallResults.find(ID);
+  if (It == ConstexprCallResults.end()) {
+    ++NumConstexprCallCacheMisses;
+    return nullptr;
+  }
+  ++NumConstexprCallCacheHits;
+  return It->second;
+}
+
+void ASTContext::cacheConstexprCallResult(const llvm::FoldingSetNodeID &ID,
+                                          const APValue &Result) {
+  if (ConstexprCallResults.size() >= getLangOpts().ConstexprCacheLimit)
+    return;
+  auto [It, Inserted] = ConstexprCallResults.try_emplace(ID, nullptr);
+  if (!Inserted)
+    return;
+  It->second = new (*this) APValue(Result);
+  if (It->second->needsCleanup())
+    addDestruction(It->second);
+}
+
 OMPTraitInfo &ASTContext::getNewOMPTraitInfo() {
   OMPTraitInfoVector.emplace_back(new OMPTraitInfo());
   return *OMPTraitInfoVector.back();
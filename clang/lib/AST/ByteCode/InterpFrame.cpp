@@ -18,6 +18,7 @@
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/DeclCXX.h"
 #include "clang/AST/ExprCXX.h"
+#include <cstring>
 
 using namespace clang;
 using namespace clang::interp;
@@ -38,7 +39,13 @@ InterpFrame::InterpFrame(InterpState &S, const Function *Func,
   if (FrameSize == 0)
     return;
 
-  Locals = std::make_unique<char[]>(FrameSize);
+  if (FrameSize <= InlineLocalsSize) {
+    Locals = InlineLocals;
+    std::memset(Locals, 0, FrameSize);
+  } else {
+    LocalsStorage = std::make_unique<char[]>(FrameSize);
+    Locals = LocalsStorage.get();
+  }
   for (auto &Scope : Func->scopes()) {
     for (auto &Local : Scope.locals()) {
       new (localBlock(Local.Offset)) Block(S.Ctx.getEvalID(), Local.Desc);
@@ -157,12 +157,12 @@ private:
 
   /// Returns a pointer to a local's block.
   Block *localBlock(unsigned Offset) const {
-    return reinterpret_cast<Block *>(Locals.get() + Offset - sizeof(Block));
+    return reinterpret_cast<Block *>(Locals + Offset - sizeof(Block));
   }
 
   /// Returns the inline descriptor of the local.
   InlineDescriptor *localInlineDesc(unsigned Offset) const {
-    return reinterpret_cast<InlineDescriptor *>(Locals.get() + Offset);
+    return reinterpret_cast<InlineDescriptor *>(Locals + Offset);
   }
 
 private:
@@ -180,8 +180,14 @@ private:
   const unsigned ArgSize;
   /// Pointer to the arguments in the callee's frame.
   char *Args = nullptr;
-  /// Fixed, initial storage for known local variables.
-  std::unique_ptr<char[]> Locals;
+  /// Fixed, initial storage for known local variables. Points into
+  /// InlineLocals if they fit, or to LocalsStorage otherwise.
+  char *Locals = nullptr;
+  std::unique_ptr<char[]> LocalsStorage;
+  /// Most frames only have a few locals; keep those in the frame itself
+  /// instead of making a second allocation for every call.
+  static constexpr unsigned InlineLocalsSize = 256;
+  alignas(std::max_align_t) char InlineLocals[InlineLocalsSize];
   /// Offset on the stack at entry.
   const size_t FrameOffset;
   /// Mapping from arg offsets to their argument blocks.
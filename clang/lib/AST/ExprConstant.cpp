@@ -844,6 +844,10 @@ namespace {
     /// declaration whose initializer is being evaluated, if any.
     APValue *EvaluatingDeclValue;
 
+    /// The number of times the in-flight value of EvaluatingDecl was accessed.
+    /// A call whose result depends on that value cannot be cached.
+    unsigned NumEvaluatingDeclAccesses = 0;
+
     /// Stack of loops and 'switch' statements which we're currently
     /// breaking/continuing; null entries are used to mark unlabeled
     /// break/continue.
@@ -3502,6 +3506,7 @@ static bool evaluateVarDeclInit(EvalInfo &Info, const Expr *E,
   // If we're currently evaluating the initializer of this declaration, use that
   // in-flight value.
   if (Info.EvaluatingDecl == Base) {
+    ++Info.NumEvaluatingDeclAccesses;
     Result = Info.EvaluatingDeclValue;
     return CheckUninitReference(/*IsLocalVariable=*/false);
   }
@@ -4664,6 +4669,7 @@ static CompleteObject findCompleteObject(EvalInfo &Info, const Expr *E,
       lifetimeStartedInEvaluation(Info, LVal.Base)) {
     // This is the object whose initializer we're evaluating, so its lifetime
     // started in the current evaluation.
+    ++Info.NumEvaluatingDeclAccesses;
     BaseVal = Info.EvaluatingDeclValue;
   } else if (const ValueDecl *D = LVal.Base.dyn_cast<const ValueDecl *>()) {
     // Allow reading from a GUID declaration.
@@ -7063,6 +7069,47 @@ static bool handleTrivialCopy(EvalInfo &Info, const ParmVarDecl *Param,
       CopyObjectRepresentation);
 }
 
+/// Compute the profile under which the result of the given call can be
+/// cached, if it can be. We only cache calls to non-member functions taking
+/// and returning scalars, since their result depends only on their arguments
+/// (and on global constants, which cannot change).
+static bool profileCacheableCall(EvalInfo &Info, const FunctionDecl *Callee,
+                                 const LValue *ObjectArg, CallRef Call,
+                                 llvm::FoldingSetNodeID &ID) {
+  if (!Info.getLangOpts().ConstexprCacheLimit || ObjectArg ||
+      Callee->isVariadic() || Info.checkingPotentialConstantExpression() ||
+      Info.checkingForUndefinedBehavior() || Info.SpeculativeEvaluationDepth)
+    return false;
+  // Notes are only collected while the diagnostic list is empty; after that,
+  // CCEDiags are dropped without a trace, so we could not tell whether the
+  // call was a constant expression.
+  if (!Info.EvalStatus.Diag || !Info.EvalStatus.Diag->empty())
+    return false;
+  if (const auto *MD = dyn_cast<CXXMethodDecl>(Callee); MD && !MD->isStatic())
+    return false;
+
+  auto IsScalar = [](QualType T) {
+    return T->isIntegralOrEnumerationType() || T->isRealFloatingType();
+  };
+  if (!IsScalar(Callee->getReturnType()))
+    return false;
+
+  // The result of std::is_constant_evaluated() and of folding depends on how
+  // we are evaluating, so keep calls made in different modes apart.
+  ID.AddPointer(Callee);
+  ID.AddInteger(static_cast<unsigned>(Info.EvalMode));
+  ID.AddBoolean(Info.InConstantContext);
+  for (const ParmVarDecl *PVD : Callee->parameters()) {
+    if (!IsScalar(PVD->getType()))
+      return false;
+    const APValue *Arg = Info.getParamSlot(Call, PVD);
+    if (!Arg || !(Arg->isInt() || Arg->isFloat()))
+      return false;
+    Arg->Profile(ID);
+  }
+  return true;
+}
+
 /// Evaluate a function call.
 static bool HandleFunctionCall(SourceLocation CallLoc,
                                const FunctionDecl *Callee,
@@ -7073,6 +7120,29 @@ static bool HandleFunctionCall(SourceLocation CallLoc,
   if (!Info.CheckCallLimit(CallLoc))
     return false;
 
+  // Reuse the result of an identical earlier call if we have one.
+  llvm::FoldingSetNodeID CacheID;
+  bool Cacheable =
+      profileCacheableCall(Info, Callee, ObjectArg, Call, CacheID);
+  if (Cacheable) {
+    if (const APValue *Cached =
+            Info.Ctx.getCachedConstexprCallResult(CacheID)) {
+      Result = *Cached;
+      return true;
+    }
+  }
+
+  // Anything the call does besides producing its result (allocating, noting
+  // side effects or undefined behavior, emitting notes, or looking at the
+  // variable being initialized) means it must be evaluated again next time.
+  auto GetObservableState = [&Info] {
+    return std::make_tuple(
+        Info.NumHeapAllocs, Info.NumEvaluatingDeclAccesses,
+        Info.EvalStatus.HasSideEffects, Info.EvalStatus.HasUndefinedBehavior,
+        Info.EvalStatus.Diag ? Info.EvalStatus.Diag->size() : 0);
+  };
+  auto StateBeforeCall = GetObservableState();
+
   CallStackFrame Frame(Info, E->getSourceRange(), Callee, ObjectArg, E, Call);
 
   // For a trivial copy or move assignment, perform an APValue copy. This is
@@ -7120,6 +7190,9 @@ static bool HandleFunctionCall(SourceLocation CallLoc,
       return true;
     Info.FFDiag(Callee->getEndLoc(), diag::note_constexpr_no_return);
   }
+  if (ESR == ESR_Returned && Cacheable &&
+      GetObservableState() == StateBeforeCall)
+    Info.Ctx.cacheConstexprCallResult(CacheID, Result);
   return ESR == ESR_Returned;
 }
 
@@ -72,10 +72,38 @@ struct MatchKey {
   TraversalKind Traversal = TK_AsIs;
   MatchType Type;
 
+  auto asTuple() const {
+    return std::tie(Traversal, Type, MatcherID, Node, BoundNodes);
+  }
+
   bool operator<(const MatchKey &Other) const {
-    return std::tie(Traversal, Type, MatcherID, Node, BoundNodes) <
-           std::tie(Other.Traversal, Other.Type, Other.MatcherID, Other.Node,
-                    Other.BoundNodes);
+    return asTuple() < Other.asTuple();
+  }
+};
+
+// A MatchKey that refers to the bound nodes instead of holding a copy of
+// them. Looking up the cache with it avoids copying the bound nodes, which
+// allocates, on every memoized query; a MatchKey is only built on insertion.
+struct MatchKeyRef {
+  DynTypedMatcher::MatcherIDType MatcherID;
+  DynTypedNode Node;
+  const BoundNodesTreeBuilder &BoundNodes;
+  TraversalKind Traversal;
+  MatchType Type;
+
+  auto asTuple() const {
+    return std::tie(Traversal, Type, MatcherID, Node, BoundNodes);
+  }
+
+  MatchKey toKey() const {
+    return MatchKey{MatcherID, Node, BoundNodes, Traversal, Type};
+  }
+
+  friend bool operator<(const MatchKeyRef &LHS, const MatchKey &RHS) {
+    return LHS.asTuple() < RHS.asTuple();
+  }
+  friend bool operator<(const MatchKey &LHS, const MatchKeyRef &RHS) {
+    return LHS.asTuple() < RHS.asTuple();
   }
 };
 
@@ -602,14 +630,13 @@ public:
     if (!Node.getMemoizationData() || !Builder->isComparable())
       return matchesRecursively(Node, Matcher, Builder, MaxDepth, Bind);
 
-    MatchKey Key;
-    Key.MatcherID = Matcher.getID();
-    Key.Node = Node;
-    // Note that we key on the bindings *before* the match.
-    Key.BoundNodes = *Builder;
-    Key.Traversal = Ctx.getParentMapContext().getTraversalKind();
-    // Memoize result even doing a single-level match, it might be expensive.
-    Key.Type = MaxDepth == 1 ? MatchType::Child : MatchType::Descendants;
+    // Note that we key on the bindings *before* the match. *Builder is left
+    // untouched until the result is known, so it can be referenced.
+    MatchKeyRef Key{Matcher.getID(), Node, *Builder,
+                    Ctx.getParentMapContext().getTraversalKind(),
+                    // Memoize result even doing a single-level match, it might
+                    // be expensive.
+                    MaxDepth == 1 ? MatchType::Child : MatchType::Descendants};
     MemoizationMap::iterator I = ResultCache.find(Key);
     if (I != ResultCache.end()) {
       *Builder = I->second.Nodes;
@@ -621,7 +648,7 @@ public:
     Result.ResultOfMatch =
         matchesRecursively(Node, Matcher, &Result.Nodes, MaxDepth, Bind);
 
-    MemoizedMatchResult &CachedResult = ResultCache[Key];
+    MemoizedMatchResult &CachedResult = ResultCache[Key.toKey()];
     CachedResult = std::move(Result);
 
     *Builder = CachedResult.Nodes;
@@ -1371,6 +1398,24 @@ private:
     return false;
   }
 
+  bool shouldSkipNode(Decl &Node) {
+    if (Options.IgnoreSystemHeaders && isInSystemHeader(getNodeLocation(Node)))
+      return true;
+    if (Options.TopLevelDeclFilter && isFilteredTopLevelDecl(Node) &&
+        !Options.TopLevelDeclFilter(Node))
+      return true;
+    return false;
+  }
+
+  // Returns whether \p Node is subject to
+  // MatchFinderOptions::TopLevelDeclFilter.
+  static bool isFilteredTopLevelDecl(const Decl &Node) {
+    if (isa<TranslationUnitDecl, NamespaceDecl, LinkageSpecDecl, ExportDecl>(
+            Node))
+      return false;
+    return Node.getDeclContext()->getRedeclContext()->isFileContext();
+  }
+
   template <typename T> bool shouldSkipNode(T *Node) {
     return (Node == nullptr) || shouldSkipNode(*Node);
   }
@@ -1406,7 +1451,7 @@ private:
       CompatibleAliases;
 
   // Maps (matcher, node) -> the match result for memoization.
-  typedef std::map<MatchKey, MemoizedMatchResult> MemoizationMap;
+  typedef std::map<MatchKey, MemoizedMatchResult, std::less<>> MemoizationMap;
   MemoizationMap ResultCache;
 };
 
@@ -260,29 +260,45 @@ CrossTranslationUnitContext::getLookupName(const Decl *D) {
   return std::string(DeclUSR);
 }
 
-/// Recursively visits the decls of a DeclContext, and returns one with the
-/// given USR.
-template <typename T>
-const T *
-CrossTranslationUnitContext::findDefInDeclContext(const DeclContext *DC,
-                                                  StringRef LookupName) {
+/// Recursively visits the decls of a DeclContext, and records every function
+/// and variable definition by its USR. The first definition of a USR wins.
+static void indexDefinitions(const DeclContext *DC,
+                             llvm::StringMap<const Decl *> &Index) {
   assert(DC && "Declaration Context must not be null");
   for (const Decl *D : DC->decls()) {
-    const auto *SubDC = dyn_cast<DeclContext>(D);
-    if (SubDC)
-      if (const auto *ND = findDefInDeclContext<T>(SubDC, LookupName))
-        return ND;
-
-    const auto *ND = dyn_cast<T>(D);
-    const T *ResultDecl;
-    if (!ND || !hasBodyOrInit(ND, ResultDecl))
-      continue;
-    std::optional<std::string> ResultLookupName = getLookupName(ResultDecl);
-    if (!ResultLookupName || *ResultLookupName != LookupName)
+    if (const auto *SubDC = dyn_cast<DeclContext>(D))
+      indexDefinitions(SubDC, Index);
+
+    const Decl *ResultDecl = nullptr;
+    if (const auto *FD = dyn_cast<FunctionDecl>(D)) {
+      const FunctionDecl *DefD;
+      if (hasBodyOrInit(FD, DefD))
+        ResultDecl = DefD;
+    } else if (const auto *VD = dyn_cast<VarDecl>(D)) {
+      const VarDecl *DefD;
+      if (hasBodyOrInit(VD, DefD))
+        ResultDecl = DefD;
+    }
+    if (!ResultDecl)
       continue;
-    return ResultDecl;
+    std::optional<std::string> ResultLookupName =
+        CrossTranslationUnitContext::getLookupName(ResultDecl);
+    if (ResultLookupName)
+      Index.try_emplace(*ResultLookupName, ResultDecl);
   }
-  return nullptr;
+}
+
+/// Returns the definition with the given USR in TU. The definitions of TU are
+/// indexed on the first lookup, so that later lookups into the same unit do
+/// not have to walk and generate USRs for all of its decls again.
+template <typename T>
+const T *
+CrossTranslationUnitContext::findDefInDeclContext(const TranslationUnitDecl *TU,
+                                                  StringRef LookupName) {
+  auto [It, Inserted] = DefinitionIndex.try_emplace(TU);
+  if (Inserted)
+    indexDefinitions(TU, It->second);
+  return dyn_cast_or_null<T>(It->second.lookup(LookupName));
 }
 
 template <typename T>
@@ -14,13 +14,19 @@
 #include "clang/Driver/ToolChain.h"
 #include "clang/Driver/Util.h"
 #include "clang/Options/Options.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/Option/ArgList.h"
 #include "llvm/Option/OptSpecifier.h"
 #include "llvm/Option/Option.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/TargetParser/Triple.h"
 #include <cassert>
+#include <condition_variable>
+#include <mutex>
 #include <string>
 #include <system_error>
 #include <utility>
@@ -157,9 +163,7 @@ bool Compilation::CleanupFileMap(const ArgStringMap &Files,
   return Success;
 }
 
-int Compilation::ExecuteCommand(const Command &C,
-                                const Command *&FailingCommand,
-                                bool LogOnly) const {
+bool Compilation::LogCommand(const Command &C) const {
   if ((getDriver().CCPrintOptions ||
        getArgs().hasArg(options::OPT_v)) && !getDriver().CCGenDiagnostics) {
     raw_ostream *OS = &llvm::errs();
@@ -176,8 +180,7 @@ int Compilation::ExecuteCommand(const Command &C,
       if (EC) {
         getDriver().Diag(diag::err_drv_cc_print_options_failure)
             << EC.message();
-        FailingCommand = &C;
-        return 1;
+        return false;
       }
       OS = OwnedStream.get();
     }
@@ -187,13 +190,12 @@ int Compilation::ExecuteCommand(const Command &C,
 
     C.Print(*OS, "\n", /*Quote=*/getDriver().CCPrintOptions);
   }
+  return true;
+}
 
-  if (LogOnly)
-    return 0;
-
-  std::string Error;
-  bool ExecutionFailed;
-  int Res = C.Execute(Redirects, &Error, &ExecutionFailed);
+int Compilation::FinishCommand(const Command &C, int Res, StringRef Error,
+                               bool ExecutionFailed,
+                               const Command *&FailingCommand) const {
   if (PostCallback)
     PostCallback(C, Res);
   if (!Error.empty()) {
@@ -207,6 +209,23 @@ int Compilation::ExecuteCommand(const Command &C,
   return ExecutionFailed ? 1 : Res;
 }
 
+int Compilation::ExecuteCommand(const Command &C,
+                                const Command *&FailingCommand,
+                                bool LogOnly) const {
+  if (!LogCommand(C)) {
+    FailingCommand = &C;
+    return 1;
+  }
+
+  if (LogOnly)
+    return 0;
+
+  std::string Error;
+  bool ExecutionFailed;
+  int Res = C.Execute(Redirects, &Error, &ExecutionFailed);
+  return FinishCommand(C, Res, Error, ExecutionFailed, FailingCommand);
+}
+
 using FailingCommandList = SmallVectorImpl<std::pair<int, const Command *>>;
 
 static bool ActionFailed(const Action *A,
@@ -232,9 +251,119 @@ static bool ActionFailed(const Action *A,
   return false;
 }
 
+void Compilation::ExecuteJobsInParallel(const JobList &Jobs,
+                                        FailingCommandList &FailingCommands,
+                                        unsigned NumThreads) const {
+  const JobList::list_type &Commands = Jobs.getJobs();
+  const size_t NumJobs = Commands.size();
+
+  // A job has to wait for every earlier job built from one of the actions its
+  // own action transitively consumes. Jobs are created in dependency order,
+  // so the first pending job can always be started.
+  llvm::DenseMap<const Action *, SmallVector<size_t, 1>> JobsForAction;
+  for (size_t I = 0; I != NumJobs; ++I)
+    JobsForAction[&Commands[I]->getSource()].push_back(I);
+
+  std::vector<SmallVector<size_t, 4>> Deps(NumJobs);
+  for (size_t I = 0; I != NumJobs; ++I) {
+    SmallVector<const Action *, 8> Worklist = {&Commands[I]->getSource()};
+    llvm::SmallPtrSet<const Action *, 16> Visited;
+    while (!Worklist.empty()) {
+      const Action *A = Worklist.pop_back_val();
+      if (!Visited.insert(A).second)
+        continue;
+      for (size_t J : JobsForAction.lookup(A))
+        if (J < I)
+          Deps[I].push_back(J);
+      llvm::append_range(Worklist, A->inputs());
+    }
+  }
+
+  struct JobResult {
+    int Res = 0;
+    std::string Error;
+    bool ExecutionFailed = false;
+  };
+  enum class JobState { Pending, Running, Done };
+  std::vector<JobResult> Results(NumJobs);
+  std::vector<JobState> States(NumJobs, JobState::Pending);
+  size_t NumDone = 0;
+  unsigned NumRunning = 0;
+
+  // Workers only run the subprocess; logging, diagnostics and the post
+  // callback stay on this thread.
+  std::mutex Lock;
+  std::condition_variable JobFinished;
+  std::vector<size_t> Finished;
+  llvm::DefaultThreadPool Pool(llvm::hardware_concurrency(NumThreads));
+
+  while (NumDone != NumJobs) {
+    for (size_t I = 0; I != NumJobs && NumRunning < NumThreads; ++I) {
+      if (States[I] != JobState::Pending ||
+          llvm::any_of(Deps[I],
+                       [&](size_t D) { return States[D] != JobState::Done; }))
+        continue;
+      const Command &C = *Commands[I];
+      if (ActionFailed(&C.getSource(), FailingCommands)) {
+        States[I] = JobState::Done;
+        ++NumDone;
+        continue;
+      }
+      if (!LogCommand(C)) {
+        FailingCommands.push_back(std::make_pair(1, &C));
+        States[I] = JobState::Done;
+        ++NumDone;
+        continue;
+      }
+      States[I] = JobState::Running;
+      ++NumRunning;
+      Pool.async([&, I] {
+        JobResult &R = Results[I];
+        R.Res = Commands[I]->Execute(Redirects, &R.Error, &R.ExecutionFailed);
+        std::lock_guard<std::mutex> Guard(Lock);
+        Finished.push_back(I);
+        JobFinished.notify_one();
+      });
+    }
+    if (NumRunning == 0)
+      continue;
+
+    std::vector<size_t> Batch;
+    {
+      std::unique_lock<std::mutex> Guard(Lock);
+      JobFinished.wait(Guard, [&] { return !Finished.empty(); });
+      Batch.swap(Finished);
+    }
+    for (size_t I : Batch) {
+      States[I] = JobState::Done;
+      ++NumDone;
+      --NumRunning;
+      const JobResult &R = Results[I];
+      const Command *FailingCommand = nullptr;
+      if (int Res = FinishCommand(*Commands[I], R.Res, R.Error,
+                                  R.ExecutionFailed, FailingCommand))
+        FailingCommands.push_back(std::make_pair(Res, FailingCommand));
+    }
+  }
+}
+
 void Compilation::ExecuteJobs(const JobList &Jobs,
                               FailingCommandList &FailingCommands,
                               bool LogOnly) const {
+  // Independent jobs may run concurrently when asked to. In-process cc1 jobs
+  // share global state and offloading pipelines abort as a whole, so both
+  // keep the serial order below.
+  unsigned NumThreads = TheDriver.NumParallelJobs;
+  if (!LogOnly && NumThreads > 1 && Jobs.size() > 1 &&
+      !TheDriver.IsCLMode() && llvm::none_of(Jobs, [](const Command &C) {
+        return C.InProcess || C.getSource().isOffloading(Action::OFK_Cuda) ||
+               C.getSource().isOffloading(Action::OFK_HIP) ||
+               C.getSource().isOffloading(Action::OFK_SYCL);
+      })) {
+    ExecuteJobsInParallel(Jobs, FailingCommands, NumThreads);
+    return;
+  }
+
   // According to UNIX standard, driver need to continue compiling all the
   // inputs on the command line even one of them failed.
   // In all but CLMode, execute all the jobs unless the necessary inputs for the
@@ -1698,6 +1698,15 @@ Compilation *Driver::BuildCompilation(ArrayRef<const char *> ArgList) {
       BitcodeEmbed = static_cast<BitcodeEmbedMode>(Model);
   }
 
+  if (const Arg *A = Args.getLastArg(options::OPT_parallel_jobs_EQ)) {
+    StringRef Val = A->getValue();
+    if (Val.getAsInteger(10, NumParallelJobs) || NumParallelJobs == 0) {
+      Diags.Report(diag::err_drv_invalid_int_value)
+          << A->getAsString(Args) << Val;
+      NumParallelJobs = 1;
+    }
+  }
+
   // Remove existing compilation database so that each job can append to it.
   if (Arg *A = Args.getLastArg(options::OPT_MJ))
     llvm::sys::fs::remove(A->getValue());
@@ -486,6 +486,18 @@ OptionalFileEntryRef DirectoryLookup::LookupFile(
 
   SmallString<1024> TmpDir;
   if (isNormalDir()) {
+    // If the file lives in a subdirectory, make sure the first component of its
+    // path exists in this directory. FileManager caches the answer, so with
+    // many search directories each one costs a single stat per distinct
+    // top-level component, instead of one stat per distinct header.
+    StringRef FirstComponent = *llvm::sys::path::begin(Filename);
+    if (FirstComponent.size() != Filename.size()) {
+      TmpDir = getDirRef()->getName();
+      llvm::sys::path::append(TmpDir, FirstComponent);
+      if (!HS.getFileMgr().getOptionalDirectoryRef(TmpDir))
+        return std::nullopt;
+    }
+
     // Concatenate the requested file onto the directory.
     TmpDir = getDirRef()->getName();
     llvm::sys::path::append(TmpDir, Filename);
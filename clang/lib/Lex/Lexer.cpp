@@ -46,6 +46,13 @@
 #include <string>
 #include <tuple>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif __ALTIVEC__
+#include <altivec.h>
+#undef bool
+#endif
+
 #ifdef __SSE4_2__
 #include <nmmintrin.h>
 #endif
@@ -2609,6 +2616,27 @@ bool Lexer::SkipLineComment(Token &Result, const char *CurPtr,
 
   char C;
   while (true) {
+#ifdef __SSE2__
+    // Skip over 16 characters at a time while none of them is a newline, a
+    // null (potentially EOF) or part of a multi-byte UTF-8 sequence.
+    const char *FastStart = CurPtr;
+    while (BufferEnd - CurPtr >= 16) {
+      __m128i Cv = _mm_loadu_si128((const __m128i *)CurPtr);
+      int Mask =
+          _mm_movemask_epi8(Cv) |
+          _mm_movemask_epi8(_mm_cmpeq_epi8(Cv, _mm_setzero_si128())) |
+          _mm_movemask_epi8(_mm_cmpeq_epi8(Cv, _mm_set1_epi8('\n'))) |
+          _mm_movemask_epi8(_mm_cmpeq_epi8(Cv, _mm_set1_epi8('\r')));
+      if (Mask != 0) {
+        CurPtr += llvm::countr_zero<unsigned>(Mask);
+        break;
+      }
+      CurPtr += 16;
+    }
+    if (CurPtr != FastStart)
+      UnicodeDecodingAlreadyDiagnosed = false;
+#endif
+
     C = *CurPtr;
     // Skip over characters in the fast loop.
     while (isASCII(C) && C != 0 &&   // Potentially EOF.
@@ -2847,13 +2875,6 @@ static bool isEndOfBlockCommentWithEscapedNewLine(const char *CurPtr, Lexer *L,
   return true;
 }
 
-#ifdef __SSE2__
-#include <emmintrin.h>
-#elif __ALTIVEC__
-#include <altivec.h>
-#undef bool
-#endif
-
 /// We have just read from input the / and * characters that started a comment.
 /// Read until we find the * and / characters that terminate the comment.
 /// Note that we don't bother decoding trigraphs or escaped newlines in block
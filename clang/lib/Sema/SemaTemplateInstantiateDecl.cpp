@@ -7165,7 +7165,9 @@ NamedDecl *Sema::FindInstantiatedDecl(SourceLocation Loc, NamedDecl *D,
 }
 
 void Sema::PerformPendingInstantiations(bool LocalOnly, bool AtEndOfTU) {
-  std::deque<PendingImplicitInstantiation> DelayedImplicitInstantiations;
+  // This runs after every function instantiation, and we rarely delay any of
+  // them, so use a container that doesn't allocate until it is needed.
+  SmallVector<PendingImplicitInstantiation, 0> DelayedImplicitInstantiations;
   while (!PendingLocalImplicitInstantiations.empty() ||
          (!LocalOnly && !PendingInstantiations.empty())) {
     PendingImplicitInstantiation Inst;
@@ -7252,8 +7254,13 @@ void Sema::PerformPendingInstantiations(bool LocalOnly, bool AtEndOfTU) {
                                   DefinitionRequired, AtEndOfTU);
   }
 
-  if (!DelayedImplicitInstantiations.empty())
-    PendingInstantiations.swap(DelayedImplicitInstantiations);
+  if (!DelayedImplicitInstantiations.empty()) {
+    // We only delay non-local instantiations, after draining the whole queue.
+    assert(PendingInstantiations.empty() &&
+           "delayed instantiations with instantiations still pending");
+    PendingInstantiations.assign(DelayedImplicitInstantiations.begin(),
+                                 DelayedImplicitInstantiations.end());
+  }
 }
 
 void Sema::PerformDependentDiagnostics(const DeclContext *Pattern,
@@ -8494,6 +8494,7 @@ bool ASTReader::LoadExternalSpecializationsImpl(SpecLookupTableTy &SpecLookups,
   // Since we've loaded all the specializations, we can erase it from
   // the lookup table.
   SpecLookups.erase(It);
+  ++NumSpecializationFullLoads;
 
   bool NewSpecsFound = false;
   Deserializing LookupResults(this);
@@ -8501,6 +8502,7 @@ bool ASTReader::LoadExternalSpecializationsImpl(SpecLookupTableTy &SpecLookups,
     if (GetExistingDecl(Info))
       continue;
     NewSpecsFound = true;
+    ++NumSpecializationsRead;
     GetDecl(Info);
   }
 
@@ -8544,12 +8546,14 @@ bool ASTReader::LoadExternalSpecializationsImpl(
   // Get Decl may violate the iterator from SpecLookups
   llvm::SmallVector<serialization::reader::LazySpecializationInfo, 8> Infos =
       It->second.Table.find(HashValue);
+  ++NumSpecializationLookups;
 
   bool NewSpecsFound = false;
   for (auto &Info : Infos) {
     if (GetExistingDecl(Info))
       continue;
     NewSpecsFound = true;
+    ++NumSpecializationsRead;
     GetDecl(Info);
   }
 
@@ -8912,6 +8916,16 @@ void ASTReader::PrintStats() {
                  NumTULocalVisibleDeclContexts, TotalTULocalVisibleDeclContexts,
                  ((float)NumTULocalVisibleDeclContexts /
                   TotalTULocalVisibleDeclContexts * 100));
+  if (NumSpecializationFullLoads)
+    std::fprintf(stderr, "  %u specialization tables loaded completely\n",
+                 NumSpecializationFullLoads);
+  if (NumSpecializationLookups)
+    std::fprintf(stderr,
+                 "  %u specialization lookups by template arguments\n",
+                 NumSpecializationLookups);
+  if (NumSpecializationsRead)
+    std::fprintf(stderr, "  %u specializations read\n",
+                 NumSpecializationsRead);
   if (TotalNumMethodPoolEntries)
     std::fprintf(stderr, "  %u/%u method pool entries read (%f%%)\n",
                  NumMethodPoolEntriesRead, TotalNumMethodPoolEntries,
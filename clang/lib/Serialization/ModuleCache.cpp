@@ -57,8 +57,15 @@ void clang::maybePruneImpl(StringRef Path, time_t PruneInterval,
   std::error_code EC;
   for (llvm::sys::fs::directory_iterator Dir(Path, EC), DirEnd;
        Dir != DirEnd && !EC; Dir.increment(EC)) {
-    // If we don't have a directory, there's nothing to look into.
-    if (!llvm::sys::fs::is_directory(Dir->path()))
+    // If we don't have a directory, there's nothing to look into. Use the type
+    // reported by the directory iterator to avoid a stat() of every entry in
+    // the cache root. Only stat() symlinks, to see what they point to, and
+    // entries whose type the file system did not report.
+    llvm::sys::fs::file_type DirType = Dir->type();
+    bool NeedsStat = DirType == llvm::sys::fs::file_type::symlink_file ||
+                     DirType == llvm::sys::fs::file_type::type_unknown;
+    if (NeedsStat ? !llvm::sys::fs::is_directory(Dir->path())
+                  : DirType != llvm::sys::fs::file_type::directory_file)
       continue;
 
     // Walk all the files within this directory.
@@ -129,9 +129,11 @@ bool CoreEngine::ExecuteWorkList(const LocationContext *L, unsigned MaxSteps,
   // Check if we have a steps limit
   bool UnlimitedSteps = MaxSteps == 0;
 
-  // Cap our pre-reservation in the event that the user specifies
-  // a very large number of maximum steps.
-  const unsigned PreReservationCap = 4000000;
+  // Cap our pre-reservation. Most entry points only produce a small graph, and
+  // reserving room for the full step budget (225000 nodes by default) cost a
+  // megabyte-sized zeroed bucket array for every analyzed function. Graphs
+  // that do get big simply grow the node set geometrically.
+  const unsigned PreReservationCap = 4096;
   if(!UnlimitedSteps)
     G.reserve(std::min(MaxSteps, PreReservationCap));
 
@@ -7,6 +7,14 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
+#include "clang/Basic/TokenKinds.h"
+#include "clang/Basic/Version.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/CAS/BuiltinCASContext.h"
+#include "llvm/CAS/BuiltinObjectHasher.h"
+#include "llvm/CAS/ObjectStore.h"
+#include "llvm/Support/BinaryStreamReader.h"
+#include "llvm/Support/EndianStream.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Threading.h"
 #include <optional>
@@ -61,15 +69,25 @@ bool DependencyScanningWorkerFilesystem::ensureDirectiveTokensArePopulated(
     return true;
 
   SmallVector<dependency_directives_scan::Directive, 64> Directives;
-  // Scan the file for preprocessor directives that might affect the
-  // dependencies.
-  if (scanSourceForDependencyDirectives(Contents->Original->getBuffer(),
-                                        Contents->DepDirectiveTokens,
-                                        Directives)) {
-    Contents->DepDirectiveTokens.clear();
-    // FIXME: Propagate the diagnostic if desired by the client.
-    Contents->DepDirectives.store(new std::optional<DependencyDirectivesTy>());
-    return false;
+  StringRef Source = Contents->Original->getBuffer();
+  std::optional<llvm::cas::CacheKey> Key =
+      SharedCache.getDirectivesCacheKey(Source);
+  if (!Key || !SharedCache.loadDirectives(*Key, Source.size(),
+                                          Contents->DepDirectiveTokens,
+                                          Directives)) {
+    // Scan the file for preprocessor directives that might affect the
+    // dependencies.
+    if (scanSourceForDependencyDirectives(Source, Contents->DepDirectiveTokens,
+                                          Directives)) {
+      Contents->DepDirectiveTokens.clear();
+      // FIXME: Propagate the diagnostic if desired by the client.
+      Contents->DepDirectives.store(
+          new std::optional<DependencyDirectivesTy>());
+      return false;
+    }
+    if (Key)
+      SharedCache.storeDirectives(*Key, Contents->DepDirectiveTokens,
+                                  Directives);
   }
 
   // This function performed double-checked locking using `DepDirectives`.
@@ -93,6 +111,132 @@ DependencyScanningFilesystemSharedCache::
   CacheShards = std::make_unique<CacheShard[]>(NumShards);
 }
 
+/// Identifies the layout of persisted directives; bump it whenever the
+/// encoding below changes. Keys are also salted with the full clang version, so
+/// a cache shared between builds never hands out directives from another
+/// scanner.
+static constexpr llvm::StringLiteral DirectivesCacheVersion =
+    "clang-dependency-directives-v1";
+
+std::optional<llvm::cas::CacheKey>
+DependencyScanningFilesystemSharedCache::getDirectivesCacheKey(
+    StringRef Contents) const {
+  if (!DirectivesCAS)
+    return std::nullopt;
+  using Hasher = llvm::cas::BuiltinObjectHasher<llvm::cas::builtin::HasherT>;
+  auto ContentsHash =
+      Hasher::hashObject({}, ArrayRef(Contents.data(), Contents.size()));
+  std::string Salt =
+      (DirectivesCacheVersion + ";" + getClangFullRepositoryVersion()).str();
+  auto KeyHash = Hasher::hashObject({ArrayRef<uint8_t>(ContentsHash)},
+                                    ArrayRef(Salt.data(), Salt.size()));
+  return llvm::cas::CacheKey(llvm::cas::CASID::create(
+      &DirectivesCAS->getContext(), llvm::toStringRef(KeyHash)));
+}
+
+// Directives are encoded as the token count, each token's offset, length,
+// kind and flags, then the directive count and each directive's kind, first
+// token index and token count. All integers are little-endian.
+bool DependencyScanningFilesystemSharedCache::loadDirectives(
+    const llvm::cas::CacheKey &Key, size_t Size,
+    SmallVectorImpl<dependency_directives_scan::Token> &Tokens,
+    SmallVectorImpl<dependency_directives_scan::Directive> &Directives) const {
+  Expected<std::optional<llvm::cas::CASID>> Result =
+      DirectivesActionCache->get(Key);
+  if (!Result) {
+    llvm::consumeError(Result.takeError());
+    return false;
+  }
+  if (!*Result)
+    return false;
+  Expected<llvm::cas::ObjectProxy> Object = DirectivesCAS->getProxy(**Result);
+  if (!Object) {
+    llvm::consumeError(Object.takeError());
+    return false;
+  }
+
+  llvm::BinaryStreamReader Reader(Object->getData(),
+                                  llvm::endianness::little);
+  auto Decode = [&]() -> llvm::Error {
+    uint32_t NumTokens;
+    if (llvm::Error E = Reader.readInteger(NumTokens))
+      return E;
+    for (uint32_t I = 0; I != NumTokens; ++I) {
+      uint32_t Offset, Length;
+      uint16_t Kind, Flags;
+      if (llvm::Error E = Reader.readInteger(Offset))
+        return E;
+      if (llvm::Error E = Reader.readInteger(Length))
+        return E;
+      if (llvm::Error E = Reader.readInteger(Kind))
+        return E;
+      if (llvm::Error E = Reader.readInteger(Flags))
+        return E;
+      if (Kind >= tok::NUM_TOKENS || uint64_t(Offset) + Length > Size)
+        return llvm::createStringError("invalid directive token");
+      Tokens.emplace_back(Offset, Length, tok::TokenKind(Kind), Flags);
+    }
+    uint32_t NumDirectives;
+    if (llvm::Error E = Reader.readInteger(NumDirectives))
+      return E;
+    for (uint32_t I = 0; I != NumDirectives; ++I) {
+      uint8_t Kind;
+      uint32_t First, Count;
+      if (llvm::Error E = Reader.readInteger(Kind))
+        return E;
+      if (llvm::Error E = Reader.readInteger(First))
+        return E;
+      if (llvm::Error E = Reader.readInteger(Count))
+        return E;
+      if (Kind > dependency_directives_scan::pp_eof ||
+          uint64_t(First) + Count > Tokens.size())
+        return llvm::createStringError("invalid directive");
+      Directives.emplace_back(
+          dependency_directives_scan::DirectiveKind(Kind),
+          ArrayRef(Tokens).slice(First, Count));
+    }
+    return llvm::Error::success();
+  };
+  if (llvm::Error E = Decode()) {
+    llvm::consumeError(std::move(E));
+    Tokens.clear();
+    Directives.clear();
+    return false;
+  }
+  return true;
+}
+
+void DependencyScanningFilesystemSharedCache::storeDirectives(
+    const llvm::cas::CacheKey &Key,
+    ArrayRef<dependency_directives_scan::Token> Tokens,
+    ArrayRef<dependency_directives_scan::Directive> Directives) {
+  SmallString<256> Data;
+  llvm::raw_svector_ostream OS(Data);
+  llvm::support::endian::Writer W(OS, llvm::endianness::little);
+  W.write<uint32_t>(Tokens.size());
+  for (const dependency_directives_scan::Token &T : Tokens) {
+    W.write<uint32_t>(T.Offset);
+    W.write<uint32_t>(T.Length);
+    W.write<uint16_t>(T.Kind);
+    W.write<uint16_t>(T.Flags);
+  }
+  W.write<uint32_t>(Directives.size());
+  for (const dependency_directives_scan::Directive &D : Directives) {
+    W.write<uint8_t>(D.Kind);
+    W.write<uint32_t>(D.Tokens.empty() ? 0 : D.Tokens.data() - Tokens.data());
+    W.write<uint32_t>(D.Tokens.size());
+  }
+
+  Expected<llvm::cas::ObjectRef> Object =
+      DirectivesCAS->storeFromString({}, Data);
+  if (!Object) {
+    llvm::consumeError(Object.takeError());
+    return;
+  }
+  llvm::consumeError(
+      DirectivesActionCache->put(Key, DirectivesCAS->getID(*Object)));
+}
+
 DependencyScanningFilesystemSharedCache::CacheShard &
 DependencyScanningFilesystemSharedCache::getShardForFilename(
     StringRef Filename) const {
@@ -112,11 +256,22 @@ DependencyScanningFilesystemSharedCache::getOutOfDateEntries(
     llvm::vfs::FileSystem &UnderlyingFS) const {
   // Iterate through all shards and look for cached stat errors.
   std::vector<OutOfDateEntry> InvalidDiagInfo;
+  std::vector<std::pair<StringRef, const CachedFileSystemEntry *>> Entries;
   for (unsigned i = 0; i < NumShards; i++) {
     const CacheShard &Shard = CacheShards[i];
-    std::lock_guard<std::mutex> LockGuard(Shard.CacheLock);
-    for (const auto &[Path, CachedPair] : Shard.CacheByFilename) {
-      const CachedFileSystemEntry *Entry = CachedPair.first;
+    // Only hold the shard lock while taking a snapshot of its entries, so that
+    // workers still using the cache are not blocked behind the status() calls
+    // below. Entries are never removed from a shard, so the file names and
+    // entries stay valid after the lock is released.
+    Entries.clear();
+    {
+      std::lock_guard<std::mutex> LockGuard(Shard.CacheLock);
+      Entries.reserve(Shard.CacheByFilename.size());
+      for (const auto &[Path, CachedPair] : Shard.CacheByFilename)
+        if (CachedPair.first)
+          Entries.emplace_back(Path, CachedPair.first);
+    }
+    for (const auto &[Path, Entry] : Entries) {
       llvm::ErrorOr<llvm::vfs::Status> Status = UnderlyingFS.status(Path);
       if (Status) {
         if (Entry->getError()) {
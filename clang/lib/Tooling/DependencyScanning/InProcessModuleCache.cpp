@@ -102,8 +102,14 @@ public:
 
   void maybePrune(StringRef Path, time_t PruneInterval,
                   time_t PruneAfter) override {
-    // FIXME: This only needs to be ran once per build, not in every
-    // compilation. Call it once per service.
+    // This only needs to run once per build, not in every compilation. The
+    // entries are shared by all compilations of the service, so let the first
+    // one that gets here do the work.
+    {
+      std::lock_guard<std::mutex> Lock(Entries.Mutex);
+      if (!Entries.PrunedPaths.insert(Path).second)
+        return;
+    }
     maybePruneImpl(Path, PruneInterval, PruneAfter);
   }
 
@@ -0,0 +1,5 @@
+// RUN: %clang -### -c -fconstexpr-cache-limit=1000 %s 2>&1 | FileCheck %s
+// RUN: %clang -### -c %s 2>&1 | FileCheck %s --check-prefix=NONE
+
+// CHECK: "-cc1"{{.*}} "-fconstexpr-cache-limit=1000"
+// NONE-NOT: "-fconstexpr-cache-limit
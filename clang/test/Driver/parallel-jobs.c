@@ -0,0 +1,24 @@
+// REQUIRES: x86-registered-target
+
+// RUN: not %clang -### -c -parallel-jobs=0 %s 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=ZERO
+// ZERO: error: invalid integral value '0' in '-parallel-jobs=0'
+
+// RUN: not %clang -### -c -parallel-jobs=two %s 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=INVALID
+// INVALID: error: invalid integral value 'two' in '-parallel-jobs=two'
+
+// RUN: rm -rf %t && mkdir %t
+// RUN: cp %s %t/a.c && cp %s %t/b.c
+// RUN: %clang -### -c -parallel-jobs=2 %t/a.c %t/b.c 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=TWO
+// TWO-NOT: error:
+// TWO: "-cc1" {{.*}}"-o" "a.o" {{.*}}"{{.*}}a.c"
+// TWO: "-cc1" {{.*}}"-o" "b.o" {{.*}}"{{.*}}b.c"
+
+// RUN: cd %t && %clang --target=x86_64-linux-gnu -c -parallel-jobs=2 a.c b.c
+// RUN: ls %t | FileCheck %s --check-prefix=OBJS
+// OBJS: a.o
+// OBJS: b.o
+
+int f(void) { return 0; }
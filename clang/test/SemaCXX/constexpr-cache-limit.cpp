@@ -0,0 +1,22 @@
+// RUN: %clang_cc1 -std=c++20 -fsyntax-only -verify %s -fconstexpr-cache-limit=1000 -fconstexpr-steps=10000
+
+// Without reusing earlier results this takes exponentially many steps.
+constexpr unsigned long long fib(unsigned n) {
+  return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+static_assert(fib(60) == 1548008755920ULL);
+
+// Failed calls are not cached and are diagnosed every time.
+constexpr int divide(int a, int b) {
+  return a / b; // expected-note 2{{division by zero}}
+}
+static_assert(divide(4, 2) == 2);
+static_assert(divide(1, 0) == 0); // expected-error {{constant}} expected-note {{call}}
+static_assert(divide(1, 0) == 0); // expected-error {{constant}} expected-note {{call}}
+
+// Calls made while evaluating a constant expression are kept apart from
+// calls made while folding.
+constexpr int mode() { return __builtin_is_constant_evaluated() ? 1 : 2; }
+static_assert(mode() == 1);
+const int folded = mode() + 0;
+static_assert(mode() == 1);
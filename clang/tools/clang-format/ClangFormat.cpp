@@ -25,7 +25,10 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/Process.h"
+#include "llvm/Support/ThreadPool.h"
+#include <atomic>
 #include <fstream>
+#include <optional>
 
 using namespace llvm;
 using clang::tooling::Replacements;
@@ -210,6 +213,12 @@ static cl::opt<bool> FailOnIncompleteFormat(
     cl::desc("If set, fail with exit code 1 on incomplete format."),
     cl::init(false), cl::cat(ClangFormatCategory));
 
+static cl::opt<unsigned> NumThreads(
+    "j",
+    cl::desc("Number of files to format in parallel when editing in place\n"
+             "with -i (0 = use all available hardware threads)."),
+    cl::init(1), cl::cat(ClangFormatCategory));
+
 static cl::opt<bool> ListIgnored("list-ignored",
                                  cl::desc("List ignored files."),
                                  cl::cat(ClangFormatCategory), cl::Hidden);
@@ -713,6 +722,15 @@ int main(int argc, const char **argv) {
     return 1;
   }
 
+  // In-place edits write nothing to stdout, so independent files can be
+  // formatted concurrently without reordering any output. Dry runs report
+  // their warnings on stderr, so they stay serial.
+  std::optional<DefaultThreadPool> Pool;
+  if (NumThreads != 1 && Inplace && !OutputXML && !DryRun &&
+      FileNames.size() > 1)
+    Pool.emplace(hardware_concurrency(NumThreads));
+  std::atomic<bool> ParallelError(false);
+
   unsigned FileNo = 1;
   bool Error = false;
   for (const auto &FileName : FileNames) {
@@ -728,7 +746,18 @@ int main(int argc, const char **argv) {
       errs() << "Formatting [" << FileNo++ << "/" << FileNames.size() << "] "
              << FileName << "\n";
     }
+    if (Pool) {
+      Pool->async([&ParallelError, FileName] {
+        if (clang::format::format(FileName, FailOnIncompleteFormat))
+          ParallelError = true;
+      });
+      continue;
+    }
     Error |= clang::format::format(FileName, FailOnIncompleteFormat);
   }
+  if (Pool) {
+    Pool->wait();
+    Error |= ParallelError;
+  }
   return Error ? 1 : 0;
 }
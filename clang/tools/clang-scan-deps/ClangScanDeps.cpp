@@ -18,6 +18,8 @@
 #include "clang/Tooling/Tooling.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/Twine.h"
+#include "llvm/CAS/BuiltinUnifiedCASDatabases.h"
+#include "llvm/CAS/ObjectStore.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/Format.h"
@@ -84,6 +86,7 @@ static ScanningMode ScanMode = ScanningMode::DependencyDirectivesScan;
 static ScanningOutputFormat Format = ScanningOutputFormat::Make;
 static ScanningOptimizations OptimizeArgs;
 static std::string ModuleFilesDir;
+static std::string DirectivesCASPath;
 static bool EagerLoadModules;
 static unsigned NumThreads = 0;
 static std::string CompilationDB;
@@ -95,6 +98,7 @@ static ResourceDirRecipeKind ResourceDirRecipe;
 static bool Verbose;
 static bool PrintTiming;
 static bool EmitVisibleModules;
+static bool StreamOutput;
 static llvm::BumpPtrAllocator Alloc;
 static llvm::StringSaver Saver{Alloc};
 static std::vector<const char *> CommandLine;
@@ -158,6 +162,13 @@ static void ParseArgs(int argc, char **argv) {
     Format = *FormatType;
   }
 
+  if (Args.hasArg(OPT_stream) && Format != ScanningOutputFormat::Full) {
+    llvm::errs() << ToolName
+                 << ": the -stream option requires -format=experimental-full\n";
+    std::exit(1);
+  }
+  StreamOutput = Args.hasArg(OPT_stream);
+
   std::vector<std::string> OptimizationFlags =
       Args.getAllArgValues(OPT_optimize_args_EQ);
   OptimizeArgs = ScanningOptimizations::None;
@@ -188,6 +199,9 @@ static void ParseArgs(int argc, char **argv) {
   if (const llvm::opt::Arg *A = Args.getLastArg(OPT_module_files_dir_EQ))
     ModuleFilesDir = A->getValue();
 
+  if (const llvm::opt::Arg *A = Args.getLastArg(OPT_directives_cas_path_EQ))
+    DirectivesCASPath = A->getValue();
+
   if (const llvm::opt::Arg *A = Args.getLastArg(OPT_o))
     OutputFileName = A->getValue();
 
@@ -397,7 +411,11 @@ static auto toJSONSorted(llvm::json::OStream &JOS, std::vector<std::string> V) {
 // Thread safe.
 class FullDeps {
 public:
-  FullDeps(size_t NumInputs) : Inputs(NumInputs) {}
+  /// If \p StreamOS is set, every module and translation unit is also written
+  /// to it as a single line of JSON as soon as it is known. A module is always
+  /// written before the translation units that depend on it.
+  FullDeps(size_t NumInputs, SharedStream *StreamOS = nullptr)
+      : Inputs(NumInputs), StreamOS(StreamOS) {}
 
   void mergeDeps(StringRef Input, TranslationUnitDeps TUDeps,
                  size_t InputIndex) {
@@ -417,6 +435,17 @@ public:
     assert(InputIndex < Inputs.size() && "Input index out of bounds");
     assert(Inputs[InputIndex].FileName.empty() && "Result already populated");
     Inputs[InputIndex] = std::move(ID);
+
+    if (StreamOS)
+      StreamOS->applyLocked([&](raw_ostream &OS) {
+        llvm::json::OStream JOS(OS);
+        JOS.object([&] {
+          JOS.attributeBegin("translation-unit");
+          printTranslationUnit(JOS, Inputs[InputIndex]);
+          JOS.attributeEnd();
+        });
+        OS << '\n';
+      });
   }
 
   void mergeDeps(ModuleDepsGraph Graph, size_t InputIndex) {
@@ -432,6 +461,21 @@ public:
         auto Res = Modules.insert(I, {{MD.ID, InputIndex}, std::move(MD)});
         NewMDs.push_back(&Res->second);
       }
+      // Print new modules before other threads can see them, so that no
+      // translation unit depending on them gets printed first.
+      if (StreamOS) {
+        for (ModuleDeps *MD : NewMDs)
+          StreamOS->applyLocked([&](raw_ostream &OS) {
+            llvm::json::OStream JOS(OS);
+            JOS.object([&] {
+              JOS.attributeBegin("module");
+              printModule(JOS, *MD);
+              JOS.attributeEnd();
+            });
+            OS << '\n';
+          });
+        return;
+      }
     }
     // First call to \c getBuildArguments is somewhat expensive. Let's call it
     // on the current thread (instead of the main one), and outside the
@@ -488,89 +532,13 @@ public:
 
     JOS.object([&] {
       JOS.attributeArray("modules", [&] {
-        for (auto &&ModID : ModuleIDs) {
-          auto &MD = Modules[ModID];
-          JOS.object([&] {
-            if (MD.IsInStableDirectories)
-              JOS.attribute("is-in-stable-directories",
-                            MD.IsInStableDirectories);
-            JOS.attributeArray("clang-module-deps",
-                               toJSONSorted(JOS, MD.ClangModuleDeps));
-            JOS.attribute("clang-modulemap-file",
-                          StringRef(MD.ClangModuleMapFile));
-            JOS.attributeArray("command-line",
-                               toJSONStrings(JOS, MD.getBuildArguments()));
-            JOS.attribute("context-hash", StringRef(MD.ID.ContextHash));
-            JOS.attributeArray("file-deps", [&] {
-              MD.forEachFileDep([&](StringRef FileDep) {
-                // Not reporting SDKSettings.json so that test checks can remain
-                // (mostly) platform-agnostic.
-                if (!FileDep.ends_with("SDKSettings.json"))
-                  JOS.value(FileDep);
-              });
-            });
-            JOS.attributeArray("link-libraries",
-                               toJSONSorted(JOS, MD.LinkLibraries));
-            JOS.attribute("name", StringRef(MD.ID.ModuleName));
-          });
-        }
+        for (auto &&ModID : ModuleIDs)
+          printModule(JOS, Modules[ModID]);
       });
 
       JOS.attributeArray("translation-units", [&] {
-        for (auto &&I : Inputs) {
-          JOS.object([&] {
-            JOS.attributeArray("commands", [&] {
-              if (I.DriverCommandLine.empty()) {
-                for (const auto &Cmd : I.Commands) {
-                  JOS.object([&] {
-                    JOS.attribute("clang-context-hash",
-                                  StringRef(I.ContextHash));
-                    if (!I.NamedModule.empty())
-                      JOS.attribute("named-module", (I.NamedModule));
-                    if (!I.NamedModuleDeps.empty())
-                      JOS.attributeArray("named-module-deps", [&] {
-                        for (const auto &Dep : I.NamedModuleDeps)
-                          JOS.value(Dep);
-                      });
-                    JOS.attributeArray("clang-module-deps",
-                                       toJSONSorted(JOS, I.ClangModuleDeps));
-                    JOS.attributeArray("command-line",
-                                       toJSONStrings(JOS, Cmd.Arguments));
-                    JOS.attribute("executable", StringRef(Cmd.Executable));
-                    JOS.attributeArray("file-deps",
-                                       toJSONStrings(JOS, I.FileDeps));
-                    JOS.attribute("input-file", StringRef(I.FileName));
-                    if (EmitVisibleModules)
-                      JOS.attributeArray("visible-clang-modules",
-                                         toJSONSorted(JOS, I.VisibleModules));
-                  });
-                }
-              } else {
-                JOS.object([&] {
-                  JOS.attribute("clang-context-hash", StringRef(I.ContextHash));
-                  if (!I.NamedModule.empty())
-                    JOS.attribute("named-module", (I.NamedModule));
-                  if (!I.NamedModuleDeps.empty())
-                    JOS.attributeArray("named-module-deps", [&] {
-                      for (const auto &Dep : I.NamedModuleDeps)
-                        JOS.value(Dep);
-                    });
-                  JOS.attributeArray("clang-module-deps",
-                                     toJSONSorted(JOS, I.ClangModuleDeps));
-                  JOS.attributeArray("command-line",
-                                     toJSONStrings(JOS, I.DriverCommandLine));
-                  JOS.attribute("executable", "clang");
-                  JOS.attributeArray("file-deps",
-                                     toJSONStrings(JOS, I.FileDeps));
-                  JOS.attribute("input-file", StringRef(I.FileName));
-                  if (EmitVisibleModules)
-                    JOS.attributeArray("visible-clang-modules",
-                                       toJSONSorted(JOS, I.VisibleModules));
-                });
-              }
-            });
-          });
-        }
+        for (auto &&I : Inputs)
+          printTranslationUnit(JOS, I);
       });
     });
   }
@@ -622,10 +590,86 @@ private:
     std::vector<Command> Commands;
   };
 
+  void printModule(llvm::json::OStream &JOS, ModuleDeps &MD) {
+    JOS.object([&] {
+      if (MD.IsInStableDirectories)
+        JOS.attribute("is-in-stable-directories", MD.IsInStableDirectories);
+      JOS.attributeArray("clang-module-deps",
+                         toJSONSorted(JOS, MD.ClangModuleDeps));
+      JOS.attribute("clang-modulemap-file", StringRef(MD.ClangModuleMapFile));
+      JOS.attributeArray("command-line",
+                         toJSONStrings(JOS, MD.getBuildArguments()));
+      JOS.attribute("context-hash", StringRef(MD.ID.ContextHash));
+      JOS.attributeArray("file-deps", [&] {
+        MD.forEachFileDep([&](StringRef FileDep) {
+          // Not reporting SDKSettings.json so that test checks can remain
+          // (mostly) platform-agnostic.
+          if (!FileDep.ends_with("SDKSettings.json"))
+            JOS.value(FileDep);
+        });
+      });
+      JOS.attributeArray("link-libraries", toJSONSorted(JOS, MD.LinkLibraries));
+      JOS.attribute("name", StringRef(MD.ID.ModuleName));
+    });
+  }
+
+  void printTranslationUnit(llvm::json::OStream &JOS, const InputDeps &I) {
+    JOS.object([&] {
+      JOS.attributeArray("commands", [&] {
+        if (I.DriverCommandLine.empty()) {
+          for (const auto &Cmd : I.Commands) {
+            JOS.object([&] {
+              JOS.attribute("clang-context-hash", StringRef(I.ContextHash));
+              if (!I.NamedModule.empty())
+                JOS.attribute("named-module", (I.NamedModule));
+              if (!I.NamedModuleDeps.empty())
+                JOS.attributeArray("named-module-deps", [&] {
+                  for (const auto &Dep : I.NamedModuleDeps)
+                    JOS.value(Dep);
+                });
+              JOS.attributeArray("clang-module-deps",
+                                 toJSONSorted(JOS, I.ClangModuleDeps));
+              JOS.attributeArray("command-line",
+                                 toJSONStrings(JOS, Cmd.Arguments));
+              JOS.attribute("executable", StringRef(Cmd.Executable));
+              JOS.attributeArray("file-deps", toJSONStrings(JOS, I.FileDeps));
+              JOS.attribute("input-file", StringRef(I.FileName));
+              if (EmitVisibleModules)
+                JOS.attributeArray("visible-clang-modules",
+                                   toJSONSorted(JOS, I.VisibleModules));
+            });
+          }
+        } else {
+          JOS.object([&] {
+            JOS.attribute("clang-context-hash", StringRef(I.ContextHash));
+            if (!I.NamedModule.empty())
+              JOS.attribute("named-module", (I.NamedModule));
+            if (!I.NamedModuleDeps.empty())
+              JOS.attributeArray("named-module-deps", [&] {
+                for (const auto &Dep : I.NamedModuleDeps)
+                  JOS.value(Dep);
+              });
+            JOS.attributeArray("clang-module-deps",
+                               toJSONSorted(JOS, I.ClangModuleDeps));
+            JOS.attributeArray("command-line",
+                               toJSONStrings(JOS, I.DriverCommandLine));
+            JOS.attribute("executable", "clang");
+            JOS.attributeArray("file-deps", toJSONStrings(JOS, I.FileDeps));
+            JOS.attribute("input-file", StringRef(I.FileName));
+            if (EmitVisibleModules)
+              JOS.attributeArray("visible-clang-modules",
+                                 toJSONSorted(JOS, I.VisibleModules));
+          });
+        }
+      });
+    });
+  }
+
   std::mutex Lock;
   std::unordered_map<IndexedModuleID, ModuleDeps, IndexedModuleID::Hasher>
       Modules;
   std::vector<InputDeps> Inputs;
+  SharedStream *StreamOS;
 };
 
 static bool handleTranslationUnitResult(
@@ -1018,7 +1062,8 @@ int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
   };
 
   if (Format == ScanningOutputFormat::Full)
-    FD.emplace(!ModuleNames ? Inputs.size() : 0);
+    FD.emplace(!ModuleNames ? Inputs.size() : 0,
+               StreamOutput ? &DependencyOS : nullptr);
 
   std::atomic<size_t> NumStatusCalls = 0;
   std::atomic<size_t> NumOpenFileForReadCalls = 0;
@@ -1174,6 +1219,18 @@ int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
   DependencyScanningService Service(ScanMode, Format, OptimizeArgs,
                                     EagerLoadModules, /*TraceVFS=*/Verbose);
 
+  if (!DirectivesCASPath.empty()) {
+    auto MaybeDBs =
+        llvm::cas::createOnDiskUnifiedCASDatabases(DirectivesCASPath);
+    if (!MaybeDBs) {
+      llvm::errs() << "Failed to open directives CAS '" << DirectivesCASPath
+                   << "': " << llvm::toString(MaybeDBs.takeError()) << '\n';
+      return 1;
+    }
+    Service.getSharedCache().setDirectivesCache(std::move(MaybeDBs->first),
+                                                std::move(MaybeDBs->second));
+  }
+
   llvm::Timer T;
   T.startTimer();
 
@@ -1219,7 +1276,7 @@ int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
     if (FD && FD->roundTripCommands(llvm::errs()))
       HadErrors = true;
 
-  if (Format == ScanningOutputFormat::Full)
+  if (Format == ScanningOutputFormat::Full && !StreamOutput)
     FD->printFullOutput(ThreadUnsafeDependencyOS);
   else if (Format == ScanningOutputFormat::P1689)
     PD.printDependencies(ThreadUnsafeDependencyOS);
@@ -15,6 +15,7 @@
 #include "llvm/TargetParser/Triple.h"
 #include "llvm/Testing/Support/SupportHelpers.h"
 #include "gtest/gtest.h"
+#include <set>
 
 namespace clang {
 namespace ast_matchers {
@@ -216,6 +217,54 @@ TEST(MatchFinder, CheckProfiling) {
   EXPECT_EQ("MyID", Records.begin()->getKey());
 }
 
+TEST(MatchFinder, TopLevelDeclFilter) {
+  std::set<std::string> Filtered;
+  MatchFinder::MatchFinderOptions Options;
+  Options.TopLevelDeclFilter = [&Filtered](const Decl &D) {
+    const auto *ND = dyn_cast<NamedDecl>(&D);
+    if (!ND)
+      return true;
+    Filtered.insert(ND->getNameAsString());
+    return !StringRef(ND->getName()).starts_with("skipped");
+  };
+  MatchFinder Finder(std::move(Options));
+
+  struct CollectNames : public MatchFinder::MatchCallback {
+    void run(const MatchFinder::MatchResult &Result) override {
+      Names.insert(Result.Nodes.getNodeAs<NamedDecl>("d")->getNameAsString());
+    }
+    std::set<std::string> Names;
+  } Callback;
+  Finder.addMatcher(namedDecl(unless(isImplicit())).bind("d"), &Callback);
+  std::unique_ptr<FrontendActionFactory> Factory(
+      newFrontendActionFactory(&Finder));
+  ASSERT_TRUE(tooling::runToolOnCode(Factory->create(), R"cpp(
+    int kept;
+    void skipped() { int inner; }
+    namespace ns {
+    int kept_in_ns;
+    int skipped_in_ns;
+    }
+    extern "C" {
+    int kept_in_extern_c;
+    int skipped_in_extern_c;
+    }
+  )cpp"));
+
+  // Rejected declarations are neither matched nor traversed.
+  EXPECT_EQ(Callback.Names,
+            (std::set<std::string>{"kept", "ns", "kept_in_ns",
+                                   "kept_in_extern_c"}));
+  // Namespaces and linkage specifications are not filtered themselves, but
+  // every declaration in them is, and nested declarations are not.
+  EXPECT_TRUE(Filtered.count("kept_in_ns"));
+  EXPECT_TRUE(Filtered.count("skipped_in_ns"));
+  EXPECT_TRUE(Filtered.count("kept_in_extern_c"));
+  EXPECT_TRUE(Filtered.count("skipped_in_extern_c"));
+  EXPECT_FALSE(Filtered.count("ns"));
+  EXPECT_FALSE(Filtered.count("inner"));
+}
+
 class VerifyStartOfTranslationUnit : public MatchFinder::MatchCallback {
 public:
   VerifyStartOfTranslationUnit() : Called(false) {}
@@ -252,6 +252,33 @@ TEST_F(HeaderSearchTest, HeaderFrameworkLookup) {
   EXPECT_EQ(Search.getIncludeNameForHeader(FE), "Foo/Foo.h");
 }
 
+TEST_F(HeaderSearchTest, SubdirectoryLookupAcrossSearchDirs) {
+  addSearchDir("/a");
+  addSearchDir("/b");
+  for (StringRef Path : {"/a/other/x.h", "/b/foo/bar.h"})
+    VFS->addFile(Path, 0, llvm::MemoryBuffer::getMemBufferCopy("", Path),
+                 /*User=*/std::nullopt, /*Group=*/std::nullopt,
+                 llvm::sys::fs::file_type::regular_file);
+
+  auto Lookup = [&](StringRef Filename) {
+    return Search.LookupFile(
+        Filename, SourceLocation(), /*isAngled=*/false, /*FromDir=*/nullptr,
+        /*CurDir=*/nullptr, /*Includers=*/{}, /*SearchPath=*/nullptr,
+        /*RelativePath=*/nullptr, /*RequestingModule=*/nullptr,
+        /*SuggestedModule=*/nullptr, /*IsMapped=*/nullptr,
+        /*IsFrameworkFound=*/nullptr);
+  };
+
+  auto FoundFile = Lookup("foo/bar.h");
+  ASSERT_TRUE(FoundFile.has_value());
+  EXPECT_EQ(FoundFile->getName(), "/b/foo/bar.h");
+  FoundFile = Lookup("other/x.h");
+  ASSERT_TRUE(FoundFile.has_value());
+  EXPECT_EQ(FoundFile->getName(), "/a/other/x.h");
+  EXPECT_FALSE(Lookup("foo/missing.h").has_value());
+  EXPECT_FALSE(Lookup("missing/bar.h").has_value());
+}
+
 // Helper struct with null terminator character to make MemoryBuffer happy.
 template <class FileTy, class PaddingTy>
 struct NullTerminatedFile : public FileTy {
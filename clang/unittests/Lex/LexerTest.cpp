@@ -707,6 +707,23 @@ TEST_F(LexerTest, RawAndNormalLexSameForLineComments) {
   EXPECT_TRUE(ToksView.empty());
 }
 
+TEST_F(LexerTest, LongLineComments) {
+  // Line comments longer than a vector register, ending at every offset
+  // within one, with and without escaped newlines and non-ASCII characters.
+  for (unsigned Len = 0; Len != 40; ++Len) {
+    std::string Body(Len, 'x');
+    CheckLex("// " + Body + "\nint a;",
+             {tok::kw_int, tok::identifier, tok::semi});
+    CheckLex("// " + Body + "\r\nint a;",
+             {tok::kw_int, tok::identifier, tok::semi});
+    CheckLex("// " + Body + "\\\n" + Body + "\nint a;",
+             {tok::kw_int, tok::identifier, tok::semi});
+    CheckLex("// " + Body + "\xc3\xa9" + Body + "\nint a;",
+             {tok::kw_int, tok::identifier, tok::semi});
+    EXPECT_TRUE(Lex("// " + Body).empty());
+  }
+}
+
 TEST_F(LexerTest, GetRawTokenOnEscapedNewLineChecksWhitespace) {
   const llvm::StringLiteral Source = R"cc(
   #define ONE \
@@ -7,7 +7,10 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
+#include "clang/Lex/DependencyDirectivesScanner.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/CAS/ActionCache.h"
+#include "llvm/CAS/ObjectStore.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include "gtest/gtest.h"
 
@@ -264,3 +267,63 @@ TEST(DependencyScanningFilesystem, DoNotDiagnoseDirSizeChange) {
   auto InvalidEntries = SharedCache.getOutOfDateEntries(*FS);
   EXPECT_EQ(InvalidEntries.size(), 0u);
 }
+
+TEST(DependencyScanningFilesystemSharedCache, PersistedDirectivesRoundTrip) {
+  using namespace clang::dependency_directives_scan;
+  std::shared_ptr<llvm::cas::ObjectStore> CAS = llvm::cas::createInMemoryCAS();
+  std::shared_ptr<llvm::cas::ActionCache> Cache =
+      llvm::cas::createInMemoryActionCache();
+
+  StringRef Source = "#include \"a.h\"\n"
+                     "#if FOO\n"
+                     "#import <b.h>\n"
+                     "#endif\n";
+  SmallVector<Token> Tokens;
+  SmallVector<Directive> Directives;
+  ASSERT_FALSE(clang::scanSourceForDependencyDirectives(Source, Tokens,
+                                                         Directives));
+
+  {
+    DependencyScanningFilesystemSharedCache Writer;
+    EXPECT_FALSE(Writer.getDirectivesCacheKey(Source));
+    Writer.setDirectivesCache(CAS, Cache);
+    auto Key = Writer.getDirectivesCacheKey(Source);
+    ASSERT_TRUE(Key);
+    Writer.storeDirectives(*Key, Tokens, Directives);
+  }
+
+  // A shared cache in a later scanning process sees the same directives.
+  DependencyScanningFilesystemSharedCache Reader;
+  Reader.setDirectivesCache(CAS, Cache);
+  auto Key = Reader.getDirectivesCacheKey(Source);
+  ASSERT_TRUE(Key);
+  SmallVector<Token> LoadedTokens;
+  SmallVector<Directive> LoadedDirectives;
+  ASSERT_TRUE(Reader.loadDirectives(*Key, Source.size(), LoadedTokens,
+                                    LoadedDirectives));
+
+  ASSERT_EQ(LoadedTokens.size(), Tokens.size());
+  for (auto [Loaded, Scanned] : llvm::zip_equal(LoadedTokens, Tokens)) {
+    EXPECT_EQ(Loaded.Offset, Scanned.Offset);
+    EXPECT_EQ(Loaded.Length, Scanned.Length);
+    EXPECT_EQ(Loaded.Kind, Scanned.Kind);
+    EXPECT_EQ(Loaded.Flags, Scanned.Flags);
+  }
+  ASSERT_EQ(LoadedDirectives.size(), Directives.size());
+  for (auto [Loaded, Scanned] : llvm::zip_equal(LoadedDirectives, Directives)) {
+    EXPECT_EQ(Loaded.Kind, Scanned.Kind);
+    EXPECT_EQ(Loaded.Tokens.size(), Scanned.Tokens.size());
+    // The loaded directives refer to the loaded tokens.
+    if (!Loaded.Tokens.empty())
+      EXPECT_EQ(Loaded.Tokens.data() - LoadedTokens.data(),
+                Scanned.Tokens.data() - Tokens.data());
+  }
+
+  // Different contents don't find the entry.
+  auto OtherKey = Reader.getDirectivesCacheKey("#include \"c.h\"\n");
+  ASSERT_TRUE(OtherKey);
+  LoadedTokens.clear();
+  LoadedDirectives.clear();
+  EXPECT_FALSE(Reader.loadDirectives(*OtherKey, 16, LoadedTokens,
+                                     LoadedDirectives));
+}
@@ -259,9 +259,32 @@ uptr __asan_region_is_poisoned(uptr beg, uptr size) {
        __sanitizer::mem_is_zero((const char *)shadow_beg,
                                 shadow_end - shadow_beg)))
     return 0;
-  // The fast check failed, so we have a poisoned byte somewhere.
-  // Find it slowly.
-  for (; beg < end; beg++)
+  // The fast check failed, so we have a poisoned byte somewhere. Checking
+  // every application byte would take a shadow load per byte, so only do that
+  // for the unaligned head and tail. In between, skip over zero shadow a word
+  // at a time and only look at the bytes of the first granule that has a
+  // non-zero shadow.
+  for (; beg < end && beg < aligned_b; beg++)
+    if (__asan::AddressIsPoisoned(beg))
+      return beg;
+  for (uptr shadow = shadow_beg; shadow < shadow_end;) {
+    if (IsAligned(shadow, sizeof(uptr)) &&
+        shadow + sizeof(uptr) <= shadow_end &&
+        !*reinterpret_cast<const uptr *>(shadow)) {
+      shadow += sizeof(uptr);
+      continue;
+    }
+    if (*reinterpret_cast<const u8 *>(shadow)) {
+      uptr granule =
+          aligned_b + (shadow - shadow_beg) * ASAN_SHADOW_GRANULARITY;
+      for (beg = granule; beg < granule + ASAN_SHADOW_GRANULARITY; beg++)
+        if (__asan::AddressIsPoisoned(beg))
+          return beg;
+      UNREACHABLE("non-zero shadow, but poisoned byte was not found");
+    }
+    shadow++;
+  }
+  for (beg = Max(beg, aligned_e); beg < end; beg++)
     if (__asan::AddressIsPoisoned(beg))
       return beg;
   UNREACHABLE("mem_is_zero returned false, but poisoned byte was not found");
@@ -39,6 +39,11 @@ Arena *FlatCtxArenaHead = nullptr;
 SANITIZER_GUARDED_BY(FlatCtxArenaMutex)
 Arena *FlatCtxArena = nullptr;
 
+// The ContextRoot::TotalEntries shard this thread bumps, plus one; 0 until the
+// thread first enters a root. Shards are handed out round-robin.
+__thread uint32_t EntryShardPlusOne = 0;
+__sanitizer::atomic_uint32_t NextEntryShard = {};
+
 // Set to true when we enter a root, and false when we exit - regardless if this
 // thread collects a contextual profile for that root.
 __thread bool IsUnderContext = false;
@@ -270,6 +275,28 @@ void setupContext(ContextRoot *Root, GUID Guid, uint32_t NumCounters,
   AllContextRoots.PushBack(Root);
 }
 
+void ContextRoot::countEntry() {
+  if (!EntryShardPlusOne) {
+    auto Shard = __sanitizer::atomic_fetch_add(
+        &NextEntryShard, 1, __sanitizer::memory_order_relaxed);
+    EntryShardPlusOne = Shard % NumEntryShards + 1;
+  }
+  __sanitizer::atomic_fetch_add(&TotalEntries[EntryShardPlusOne - 1].Count, 1,
+                                __sanitizer::memory_order_relaxed);
+}
+
+uint64_t ContextRoot::getTotalEntries() const {
+  uint64_t Total = 0;
+  for (const auto &Shard : TotalEntries)
+    Total += __sanitizer::atomic_load_relaxed(&Shard.Count);
+  return Total;
+}
+
+void ContextRoot::resetTotalEntries() {
+  for (auto &Shard : TotalEntries)
+    __sanitizer::atomic_store_relaxed(&Shard.Count, 0);
+}
+
 ContextRoot *FunctionData::getOrAllocateContextRoot() {
   auto *Root = CtxRoot;
   if (!canBeRoot(Root))
@@ -279,7 +306,10 @@ ContextRoot *FunctionData::getOrAllocateContextRoot() {
   __sanitizer::GenericScopedLock<__sanitizer::StaticSpinMutex> L(&Mutex);
   Root = CtxRoot;
   if (!Root) {
-    Root = new (__sanitizer::InternalAlloc(sizeof(ContextRoot))) ContextRoot();
+    Root = new (__sanitizer::InternalAlloc(sizeof(ContextRoot),
+                                           /*cache=*/nullptr,
+                                           /*alignment=*/alignof(ContextRoot)))
+        ContextRoot();
     CtxRoot = Root;
   }
 
@@ -291,8 +321,7 @@ ContextNode *tryStartContextGivenRoot(ContextRoot *Root, GUID Guid,
                                       uint32_t Counters, uint32_t Callsites)
     SANITIZER_NO_THREAD_SAFETY_ANALYSIS {
   IsUnderContext = true;
-  __sanitizer::atomic_fetch_add(&Root->TotalEntries, 1,
-                                __sanitizer::memory_order_relaxed);
+  Root->countEntry();
   if (!Root->FirstMemBlock) {
     setupContext(Root, Guid, Counters, Callsites);
   }
@@ -439,7 +468,7 @@ void __llvm_ctx_profile_start_collection(unsigned AutodetectDuration) {
     resetContextNode(*Root->FirstNode);
     if (Root->FirstUnhandledCalleeNode)
       resetContextNode(*Root->FirstUnhandledCalleeNode);
-    __sanitizer::atomic_store_relaxed(&Root->TotalEntries, 0);
+    Root->resetTotalEntries();
   }
   if (AutodetectDuration) {
     // we leak RD intentionally. Knowing when to free it is tricky, there's a
@@ -477,7 +506,7 @@ bool __llvm_ctx_profile_fetch(ProfileWriter &Writer) {
     }
     Writer.writeContextual(
         *Root->FirstNode, Root->FirstUnhandledCalleeNode,
-        __sanitizer::atomic_load_relaxed(&Root->TotalEntries));
+        Root->getTotalEntries());
   }
   Writer.endContextSection();
   Writer.startFlatSection();
@@ -81,8 +81,19 @@ struct ContextRoot {
   Arena *FirstMemBlock = nullptr;
   Arena *CurrentMem = nullptr;
 
-  // Count the number of entries - regardless if we could take the `Taken` mutex
-  ::__sanitizer::atomic_uint64_t TotalEntries = {};
+  // Count the number of entries - regardless if we could take the `Taken`
+  // mutex. Every thread entering the root bumps this count, which for a root
+  // entered by many server threads makes it heavily contended. So it is split
+  // in cache line sized shards, and each thread only ever bumps its own shard.
+  static constexpr uint32_t NumEntryShards = 16;
+  struct alignas(::__sanitizer::kCacheLineSize) EntryShard {
+    ::__sanitizer::atomic_uint64_t Count = {};
+  };
+  EntryShard TotalEntries[NumEntryShards];
+
+  void countEntry();
+  uint64_t getTotalEntries() const;
+  void resetTotalEntries();
 
   // Profiles for functions we encounter when collecting a contexutal profile,
   // that are not associated with a callsite. This is expected to happen for
@@ -122,7 +133,9 @@ struct ContextRoot {
   // or with more concurrent collections (==more memory) and less collection
   // time. Note that concurrent collection does happen for different
   // entrypoints, regardless.
-  ::__sanitizer::SpinMutex Taken;
+  // Threads failing to take this mutex still write its cache line, so keep it
+  // away from the fields above, which the thread holding it keeps reading.
+  alignas(::__sanitizer::kCacheLineSize) ::__sanitizer::SpinMutex Taken;
 };
 
 // This is allocated and zero-initialized by the compiler, the in-place
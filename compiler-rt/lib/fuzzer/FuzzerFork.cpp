@@ -20,6 +20,7 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <fstream>
 #include <memory>
 #include <mutex>
@@ -96,11 +97,16 @@ struct GlobalEnv {
   std::set<std::string> FilesWithDFT;
   std::vector<std::string> Files;
   std::vector<std::size_t> FilesSizes;
+  // Inputs added to the corpus recently, with the id of the first job that
+  // hadn't been created yet when they were added.
+  std::deque<std::pair<size_t, std::string>> RecentFiles;
+  size_t LastJobId = 0;
   Random *Rand;
   std::chrono::system_clock::time_point ProcessStartTime;
   int Verbosity = 0;
   int Group = 0;
   int NumCorpuses = 8;
+  size_t NumJobs = 1;
 
   size_t NumTimeouts = 0;
   size_t NumOOMs = 0;
@@ -163,6 +169,14 @@ struct GlobalEnv {
       assert(DftTimeInSeconds < std::numeric_limits<int>::max());
       Job->DftTimeInSeconds = static_cast<int>(DftTimeInSeconds);
     }
+    // Seed the next job of every worker with the inputs other jobs found
+    // meanwhile, instead of waiting for them to be picked by chance.
+    LastJobId = JobId;
+    while (!RecentFiles.empty() &&
+           RecentFiles.front().first + NumJobs <= JobId)
+      RecentFiles.pop_front();
+    for (auto &RF : RecentFiles)
+      Seeds += (Seeds.empty() ? "" : ",") + RF.second;
     if (!Seeds.empty()) {
       Job->SeedListPath =
           DirPlusFile(TempDir, std::to_string(JobId) + ".seeds");
@@ -249,6 +263,7 @@ struct GlobalEnv {
       } else {
         Files.push_back(NewPath);
       }
+      RecentFiles.push_back({LastJobId + 1, NewPath});
     }
     Features.insert(NewFeatures.begin(), NewFeatures.end());
     Cov.insert(NewCov.begin(), NewCov.end());
@@ -322,6 +337,7 @@ void FuzzWithFork(Random &Rand, const FuzzingOptions &Options,
   Env.ProcessStartTime = std::chrono::system_clock::now();
   Env.DataFlowBinary = Options.CollectDataFlow;
   Env.Group = Options.ForkCorpusGroups;
+  Env.NumJobs = NumJobs;
 
   std::vector<SizedFile> SeedFiles;
   for (auto &Dir : CorpusDirs)
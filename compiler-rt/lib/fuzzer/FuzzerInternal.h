@@ -98,6 +98,7 @@ private:
   void CrashCallback();
   void ExitCallback();
   void CrashOnOverwrittenData();
+  int RunCallbackInChild(uint8_t *DataCopy, const uint8_t *Data, size_t Size);
   void InterruptCallback();
   void MutateAndTestOne();
   void PurgeAllocator();
@@ -126,6 +127,12 @@ private:
   size_t LastCorpusUpdateRun = 0;
 
   bool HasMoreMallocsThanFrees = false;
+
+  // Shared with the child processes of -isolate_inputs: the callback result,
+  // whether the child has already reported a bug, and the coverage state of
+  // the last input.
+  uint8_t *ChildState = nullptr;
+  bool InIsolatedChild = false;
   size_t NumberOfLeakDetectionAttempts = 0;
 
   system_clock::time_point LastAllocatorPurgeAttemptTime = system_clock::now();
@@ -174,6 +174,11 @@ void Fuzzer::StaticDeathCallback() {
 void Fuzzer::DumpCurrentUnit(const char *Prefix) {
   if (!CurrentUnitData)
     return; // Happens when running individual inputs.
+  if (InIsolatedChild) {
+    // Tell the parent not to report this input again.
+    int Reported = 1;
+    memcpy(ChildState + sizeof(int), &Reported, sizeof(Reported));
+  }
   ScopedDisableMsanInterceptorChecks S;
   MD.PrintMutationSequence();
   Printf("; base unit: %s\n", Sha1ToString(BaseSha1).c_str());
@@ -616,7 +621,10 @@ ATTRIBUTE_NOINLINE bool Fuzzer::ExecuteCallback(const uint8_t *Data,
     UnitStartTime = system_clock::now();
     TPC.ResetMaps();
     RunningUserCallback = true;
-    CBRes = CB(DataCopy, Size);
+    if (Options.IsolateInputs)
+      CBRes = RunCallbackInChild(DataCopy, Data, Size);
+    else
+      CBRes = CB(DataCopy, Size);
     RunningUserCallback = false;
     UnitStopTime = system_clock::now();
     assert(CBRes == 0 || CBRes == -1);
@@ -629,6 +637,56 @@ ATTRIBUTE_NOINLINE bool Fuzzer::ExecuteCallback(const uint8_t *Data,
   return CBRes == 0;
 }
 
+// Runs the callback in a forked child, so that state the target keeps between
+// inputs never leaks from one input into the next, and copies the coverage the
+// child collected back into this process. Crashes are reported by the child;
+// the alarm handler of this process still enforces -timeout.
+int Fuzzer::RunCallbackInChild(uint8_t *DataCopy, const uint8_t *Data,
+                               size_t Size) {
+  if (!ChildState)
+    ChildState = MapSharedMemory(2 * sizeof(int) + TPC.CoverageStateSize());
+  if (!ChildState) {
+    Printf("WARNING: -isolate_inputs is not supported on this platform, "
+           "running inputs in-process\n");
+    Options.IsolateInputs = false;
+    return CB(DataCopy, Size);
+  }
+  int Reported = 0;
+  memcpy(ChildState + sizeof(int), &Reported, sizeof(Reported));
+  int ExitCode = RunInForkedChild([&] {
+    InIsolatedChild = true;
+    int CBRes = CB(DataCopy, Size);
+    if (!LooseMemeq(DataCopy, Data, Size))
+      CrashOnOverwrittenData();
+    memcpy(ChildState, &CBRes, sizeof(CBRes));
+    TPC.SaveCoverageState(ChildState + 2 * sizeof(int));
+  });
+  if (ExitCode < 0) {
+    // The child could not be started (e.g. fork() hit a resource limit). This
+    // says nothing about the input, so run it in-process instead.
+    Printf("WARNING: -isolate_inputs failed to fork a child, running the input "
+           "in-process\n");
+    return CB(DataCopy, Size);
+  }
+  memcpy(&Reported, ChildState + sizeof(int), sizeof(Reported));
+  // The child reports bugs through the usual callbacks, but the sanitizer may
+  // pick its own exit code afterwards.
+  if (ExitCode != 0 && Reported)
+    _Exit(ExitCode); // The child has already reported the bug.
+  if (ExitCode != 0) {
+    Printf("==%lu== ERROR: libFuzzer: isolated input run failed (exit code "
+           "%d)\n",
+           GetPid(), ExitCode);
+    DumpCurrentUnit("crash-");
+    PrintFinalStats();
+    _Exit(Options.ErrorExitCode);
+  }
+  int CBRes;
+  memcpy(&CBRes, ChildState, sizeof(CBRes));
+  TPC.RestoreCoverageState(ChildState + 2 * sizeof(int));
+  return CBRes;
+}
+
 std::string Fuzzer::WriteToOutputCorpus(const Unit &U) {
   if (Options.OnlyASCII)
     assert(IsASCII(U));
@@ -418,6 +418,49 @@ void TracePC::ClearInlineCounters() {
   });
 }
 
+size_t TracePC::CoverageStateSize() {
+  size_t Size = sizeof(ValueProfileMap) + sizeof(__sancov_lowest_stack) +
+                (ExtraCountersEnd() - ExtraCountersBegin());
+  IterateCounterRegions([&](const Module::Region &R) {
+    if (R.Enabled)
+      Size += R.Stop - R.Start;
+  });
+  return Size;
+}
+
+void TracePC::SaveCoverageState(uint8_t *Dst) {
+  auto Save = [&](const void *Src, size_t Size) {
+    if (Size)
+      memcpy(Dst, Src, Size);
+    Dst += Size;
+  };
+  IterateCounterRegions([&](const Module::Region &R) {
+    if (R.Enabled)
+      Save(R.Start, R.Stop - R.Start);
+  });
+  Save(ExtraCountersBegin(), ExtraCountersEnd() - ExtraCountersBegin());
+  Save(&ValueProfileMap, sizeof(ValueProfileMap));
+  uintptr_t LowestStack = __sancov_lowest_stack;
+  Save(&LowestStack, sizeof(LowestStack));
+}
+
+void TracePC::RestoreCoverageState(const uint8_t *Src) {
+  auto Restore = [&](void *Dst, size_t Size) {
+    if (Size)
+      memcpy(Dst, Src, Size);
+    Src += Size;
+  };
+  IterateCounterRegions([&](const Module::Region &R) {
+    if (R.Enabled)
+      Restore(R.Start, R.Stop - R.Start);
+  });
+  Restore(ExtraCountersBegin(), ExtraCountersEnd() - ExtraCountersBegin());
+  Restore(&ValueProfileMap, sizeof(ValueProfileMap));
+  uintptr_t LowestStack;
+  Restore(&LowestStack, sizeof(LowestStack));
+  __sancov_lowest_stack = LowestStack;
+}
+
 ATTRIBUTE_NO_SANITIZE_ALL
 void TracePC::RecordInitialStack() {
   int stack;
@@ -89,6 +89,12 @@ class TracePC {
 
   void ClearInlineCounters();
 
+  // Serializes the coverage collected for the current input (counters, value
+  // profile and stack depth) so that it can be moved between processes.
+  size_t CoverageStateSize();
+  void SaveCoverageState(uint8_t *Dst);
+  void RestoreCoverageState(const uint8_t *Src);
+
   void UpdateFeatureSet(size_t CurrentElementIdx, size_t CurrentElementSize);
   void PrintFeatureSet();
 
@@ -15,6 +15,7 @@
 #include "FuzzerBuiltinsMsvc.h"
 #include "FuzzerCommand.h"
 #include "FuzzerDefs.h"
+#include <functional>
 
 namespace fuzzer {
 
@@ -59,6 +60,15 @@ size_t GetPeakRSSMb();
 int ExecuteCommand(const Command &Cmd);
 bool ExecuteCommand(const Command &Cmd, std::string *CmdOutput);
 
+// Maps Size bytes of zero-initialized memory that stays shared with the
+// children created by RunInForkedChild. Returns nullptr if not supported.
+uint8_t *MapSharedMemory(size_t Size);
+
+// Runs F in a forked child of this process and waits for it. Returns the exit
+// code of the child (0 if F returned), 128 + the signal number if the child
+// was killed by a signal, or -1 if the child could not be created.
+int RunInForkedChild(const std::function<void()> &F);
+
 void SetThreadName(std::thread &thread, const std::string &name);
 
 // Fuchsia does not have popen/pclose.
@@ -655,6 +655,10 @@ void DiscardOutput(int Fd) {
   dup2(nullfd, Fd);
 }
 
+uint8_t *MapSharedMemory(size_t Size) { return nullptr; }
+
+int RunInForkedChild(const std::function<void()> &F) { return -1; }
+
 size_t PageSize() {
   static size_t PageSizeCached = _zx_system_get_page_size();
   return PageSizeCached;
@@ -24,8 +24,12 @@
 #include <sys/syscall.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <sys/wait.h>
 #include <thread>
 #include <unistd.h>
+#if LIBFUZZER_LINUX
+#include <sys/prctl.h>
+#endif
 
 namespace fuzzer {
 
@@ -190,6 +194,33 @@ size_t PageSize() {
   return PageSizeCached;
 }
 
+uint8_t *MapSharedMemory(size_t Size) {
+  void *P = mmap(nullptr, Size, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  return P == MAP_FAILED ? nullptr : static_cast<uint8_t *>(P);
+}
+
+int RunInForkedChild(const std::function<void()> &F) {
+  pid_t Pid = fork();
+  if (Pid < 0)
+    return -1;
+  if (Pid == 0) {
+#if LIBFUZZER_LINUX
+    // Don't outlive the parent if it exits, e.g. on a timeout.
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+    F();
+    _Exit(0); // Skip atexit handlers and stdio flushing of the parent state.
+  }
+  int Status;
+  while (waitpid(Pid, &Status, 0) < 0)
+    if (errno != EINTR)
+      return -1;
+  if (WIFSIGNALED(Status))
+    return 128 + WTERMSIG(Status);
+  return WEXITSTATUS(Status);
+}
+
 }  // namespace fuzzer
 
 #endif // LIBFUZZER_POSIX
@@ -229,6 +229,10 @@ void DiscardOutput(int Fd) {
   fclose(Temp);
 }
 
+uint8_t *MapSharedMemory(size_t Size) { return nullptr; }
+
+int RunInForkedChild(const std::function<void()> &F) { return -1; }
+
 size_t PageSize() {
   static size_t PageSizeCached = []() -> size_t {
     SYSTEM_INFO si;
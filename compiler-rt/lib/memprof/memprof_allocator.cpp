@@ -107,6 +107,99 @@ static int GetTimestamp(void) {
   return (ts.tv_sec - memprof_init_timestamp_s) * 1000 + ts.tv_nsec / 1000000;
 }
 
+// Returns the number of bytes to allocate before taking the next heap sample.
+// The distance is exponentially distributed with a mean of |interval| bytes,
+// so that samples form a Poisson process over the allocated bytes.
+static uptr NextSampleDistance(u64 &state, uptr interval) {
+  if (!state)
+    state = (reinterpret_cast<uptr>(&state) ^ NanoTime()) | 1;
+  // xorshift64*
+  state ^= state >> 12;
+  state ^= state << 25;
+  state ^= state >> 27;
+  u64 rand = (state * 0x2545F4914F6CDD1DULL) >> 11; // 53 random bits.
+  // -ln(U) for U uniform in (0, 1], with log2 approximated from the exponent
+  // and a quadratic fit of the mantissa (absolute error below 0.01).
+  double u = (rand + 1) * (1.0 / (1ULL << 53));
+  int exp = 0;
+  while (u < 0.5) {
+    u *= 2;
+    exp--;
+  }
+  double m = 2 * u - 1; // u = (1 + m) / 2 * 2^exp, m in [0, 1).
+  double log2_u = exp - 1 + m * (1.3465 - 0.3465 * m);
+  return static_cast<uptr>(-log2_u * 0.6931471805599453 * interval) + 1;
+}
+
+// Decides whether an allocation of |size| bytes is profiled. |scaled| is set
+// if it was picked by heap sampling rather than profiled unconditionally.
+static bool ShouldSample(MemprofThreadLocalMallocStorage *ms, uptr size,
+                         bool &scaled) {
+  uptr interval = flags()->sample_interval;
+  if (!interval || !ms)
+    return true;
+  if (UNLIKELY(!ms->sample_rand_state))
+    ms->bytes_until_sample =
+        NextSampleDistance(ms->sample_rand_state, interval);
+  if (LIKELY(ms->bytes_until_sample > size)) {
+    ms->bytes_until_sample -= size;
+    return false;
+  }
+  // Pick the next sample point, skipping any further sample points this
+  // allocation covers; a large allocation is only sampled once.
+  uptr overshoot = size - ms->bytes_until_sample;
+  do {
+    uptr next = NextSampleDistance(ms->sample_rand_state, interval);
+    if (next > overshoot) {
+      ms->bytes_until_sample = next - overshoot;
+      break;
+    }
+    overshoot -= next;
+  } while (true);
+  scaled = true;
+  return true;
+}
+
+// Returns the number of allocations of |size| bytes that one sampled
+// allocation stands for, the inverse of its sampling probability
+// 1 - exp(-size / interval), rounded to the nearest integer.
+static u32 SampleWeight(uptr size, uptr interval) {
+  double x = static_cast<double>(size) / interval;
+  if (x >= 40)
+    return 1;
+  // exp(-x) = exp(-k) * exp(-f) with k = floor(x) and f in [0, 1). 1 - exp(-f)
+  // is summed as a series so that small allocations don't lose precision.
+  u32 k = static_cast<u32>(x);
+  double f = x - k;
+  double term = 1, one_minus_exp_f = 0;
+  for (int n = 1; n <= 14; n++) {
+    term *= -f / n;
+    one_minus_exp_f -= term;
+  }
+  double exp_k = 1;
+  for (u32 i = 0; i < k; i++)
+    exp_k *= 0.36787944117144233; // exp(-1)
+  double p = 1 - exp_k * (1 - one_minus_exp_f);
+  double weight = 1 / p + 0.5;
+  if (weight >= static_cast<double>(UINT32_MAX))
+    return UINT32_MAX;
+  return static_cast<u32>(weight);
+}
+
+// Scales the totals of a MIB recorded for a sampled allocation, so that they
+// estimate the totals over all allocations of the context. The per-context
+// averages, the min and max values are unchanged.
+static void ScaleSampledMIB(MemInfoBlock &mib) {
+  u32 weight = SampleWeight(mib.TotalSize, flags()->sample_interval);
+  mib.AllocCount *= weight;
+  mib.TotalAccessCount *= weight;
+  mib.TotalSize *= weight;
+  mib.TotalLifetime *= weight;
+  mib.TotalAccessDensity *= weight;
+  mib.TotalLifetimeAccessDensity *= weight;
+  mib.NumMigratedCpu *= weight;
+}
+
 static MemprofAllocator &get_allocator();
 
 // The memory chunk allocated from the underlying allocator looks like this:
@@ -134,9 +227,14 @@ struct ChunkHeader {
   // 3-rd 4 bytes
   u32 timestamp_ms;
   // 4-th 4 bytes
-  // Note only 1 bit is needed for this flag if we need space in the future for
-  // more fields.
-  u32 from_memalign;
+  // Note only 1 bit is needed for each of these flags if we need space in the
+  // future for more fields.
+  u16 from_memalign;
+  // Set if the chunk was not picked by heap sampling and is not profiled.
+  u8 not_sampled;
+  // Set if the chunk was picked by heap sampling, so its MIB is scaled by the
+  // inverse of the sampling probability.
+  u8 scaled;
   // 5-th and 6-th 4 bytes
   // The max size of an allocation is 2^40 (kMaxAllowedMallocSize), so this
   // could be shrunk to kMaxAllowedMallocBits if we need space in the future for
@@ -312,11 +410,12 @@ struct Allocator {
 
   // See memprof_mapping.h for an overview on histogram counters.
   static MemInfoBlock CreateNewMIB(uptr p, MemprofChunk *m, u64 user_size) {
-    if (__memprof_histogram) {
-      return CreateNewMIBWithHistogram(p, m, user_size);
-    } else {
-      return CreateNewMIBWithoutHistogram(p, m, user_size);
-    }
+    MemInfoBlock newMIB = __memprof_histogram
+                              ? CreateNewMIBWithHistogram(p, m, user_size)
+                              : CreateNewMIBWithoutHistogram(p, m, user_size);
+    if (m->scaled)
+      ScaleSampledMIB(newMIB);
+    return newMIB;
   }
 
   static MemInfoBlock CreateNewMIBWithHistogram(uptr p, MemprofChunk *m,
@@ -385,7 +484,7 @@ struct Allocator {
           Allocator *A = (Allocator *)alloc;
           MemprofChunk *m =
               A->GetMemprofChunk((void *)chunk, user_requested_size);
-          if (!m)
+          if (!m || m->not_sampled)
             return;
           uptr user_beg = ((uptr)m) + kChunkHeaderSize;
           MemInfoBlock newMIB = CreateNewMIB(user_beg, m, user_requested_size);
@@ -445,6 +544,9 @@ struct Allocator {
     }
 
     MemprofThread *t = GetCurrentThread();
+    bool scaled = false;
+    bool sampled =
+        ShouldSample(t ? &t->malloc_storage() : nullptr, size, scaled);
     void *allocated;
     if (t) {
       AllocatorCache *cache = GetAllocatorCache(&t->malloc_storage());
@@ -472,16 +574,20 @@ struct Allocator {
     uptr chunk_beg = user_beg - kChunkHeaderSize;
     MemprofChunk *m = reinterpret_cast<MemprofChunk *>(chunk_beg);
     m->from_memalign = alloc_beg != chunk_beg;
+    m->not_sampled = !sampled;
+    m->scaled = scaled;
     CHECK(size);
 
-    m->cpu_id = GetCpuId();
-    m->timestamp_ms = GetTimestamp();
-    m->alloc_context_id = StackDepotPut(*stack);
+    if (sampled) {
+      m->cpu_id = GetCpuId();
+      m->timestamp_ms = GetTimestamp();
+      m->alloc_context_id = StackDepotPut(*stack);
 
-    uptr size_rounded_down_to_granularity =
-        RoundDownTo(size, SHADOW_GRANULARITY);
-    if (size_rounded_down_to_granularity)
-      ClearShadow(user_beg, size_rounded_down_to_granularity);
+      uptr size_rounded_down_to_granularity =
+          RoundDownTo(size, SHADOW_GRANULARITY);
+      if (size_rounded_down_to_granularity)
+        ClearShadow(user_beg, size_rounded_down_to_granularity);
+    }
 
     MemprofStats &thread_stats = GetCurrentThreadStats();
     thread_stats.mallocs++;
@@ -516,7 +622,7 @@ struct Allocator {
     u64 user_requested_size =
         atomic_exchange(&m->user_requested_size, 0, memory_order_acquire);
     if (memprof_inited && atomic_load_relaxed(&constructed) &&
-        !atomic_load_relaxed(&destructing)) {
+        !atomic_load_relaxed(&destructing) && !m->not_sampled) {
       MemInfoBlock newMIB = this->CreateNewMIB(p, m, user_requested_size);
       InsertOrMerge(m->alloc_context_id, newMIB, MIBMap);
     }
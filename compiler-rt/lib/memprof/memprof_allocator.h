@@ -74,6 +74,9 @@ using AllocatorCache = MemprofAllocator::AllocatorCache;
 
 struct MemprofThreadLocalMallocStorage {
   AllocatorCache allocator_cache;
+  // Heap sampling state for flags()->sample_interval.
+  uptr bytes_until_sample;
+  u64 sample_rand_state;
   void CommitBack();
 
 private:
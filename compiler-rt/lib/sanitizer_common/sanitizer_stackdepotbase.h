@@ -25,12 +25,11 @@ namespace __sanitizer {
 template <class Node, int kReservedBits, int kTabSizeLog>
 class StackDepotBase {
   static constexpr u32 kIdSizeLog =
-      sizeof(u32) * 8 - Max(kReservedBits, 1 /* At least 1 bit for locking. */);
+      sizeof(u32) * 8 - Max(kReservedBits, 1 /* At least 1 reserved bit. */);
   static constexpr u32 kNodesSize1Log = kIdSizeLog / 2;
   static constexpr u32 kNodesSize2Log = kIdSizeLog - kNodesSize1Log;
   static constexpr int kTabSize = 1 << kTabSizeLog;  // Hash table size.
   static constexpr u32 kUnlockMask = (1ull << kIdSizeLog) - 1;
-  static constexpr u32 kLockMask = ~kUnlockMask;
 
  public:
   typedef typename Node::args_type args_type;
@@ -63,9 +62,7 @@ class StackDepotBase {
 
  private:
   friend Node;
-  u32 find(u32 s, args_type args, hash_type hash) const;
-  static u32 lock(atomic_uint32_t *p);
-  static void unlock(atomic_uint32_t *p, u32 s);
+  u32 find(u32 s, args_type args, hash_type hash, u32 until = 0) const;
   atomic_uint32_t tab[kTabSize];  // Hash table of Node's.
 
   atomic_uint32_t n_uniq_ids;
@@ -77,9 +74,11 @@ class StackDepotBase {
 
 template <class Node, int kReservedBits, int kTabSizeLog>
 u32 StackDepotBase<Node, kReservedBits, kTabSizeLog>::find(
-    u32 s, args_type args, hash_type hash) const {
-  // Searches linked list s for the stack, returns its id.
-  for (; s;) {
+    u32 s, args_type args, hash_type hash, u32 until) const {
+  // Searches linked list s for the stack, returns its id. Stops at node
+  // `until`, which callers pass when the rest of the list is known not to
+  // contain the stack.
+  for (; s && s != until;) {
     const Node &node = nodes[s];
     if (node.eq(hash, args))
       return s;
@@ -88,29 +87,6 @@ u32 StackDepotBase<Node, kReservedBits, kTabSizeLog>::find(
   return 0;
 }
 
-template <class Node, int kReservedBits, int kTabSizeLog>
-u32 StackDepotBase<Node, kReservedBits, kTabSizeLog>::lock(atomic_uint32_t *p) {
-  // Uses the pointer lsb as mutex.
-  for (int i = 0;; i++) {
-    u32 cmp = atomic_load(p, memory_order_relaxed);
-    if ((cmp & kLockMask) == 0 &&
-        atomic_compare_exchange_weak(p, &cmp, cmp | kLockMask,
-                                     memory_order_acquire))
-      return cmp;
-    if (i < 10)
-      proc_yield(10);
-    else
-      internal_sched_yield();
-  }
-}
-
-template <class Node, int kReservedBits, int kTabSizeLog>
-void StackDepotBase<Node, kReservedBits, kTabSizeLog>::unlock(
-    atomic_uint32_t *p, u32 s) {
-  DCHECK_EQ(s & kLockMask, 0);
-  atomic_store(p, s, memory_order_release);
-}
-
 template <class Node, int kReservedBits, int kTabSizeLog>
 u32 StackDepotBase<Node, kReservedBits, kTabSizeLog>::Put(args_type args,
                                                           bool *inserted) {
@@ -127,24 +103,31 @@ u32 StackDepotBase<Node, kReservedBits, kTabSizeLog>::Put(args_type args,
   if (LIKELY(node))
     return node;
 
-  // If failed, lock, retry and insert new.
-  u32 s2 = lock(p);
-  if (s2 != s) {
-    node = find(s2, args, h);
-    if (node) {
-      unlock(p, s2);
-      return node;
+  // If failed, store a new node and publish it by swapping it in as the list
+  // head. Storing happens without holding any lock, so threads inserting into
+  // the same bucket, or storing large traces, don't wait on each other.
+  u32 id = atomic_fetch_add(&n_uniq_ids, 1, memory_order_relaxed) + 1;
+  CHECK_EQ(id & kUnlockMask, id);
+  CHECK_EQ(id & (((u32)-1) >> kReservedBits), id);
+  Node &new_node = nodes[id];
+  new_node.store(id, args, h);
+  for (;;) {
+    new_node.link = s;
+    if (atomic_compare_exchange_weak(p, &v, id, memory_order_release))
+      break;
+    // Another thread changed the list. Only the nodes it added in front of
+    // the previous head can be the same stack. If one is, it wins and our
+    // node is dropped; its id is simply never handed out.
+    u32 s2 = v & kUnlockMask;
+    if (s2 != s) {
+      node = find(s2, args, h, s);
+      if (node)
+        return node;
+      s = s2;
     }
   }
-  s = atomic_fetch_add(&n_uniq_ids, 1, memory_order_relaxed) + 1;
-  CHECK_EQ(s & kUnlockMask, s);
-  CHECK_EQ(s & (((u32)-1) >> kReservedBits), s);
-  Node &new_node = nodes[s];
-  new_node.store(s, args, h);
-  new_node.link = s2;
-  unlock(p, s);
   if (inserted) *inserted = true;
-  return s;
+  return id;
 }
 
 template <class Node, int kReservedBits, int kTabSizeLog>
@@ -161,13 +144,10 @@ StackDepotBase<Node, kReservedBits, kTabSizeLog>::Get(u32 id) {
 
 template <class Node, int kReservedBits, int kTabSizeLog>
 void StackDepotBase<Node, kReservedBits, kTabSizeLog>::LockBeforeFork() {
-  // Do not lock hash table. It's very expensive, but it's not rely needed. The
-  // parent process will neither lock nor unlock. Child process risks to be
-  // deadlocked on already locked buckets. To avoid deadlock we will unlock
-  // every locked buckets in `UnlockAfterFork`. This may affect consistency of
-  // the hash table, but the only issue is a few items inserted by parent
-  // process will be not found by child, and the child may insert them again,
-  // wasting some space in `stackStore`.
+  // The hash table has no locks. A node that another thread of the parent
+  // process was in the middle of inserting is simply never published in the
+  // child, which may insert the same stack again, wasting some space in
+  // `stackStore`.
 
   // We still need to lock nodes.
   nodes.Lock();
@@ -177,17 +157,6 @@ template <class Node, int kReservedBits, int kTabSizeLog>
 void StackDepotBase<Node, kReservedBits, kTabSizeLog>::UnlockAfterFork(
     bool fork_child) {
   nodes.Unlock();
-
-  // Only unlock in child process to avoid deadlock. See `LockBeforeFork`.
-  if (!fork_child)
-    return;
-
-  for (int i = 0; i < kTabSize; ++i) {
-    atomic_uint32_t *p = &tab[i];
-    uptr s = atomic_load(p, memory_order_relaxed);
-    if (s & kLockMask)
-      unlock(p, s & kUnlockMask);
-  }
 }
 
 template <class Node, int kReservedBits, int kTabSizeLog>
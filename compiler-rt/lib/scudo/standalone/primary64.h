@@ -144,6 +144,7 @@ private:
   static const uptr RegionSize = 1UL << RegionSizeLog;
   static const uptr NumClasses = SizeClassMap::NumClasses;
   static const uptr MapSizeIncrement = Config::getMapSizeIncrement();
+  static const uptr HugePageSizeLog = Config::getHugePageSizeLog();
   // Fill at most this number of batches from the newly map'd memory.
   static const u32 MaxNumBatches = SCUDO_ANDROID ? 4U : 8U;
 
@@ -714,7 +715,8 @@ u16 SizeClassAllocator64<Config>::populateFreeListAndPopBlocks(
     if (UNLIKELY(!Region->MemMapInfo.MemMap.remap(
             RegionBeg + MappedUser, MapSize, "scudo:primary",
             MAP_ALLOWNOMEM | MAP_RESIZABLE |
-                (useMemoryTagging<Config>(Options.load()) ? MAP_MEMTAG : 0)))) {
+                (useMemoryTagging<Config>(Options.load()) ? MAP_MEMTAG : 0) |
+                (HugePageSizeLog ? MAP_HUGEPAGE : 0)))) {
       return 0U;
     }
     Region->MemMapInfo.MappedUser += MapSize;
@@ -1459,9 +1461,9 @@ uptr SizeClassAllocator64<Config>::releaseToOSMaybe(RegionInfo *Region,
   // ==================================================================== //
   // 4. Release the unused physical pages back to the OS.
   // ==================================================================== //
-  RegionReleaseRecorder<MemMapT> Recorder(&Region->MemMapInfo.MemMap,
-                                          Region->RegionBeg,
-                                          Context.getReleaseOffset());
+  RegionReleaseRecorder<MemMapT> Recorder(
+      &Region->MemMapInfo.MemMap, Region->RegionBeg, Context.getReleaseOffset(),
+      HugePageSizeLog ? (1UL << HugePageSizeLog) : 0);
   auto SkipRegion = [](UNUSED uptr RegionIndex) { return false; };
   releaseFreeMemoryToOS(Context, Recorder, SkipRegion);
   if (Recorder.getReleasedBytes() > 0) {
@@ -19,18 +19,29 @@ namespace scudo {
 
 template <typename MemMapT> class RegionReleaseRecorder {
 public:
-  RegionReleaseRecorder(MemMapT *RegionMemMap, uptr Base, uptr Offset = 0)
-      : RegionMemMap(RegionMemMap), Base(Base), Offset(Offset) {}
+  RegionReleaseRecorder(MemMapT *RegionMemMap, uptr Base, uptr Offset = 0,
+                        uptr Granularity = 0)
+      : RegionMemMap(RegionMemMap), Base(Base), Offset(Offset),
+        Granularity(Granularity) {}
 
   uptr getReleasedBytes() const { return ReleasedBytes; }
 
   uptr getBase() const { return Base; }
 
   // Releases [From, To) range of pages back to OS. Note that `From` and `To`
-  // are offseted from `Base` + Offset.
+  // are offseted from `Base` + Offset. With a `Granularity`, only the aligned
+  // chunks of that size entirely within the range are released.
   void releasePageRangeToOS(uptr From, uptr To) {
-    const uptr Size = To - From;
-    RegionMemMap->releasePagesToOS(getBase() + Offset + From, Size);
+    uptr Beg = getBase() + Offset + From;
+    uptr End = getBase() + Offset + To;
+    if (Granularity) {
+      Beg = roundUp(Beg, Granularity);
+      End = roundDown(End, Granularity);
+      if (Beg >= End)
+        return;
+    }
+    const uptr Size = End - Beg;
+    RegionMemMap->releasePagesToOS(Beg, Size);
     ReleasedBytes += Size;
   }
 
@@ -41,6 +52,7 @@ private:
   // The release offset from Base. This is used when we know a given range after
   // Base will not be released.
   uptr Offset = 0;
+  uptr Granularity = 0;
 };
 
 class ReleaseRecorder {
@@ -69,6 +69,11 @@ TEST(ScudoCommonTest, SKIP_ON_FUCHSIA(ResidentMemorySize)) {
   MemMap.unmap();
 }
 
+// Fuchsia does not expose the current CPU.
+TEST(ScudoCommonTest, SKIP_ON_FUCHSIA(CurrentCPU)) {
+  EXPECT_GE(getCurrentCPU(), 0);
+}
+
 TEST(ScudoCommonTest, Zeros) {
   const uptr Size = 1ull << 20;
 
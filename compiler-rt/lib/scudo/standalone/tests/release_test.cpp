@@ -17,6 +17,8 @@
 #include <algorithm>
 #include <random>
 #include <set>
+#include <utility>
+#include <vector>
 
 TEST(ScudoReleaseTest, RegionPageMap) {
   for (scudo::uptr I = 0; I < SCUDO_WORDSIZE; I++) {
@@ -626,6 +628,35 @@ TEST(ScudoReleaseTest, RangeReleaseRegionWithSingleBlock) {
   testReleaseRangeWithSingleBlock<scudo::FuchsiaSizeClassMap>();
 }
 
+// Stands in for a MemMap, recording the ranges the recorder releases.
+class ReleasedRangesMemMap {
+public:
+  void releasePagesToOS(scudo::uptr From, scudo::uptr Size) {
+    Ranges.push_back({From, From + Size});
+  }
+  std::vector<std::pair<scudo::uptr, scudo::uptr>> Ranges;
+};
+
+TEST(ScudoReleaseTest, RegionReleaseRecorderGranularity) {
+  constexpr scudo::uptr Granularity = 1UL << 21;
+  constexpr scudo::uptr Base = 16 * Granularity;
+  constexpr scudo::uptr Offset = 4096;
+  ReleasedRangesMemMap MemMap;
+  scudo::RegionReleaseRecorder<ReleasedRangesMemMap> Recorder(
+      &MemMap, Base, Offset, Granularity);
+
+  // Smaller than a granule: nothing is released.
+  Recorder.releasePageRangeToOS(0, Granularity / 2);
+  EXPECT_TRUE(MemMap.Ranges.empty());
+  // Only the granules entirely within the range are released.
+  Recorder.releasePageRangeToOS(Granularity - Offset - 4096,
+                                4 * Granularity - Offset + 4096);
+  ASSERT_EQ(MemMap.Ranges.size(), 1U);
+  EXPECT_EQ(MemMap.Ranges[0].first, Base + Granularity);
+  EXPECT_EQ(MemMap.Ranges[0].second, Base + 4 * Granularity);
+  EXPECT_EQ(Recorder.getReleasedBytes(), 3 * Granularity);
+}
+
 TEST(ScudoReleaseTest, BufferPool) {
   constexpr scudo::uptr StaticBufferCount = SCUDO_WORDSIZE - 1;
   constexpr scudo::uptr StaticBufferNumElements = 512U;
@@ -224,6 +224,20 @@ private:
       Inc = CoPrimes[R % NumberOfCoPrimes];
     }
     if (N > 1U) {
+      // The current CPU's TSD is only a hint. The CPU can change right after
+      // we read it, and a thread preempted while holding a TSD still holds
+      // it, so tryLock is what makes the TSD ours and a failure falls back to
+      // the random probing below. When it succeeds, and with as many TSDs as
+      // CPUs, the threads of a CPU mostly share that CPU's cache, without the
+      // memory cost of one TSD per thread.
+      const s32 CPU = getCurrentCPU();
+      if (CPU >= 0) {
+        TSD<Allocator> *CPUTSD = &TSDs[static_cast<u32>(CPU) % N];
+        if (CPUTSD != CurrentTSD && CPUTSD->tryLock()) {
+          setCurrentTSD(CPUTSD);
+          return CPUTSD;
+        }
+      }
       u32 Index = R % N;
       uptr LowestPrecedence = UINTPTR_MAX;
       TSD<Allocator> *CandidateTSD = nullptr;
@@ -0,0 +1,77 @@
+// Mini-benchmark for tsan slot contention with many running threads.
+// Idea:
+// 1) Spawn N threads, all of which stay alive for the whole run
+// 2) Every thread does many sync operations, each on its own mutex
+//
+// The tsan runtime has a fixed number of slots (kThreadSlotCount, 256), used
+// to assign epochs to running threads. Once more threads than slots are
+// running, threads start preempting each other's slots and have to go through
+// the global slot mutex to re-attach, so the run time is expected to grow much
+// faster than linearly once N exceeds the slot count, even though the threads
+// never share any data.
+//
+// Usage: slots_many_threads_bench [n_threads [n_iterations]]
+// Compare e.g. n_threads=128, 256, 512 and 1024.
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+class __attribute__((aligned(64))) Mutex {
+ public:
+  Mutex()  { pthread_mutex_init(&m_, NULL); }
+  ~Mutex() { pthread_mutex_destroy(&m_); }
+  void Lock() { pthread_mutex_lock(&m_); }
+  void Unlock() { pthread_mutex_unlock(&m_); }
+
+ private:
+  pthread_mutex_t m_;
+};
+
+int n_threads, n_iterations;
+Mutex *mutexes;
+
+pthread_barrier_t all_threads_ready;
+
+void *Thread(void *arg) {
+  long idx = (long)arg;
+  pthread_barrier_wait(&all_threads_ready);
+  for (int i = 0; i < n_iterations; i++) {
+    mutexes[idx].Lock();
+    mutexes[idx].Unlock();
+  }
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  n_threads = 512;
+  n_iterations = 100000;
+  if (argc > 3) {
+    printf("Usage: %s [n_threads [n_iterations]]\n", argv[0]);
+    return 1;
+  }
+  if (argc > 1)
+    n_threads = atoi(argv[1]);
+  if (argc > 2)
+    n_iterations = atoi(argv[2]);
+  assert(n_threads > 0 && n_iterations > 0);
+  printf("%s: n_threads=%d n_iterations=%d\n", __FILE__, n_threads,
+         n_iterations);
+
+  mutexes = new Mutex[n_threads];
+  pthread_barrier_init(&all_threads_ready, NULL, n_threads);
+
+  pthread_t *t = new pthread_t[n_threads];
+  for (int i = 0; i < n_threads; i++) {
+    int status = pthread_create(&t[i], 0, Thread, (void *)(long)i);
+    assert(status == 0);
+  }
+  for (int i = 0; i < n_threads; i++)
+    pthread_join(t[i], 0);
+
+  pthread_barrier_destroy(&all_threads_ready);
+  delete[] t;
+  delete[] mutexes;
+  return 0;
+}
@@ -53,6 +53,24 @@ TEST(BufferQueueTest, GetUntilFailed) {
   EXPECT_EQ(Buffers.releaseBuffer(Buf0), BufferQueue::ErrorCode::Ok);
 }
 
+TEST(BufferQueueTest, ReleaseWithNoBufferOutstanding) {
+  bool Success = false;
+  BufferQueue Buffers(kSize, 1, Success);
+  ASSERT_TRUE(Success);
+  BufferQueue::Buffer Buf;
+  ASSERT_EQ(Buffers.getBuffer(Buf), BufferQueue::ErrorCode::Ok);
+  BufferQueue::Buffer Copy = Buf;
+  ASSERT_EQ(Buffers.releaseBuffer(Buf), BufferQueue::ErrorCode::Ok);
+
+  // The only buffer is back in the queue, so the copy is not taken in.
+  ASSERT_EQ(Buffers.releaseBuffer(Copy), BufferQueue::ErrorCode::Ok);
+  ASSERT_EQ(nullptr, Copy.Data);
+  ASSERT_EQ(Buffers.getBuffer(Buf), BufferQueue::ErrorCode::Ok);
+  BufferQueue::Buffer Other;
+  EXPECT_EQ(Buffers.getBuffer(Other), BufferQueue::ErrorCode::NotEnoughMemory);
+  EXPECT_EQ(Buffers.releaseBuffer(Buf), BufferQueue::ErrorCode::Ok);
+}
+
 TEST(BufferQueueTest, ReleaseUnknown) {
   bool Success = false;
   BufferQueue Buffers(kSize, 1, Success);
@@ -106,6 +124,42 @@ TEST(BufferQueueTest, MultiThreaded) {
   F();
 }
 
+TEST(BufferQueueTest, ExclusiveOwnershipAcrossThreads) {
+  bool Success = false;
+  BufferQueue Buffers(kSize, 4, Success);
+  ASSERT_TRUE(Success);
+  std::atomic<int> Failures{0};
+
+  // Each thread tags the buffers it holds; nobody else may write to a buffer
+  // until it has been released again.
+  auto F = [&](unsigned char Tag) {
+    for (int I = 0; I < 10000; ++I) {
+      BufferQueue::Buffer B;
+      if (Buffers.getBuffer(B) != BufferQueue::ErrorCode::Ok)
+        continue;
+      auto *Data = static_cast<unsigned char *>(B.Data);
+      Data[0] = Tag;
+      std::this_thread::yield();
+      if (Data[0] != Tag)
+        Failures.fetch_add(1, std::memory_order_relaxed);
+      Buffers.releaseBuffer(B);
+    }
+  };
+  std::thread T[8];
+  for (int I = 0; I < 8; ++I)
+    T[I] = std::thread(F, I + 1);
+  for (auto &Thread : T)
+    Thread.join();
+  EXPECT_EQ(Failures.load(), 0);
+
+  // All buffers must be available again.
+  BufferQueue::Buffer B[4];
+  for (auto &Buf : B)
+    EXPECT_EQ(Buffers.getBuffer(Buf), BufferQueue::ErrorCode::Ok);
+  for (auto &Buf : B)
+    EXPECT_EQ(Buffers.releaseBuffer(Buf), BufferQueue::ErrorCode::Ok);
+}
+
 TEST(BufferQueueTest, Apply) {
   bool Success = false;
   BufferQueue Buffers(kSize, 10, Success);
@@ -132,11 +132,12 @@ BufferQueue::ErrorCode BufferQueue::init(size_t BS, size_t BC) {
     Buf.ExtentsBackingStore = ExtentsBackingStore;
     Buf.Count = BufferCount;
     T.Used = false;
+    // Every entry starts out holding an available buffer.
+    atomic_store(&T.Sequence, 2 * i + 1, memory_order_relaxed);
   }
 
-  Next = Buffers;
-  First = Buffers;
-  LiveBuffers = 0;
+  atomic_store(&Next, 0, memory_order_relaxed);
+  atomic_store(&First, BufferCount, memory_order_relaxed);
   atomic_store(&Finalizing, 0, memory_order_release);
   Success = true;
   return BufferQueue::ErrorCode::Ok;
@@ -151,9 +152,9 @@ BufferQueue::BufferQueue(size_t B, size_t N,
       BackingStore(nullptr),
       ExtentsBackingStore(nullptr),
       Buffers(nullptr),
-      Next(Buffers),
-      First(Buffers),
-      LiveBuffers(0),
+      Next{0},
+      First{0},
+      UnlockedReleases{0},
       Generation{0} {
   Success = init(B, N) == BufferQueue::ErrorCode::Ok;
 }
@@ -162,15 +163,22 @@ BufferQueue::ErrorCode BufferQueue::getBuffer(Buffer &Buf) {
   if (atomic_load(&Finalizing, memory_order_acquire))
     return ErrorCode::QueueFinalizing;
 
+  // Claim the entry at the head of the ring, unless it has not been refilled
+  // by a releaseBuffer yet, in which case all buffers are handed out.
   BufferRep *B = nullptr;
-  {
-    SpinMutexLock Guard(&Mutex);
-    if (LiveBuffers == BufferCount)
+  atomic_uint64_t::Type Pos = atomic_load(&Next, memory_order_relaxed);
+  for (;;) {
+    B = &Buffers[Pos % BufferCount];
+    auto Seq = atomic_load(&B->Sequence, memory_order_acquire);
+    if (Seq == 2 * Pos + 1) {
+      if (atomic_compare_exchange_weak(&Next, &Pos, Pos + 1,
+                                       memory_order_relaxed))
+        break;
+    } else if (static_cast<int64_t>(Seq - (2 * Pos + 1)) < 0) {
       return ErrorCode::NotEnoughMemory;
-    B = Next++;
-    if (Next == (Buffers + BufferCount))
-      Next = Buffers;
-    ++LiveBuffers;
+    } else {
+      Pos = atomic_load(&Next, memory_order_relaxed);
+    }
   }
 
   incRefCount(BackingStore);
@@ -178,30 +186,48 @@ BufferQueue::ErrorCode BufferQueue::getBuffer(Buffer &Buf) {
   Buf = B->Buff;
   Buf.Generation = generation();
   B->Used = true;
+  // Hand the entry over to the releaseBuffer that will reach it next.
+  atomic_store(&B->Sequence, 2 * (Pos + BufferCount), memory_order_release);
   return ErrorCode::Ok;
 }
 
-BufferQueue::ErrorCode BufferQueue::releaseBuffer(Buffer &Buf) {
+BufferQueue::ErrorCode BufferQueue::pushBuffer(Buffer &Buf) {
+  if (Buf.Generation != generation()) {
+    Buf = {};
+    decRefCount(Buf.BackingStore, Buf.Size, Buf.Count);
+    decRefCount(Buf.ExtentsBackingStore, kExtentsSize, Buf.Count);
+    return BufferQueue::ErrorCode::Ok;
+  }
+
   // Check whether the buffer being referred to is within the bounds of the
   // backing store's range.
+  if (Buf.Data < &BackingStore->Data ||
+      Buf.Data > &BackingStore->Data + (BufferCount * BufferSize))
+    return BufferQueue::ErrorCode::UnrecognizedBuffer;
+
   BufferRep *B = nullptr;
-  {
-    SpinMutexLock Guard(&Mutex);
-    if (Buf.Generation != generation() || LiveBuffers == 0) {
-      Buf = {};
-      decRefCount(Buf.BackingStore, Buf.Size, Buf.Count);
-      decRefCount(Buf.ExtentsBackingStore, kExtentsSize, Buf.Count);
-      return BufferQueue::ErrorCode::Ok;
+  atomic_uint64_t::Type Pos = atomic_load(&First, memory_order_relaxed);
+  for (;;) {
+    B = &Buffers[Pos % BufferCount];
+    auto Seq = atomic_load(&B->Sequence, memory_order_acquire);
+    if (Seq == 2 * Pos) {
+      if (atomic_compare_exchange_weak(&First, &Pos, Pos + 1,
+                                       memory_order_relaxed))
+        break;
+    } else if (static_cast<int64_t>(Seq - 2 * Pos) < 0) {
+      // The entry has not been handed over by getBuffer yet. If getBuffer has
+      // already claimed the matching position it is about to do so, so wait
+      // for it; otherwise no buffer is handed out and this one can't be ours.
+      auto Claimed = atomic_load(&Next, memory_order_acquire);
+      if (static_cast<int64_t>(Claimed - (Pos - BufferCount)) <= 0) {
+        Buf = {};
+        return BufferQueue::ErrorCode::Ok;
+      }
+      proc_yield(1);
+      Pos = atomic_load(&First, memory_order_relaxed);
+    } else {
+      Pos = atomic_load(&First, memory_order_relaxed);
     }
-
-    if (Buf.Data < &BackingStore->Data ||
-        Buf.Data > &BackingStore->Data + (BufferCount * BufferSize))
-      return BufferQueue::ErrorCode::UnrecognizedBuffer;
-
-    --LiveBuffers;
-    B = First++;
-    if (First == (Buffers + BufferCount))
-      First = Buffers;
   }
 
   // Now that the buffer has been released, we mark it as "used".
@@ -211,12 +237,31 @@ BufferQueue::ErrorCode BufferQueue::releaseBuffer(Buffer &Buf) {
   decRefCount(Buf.ExtentsBackingStore, kExtentsSize, Buf.Count);
   atomic_store(B->Buff.Extents, atomic_load(Buf.Extents, memory_order_acquire),
                memory_order_release);
+  // Make the entry available to getBuffer again.
+  atomic_store(&B->Sequence, 2 * Pos + 1, memory_order_release);
   Buf = {};
   return ErrorCode::Ok;
 }
 
+BufferQueue::ErrorCode BufferQueue::releaseBuffer(Buffer &Buf) {
+  // Once the queue is finalizing, apply() may be walking the entries, so the
+  // last releases serialize with it instead of racing on the entries. A
+  // release that started before finalize() is counted, and apply() waits for
+  // it; the sequentially consistent accesses here and in finalize() ensure
+  // that either the release sees the flag or apply() sees the count.
+  atomic_fetch_add(&UnlockedReleases, 1, memory_order_seq_cst);
+  if (atomic_load(&Finalizing, memory_order_seq_cst)) {
+    atomic_fetch_sub(&UnlockedReleases, 1, memory_order_release);
+    SpinMutexLock Guard(&Mutex);
+    return pushBuffer(Buf);
+  }
+  auto Result = pushBuffer(Buf);
+  atomic_fetch_sub(&UnlockedReleases, 1, memory_order_release);
+  return Result;
+}
+
 BufferQueue::ErrorCode BufferQueue::finalize() {
-  if (atomic_exchange(&Finalizing, 1, memory_order_acq_rel))
+  if (atomic_exchange(&Finalizing, 1, memory_order_seq_cst))
     return ErrorCode::QueueFinalizing;
   return ErrorCode::Ok;
 }
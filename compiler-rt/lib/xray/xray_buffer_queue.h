@@ -30,6 +30,15 @@ namespace __xray {
 /// trace collection.
 class BufferQueue {
 public:
+  enum class ErrorCode : unsigned {
+    Ok,
+    NotEnoughMemory,
+    QueueFinalizing,
+    UnrecognizedBuffer,
+    AlreadyFinalized,
+    AlreadyInitialized,
+  };
+
   /// ControlBlock represents the memory layout of how we interpret the backing
   /// store for all buffers and extents managed by a BufferQueue instance. The
   /// ControlBlock has the reference count as the first member, sized according
@@ -71,6 +80,13 @@ public:
     // This is true if the buffer has been returned to the available queue, and
     // is considered "used" by another thread.
     bool Used = false;
+
+    // Position in the ring this entry is ready for, times two. The entry holds
+    // an available buffer for the getBuffer at position P when this is
+    // 2 * P + 1, and is free to receive a released buffer for the
+    // releaseBuffer at position P when it is 2 * P. Keeping the two states
+    // apart by parity keeps them distinct even with a single buffer.
+    atomic_uint64_t Sequence;
   };
 
 private:
@@ -149,33 +165,31 @@ private:
   // A dynamically allocated array of BufferRep instances.
   BufferRep *Buffers;
 
-  // Pointer to the next buffer to be handed out.
-  BufferRep *Next;
+  // Ever-increasing position of the next buffer to be handed out. The entry
+  // in the array is at the position modulo BufferCount.
+  alignas(kCacheLineSize) atomic_uint64_t Next;
 
-  // Pointer to the entry in the array where the next released buffer will be
-  // placed.
-  BufferRep *First;
+  // Ever-increasing position of the entry in the array where the next released
+  // buffer will be placed.
+  alignas(kCacheLineSize) atomic_uint64_t First;
 
-  // Count of buffers that have been handed out through 'getBuffer'.
-  size_t LiveBuffers;
+  // Number of releaseBuffer calls that are placing a buffer without holding
+  // the lock. apply() waits for these to finish once the queue is finalizing.
+  // Kept off the cache lines of First and Generation, which every release
+  // also touches.
+  alignas(kCacheLineSize) atomic_uint64_t UnlockedReleases;
 
   // We use a generation number to identify buffers and which generation they're
   // associated with.
-  atomic_uint64_t Generation;
+  alignas(kCacheLineSize) atomic_uint64_t Generation;
 
   /// Releases references to the buffers backed by the current buffer queue.
   void cleanupBuffers();
 
-public:
-  enum class ErrorCode : unsigned {
-    Ok,
-    NotEnoughMemory,
-    QueueFinalizing,
-    UnrecognizedBuffer,
-    AlreadyFinalized,
-    AlreadyInitialized,
-  };
+  /// Places |Buf| in the next free entry of the ring.
+  ErrorCode pushBuffer(Buffer &Buf);
 
+public:
   static const char *getErrorString(ErrorCode E) {
     switch (E) {
     case ErrorCode::Ok:
@@ -200,7 +214,8 @@ public:
 
   /// Updates |Buf| to contain the pointer to an appropriate buffer. Returns an
   /// error in case there are no available buffers to return when we will run
-  /// over the upper bound for the total buffers.
+  /// over the upper bound for the total buffers. Does not take the queue lock,
+  /// so threads getting and releasing buffers don't serialize on each other.
   ///
   /// Requirements:
   ///   - BufferQueue is not finalising.
@@ -221,7 +236,9 @@ public:
   ErrorCode releaseBuffer(Buffer &Buf);
 
   /// Initializes the buffer queue, starting a new generation. We can re-set the
-  /// size of buffers with |BS| along with the buffer count with |BC|.
+  /// size of buffers with |BS| along with the buffer count with |BC|. The
+  /// caller must ensure no getBuffer/releaseBuffer is still in flight from
+  /// before the queue was finalized.
   ///
   /// Returns:
   ///   - ErrorCode::Ok when we successfully initialize the buffer. This
@@ -254,6 +271,8 @@ public:
   /// releaseBuffer(...) operation).
   template <class F> void apply(F Fn) XRAY_NEVER_INSTRUMENT {
     SpinMutexLock G(&Mutex);
+    while (atomic_load(&UnlockedReleases, memory_order_seq_cst))
+      proc_yield(1);
     for (auto I = begin(), E = end(); I != E; ++I)
       Fn(*I);
   }
@@ -0,0 +1,21 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// A stateful target: it crashes once state from earlier inputs has built up,
+// which -isolate_inputs=1 must prevent.
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+static int NumInputs;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *Data, size_t Size) {
+  if (++NumInputs == 100) {
+    printf("STATE LEAKED\n");
+    fflush(stdout);
+    abort();
+  }
+  return 0;
+}
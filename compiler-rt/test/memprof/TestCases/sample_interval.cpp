@@ -0,0 +1,31 @@
+// Check that sample_interval profiles only a sample of the allocations, and
+// that the recorded MIB is scaled back to estimate all of them. The loop
+// allocates 80000 bytes in total; with one sample every 8000 bytes on average,
+// about 10 of its 10000 allocations are recorded. Each stands for
+// 1 / (1 - exp(-8 / 8000)) = 1000.5 allocations, rounded to 1001, so the
+// allocation count is a multiple K * 1001 and the average size stays 8.
+
+// RUN: %clangxx_memprof -O0 %s -o %t
+// RUN: %env_memprof_opts=print_text=true:log_path=stderr:print_terse=1 %run %t 2>&1 | FileCheck %s --check-prefix=ALL
+// RUN: %env_memprof_opts=print_text=true:log_path=stderr:print_terse=1:sample_interval=8000 %run %t 2>&1 | FileCheck %s --check-prefix=SAMPLED
+
+// ALL: MIB:[[STACKID:[0-9]+]]/10000/8.00/8/8/
+// ALL: Stack for id [[STACKID]]:
+// ALL-NEXT: #0 {{.*}} in {{.*}}malloc
+// ALL-NEXT: #1 {{.*}} in main {{.*}}:[[@LINE+11]]
+
+// SAMPLED: MIB:[[STACKID:[0-9]+]]/[[K:[1-9][0-9]?]]0{{0?}}[[K]]/8.00/8/8/
+// SAMPLED: Stack for id [[STACKID]]:
+// SAMPLED-NEXT: #0 {{.*}} in {{.*}}malloc
+// SAMPLED-NEXT: #1 {{.*}} in main {{.*}}:[[@LINE+6]]
+
+#include <stdlib.h>
+
+int main() {
+  for (int i = 0; i < 10000; i++) {
+    volatile char *p = (volatile char *)malloc(8);
+    p[0] = 1;
+    free((void *)p);
+  }
+  return 0;
+}
@@ -1296,7 +1296,13 @@ static bool FileContentsMatch(const std::string &path,
     const std::string &header, const std::string &contents) {
   std::size_t hsize{header.size()};
   std::size_t csize{contents.size()};
-  auto buf_or{llvm::MemoryBuffer::getFile(path)};
+  // A module file of a different size can't match; don't read it at all.
+  std::uint64_t fileSize{0};
+  if (llvm::sys::fs::file_size(path, fileSize) || fileSize != hsize + csize) {
+    return false;
+  }
+  auto buf_or{llvm::MemoryBuffer::getFile(
+      path, /*IsText=*/false, /*RequiresNullTerminator=*/false)};
   if (!buf_or) {
     return false;
   }
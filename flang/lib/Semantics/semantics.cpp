@@ -564,7 +564,7 @@ SourceName SemanticsContext::GetTempName(const Scope &scope) {
 }
 
 bool SemanticsContext::IsTempName(const std::string &name) {
-  return name.size() > 5 && name.substr(0, 5) == ".F18.";
+  return name.size() > 5 && name.compare(0, 5, ".F18.") == 0;
 }
 
 Scope *SemanticsContext::GetBuiltinModule(const char *name) {
@@ -517,8 +517,12 @@ RPC_ATTRS void Port<T>::recv_n(void **dst, uint64_t *size, A &&alloc) {
 /// port using the platform's returned value.
 template <uint32_t opcode> RPC_ATTRS Client::Port Client::open() {
   // Repeatedly perform a naive linear scan for a port that can be opened to
-  // send data.
-  for (uint32_t index = 0;; ++index) {
+  // send data. Each warp starts at a different port so that warps issuing
+  // requests at the same time don't all contend for the locks of the first
+  // ports and then queue up behind the same pending requests.
+  uint32_t start =
+      rpc::broadcast_value(rpc::get_lane_mask(), rpc::get_warp_id());
+  for (uint32_t index = start % process.port_count;; ++index) {
     // Start from the beginning if we run out of ports to check.
     if (index >= process.port_count)
       index = 0;
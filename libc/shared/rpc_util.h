@@ -219,6 +219,17 @@ RPC_ATTRS uint32_t get_lane_id() {
 #endif
 }
 
+/// Returns a number identifying the calling warp or wavefront within the grid.
+/// Only the first dimension is considered, so it need not be unique.
+RPC_ATTRS uint32_t get_warp_id() {
+#ifdef RPC_TARGET_IS_GPU
+  return (__gpu_block_id_x() * __gpu_num_threads_x() + __gpu_thread_id_x()) /
+         __gpu_num_lanes();
+#else
+  return 0;
+#endif
+}
+
 /// Conditional that is only true for a single thread in a lane.
 RPC_ATTRS bool is_first_lane([[maybe_unused]] uint64_t lane_mask) {
 #ifdef RPC_TARGET_IS_GPU
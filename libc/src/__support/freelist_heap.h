@@ -182,6 +182,25 @@ LIBC_INLINE void *FreeListHeap::realloc(void *ptr, size_t size) {
   if (old_size >= size)
     return ptr;
 
+  // Grow in place if the following block is free and large enough, which
+  // avoids the copy and keeps the freed block from fragmenting the heap.
+  Block *next = block->next();
+  if (!next->used() && size - old_size <= next->outer_size()) {
+    // While the block is marked free, its last word holds the prev_ field of
+    // the next block, so preserve the data stored there.
+    cpp::byte *last_word = bytes + old_size - sizeof(size_t);
+    size_t saved;
+    LIBC_NAMESPACE::inline_memcpy(&saved, last_word, sizeof(size_t));
+    free_store.remove(next);
+    block->mark_free();
+    block->merge_next();
+    if (optional<Block *> remainder = block->split(size))
+      free_store.insert(*remainder);
+    block->mark_used();
+    LIBC_NAMESPACE::inline_memcpy(last_word, &saved, sizeof(size_t));
+    return ptr;
+  }
+
   void *new_ptr = allocate(size);
   // Don't invalidate ptr if allocate(size) fails to initilize the memory.
   if (new_ptr == nullptr)
@@ -394,6 +394,17 @@ template <typename T, typename Fmt = radix::Dec> class IntegerToString {
     LIBC_INLINE static void
     write_unsigned_number_dec(UNSIGNED_T value,
                               details::BackwardStringBufferWriter &sink) {
+      if constexpr (cpp::is_integral_v<UNSIGNED_T>) {
+        // Peel off two digits per division of the full-width value; the
+        // split of the remaining pair only needs narrow arithmetic. This
+        // halves the number of wide divisions for printf's %d and %u.
+        while (sink.ok() && value >= 100) {
+          const uint8_t pair = static_cast<uint8_t>(value % 100);
+          value /= 100;
+          sink.push(digit_char(pair % 10));
+          sink.push(digit_char(pair / 10));
+        }
+      }
       while (sink.ok() && value != 0) {
         const uint8_t digit = extract_decimal_digit(value);
         sink.push(digit_char(digit));
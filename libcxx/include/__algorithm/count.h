@@ -12,14 +12,26 @@
 
 #include <__algorithm/iterator_operations.h>
 #include <__algorithm/min.h>
+#include <__algorithm/simd_utils.h>
+#include <__algorithm/unwrap_iter.h>
 #include <__bit/invert_if.h>
 #include <__bit/popcount.h>
 #include <__config>
+#include <__cstddef/ptrdiff_t.h>
+#include <__cstddef/size_t.h>
 #include <__functional/identity.h>
 #include <__fwd/bit_reference.h>
 #include <__iterator/iterator_traits.h>
 #include <__type_traits/enable_if.h>
 #include <__type_traits/invoke.h>
+#include <__type_traits/is_constant_evaluated.h>
+#include <__type_traits/is_equality_comparable.h>
+#include <__type_traits/is_integral.h>
+#include <__type_traits/is_same.h>
+#include <__type_traits/is_volatile.h>
+#include <__type_traits/remove_cv.h>
+#include <cstdint>
+#include <limits>
 
 #if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
 #  pragma GCC system_header
@@ -41,6 +53,55 @@ __count(_Iter __first, _Sent __last, const _Tp& __value, _Proj& __proj) {
   return __r;
 }
 
+#if _LIBCPP_VECTORIZE_ALGORITHMS
+template <class _Tp>
+[[__nodiscard__]] _LIBCPP_HIDE_FROM_ABI ptrdiff_t __count_vectorized(const _Tp* __first, const _Tp* __last, _Tp __value) {
+  constexpr size_t __vec_size = __native_vector_size<_Tp>;
+  using __vec                 = __simd_vector<_Tp, __vec_size>;
+  using __lane_type           = __get_as_integer_type_t<_Tp>;
+  using __lane_vec            = __simd_vector<__lane_type, __vec_size>;
+
+  ptrdiff_t __result = 0;
+  auto __values      = static_cast<__vec>(__value); // broadcast the value
+  while (static_cast<size_t>(__last - __first) >= __vec_size) {
+    // Count the matches in each lane for as many vectors as a lane can hold without wrapping around, then add up the
+    // lanes. A match compares as all ones, so subtracting it adds one to the lane.
+    size_t __iterations = std::min<size_t>((__last - __first) / __vec_size, numeric_limits<__lane_type>::max());
+    __lane_vec __counts{};
+    for (size_t __i = 0; __i != __iterations; ++__i, __first += __vec_size)
+      __counts -= __builtin_convertvector(std::__load_vector<__vec>(__first) == __values, __lane_vec);
+    __result += __builtin_reduce_add(__builtin_convertvector(__counts, __simd_vector<uint64_t, __vec_size>));
+  }
+
+  for (; __first != __last; ++__first)
+    if (*__first == __value)
+      ++__result;
+  return __result;
+}
+#endif
+
+// trivially equality comparable integral implementation
+template <class _AlgPolicy,
+          class _Tp,
+          class _Up,
+          class _Proj,
+          __enable_if_t<__is_identity<_Proj>::value && __libcpp_is_trivially_equality_comparable<_Tp, _Up>::value &&
+                            is_integral<_Tp>::value && !is_volatile<_Tp>::value &&
+                            !is_same<__remove_cv_t<_Tp>, bool>::value,
+                        int> = 0>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX20 ptrdiff_t
+__count(_Tp* __first, _Tp* __last, const _Up& __value, _Proj& __proj) {
+#if _LIBCPP_VECTORIZE_ALGORITHMS
+  if (!__libcpp_is_constant_evaluated())
+    return std::__count_vectorized<__remove_cv_t<_Tp> >(__first, __last, __value);
+#endif
+  ptrdiff_t __r = 0;
+  for (; __first != __last; ++__first)
+    if (std::__invoke(__proj, *__first) == __value)
+      ++__r;
+  return __r;
+}
+
 // __bit_iterator implementation
 template <bool _ToCount, class _Cp, bool _IsConst>
 _LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX20 typename __bit_iterator<_Cp, _IsConst>::difference_type
@@ -85,7 +146,7 @@ template <class _InputIterator, class _Tp>
 [[__nodiscard__]] inline _LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX20 __iterator_difference_type<_InputIterator>
 count(_InputIterator __first, _InputIterator __last, const _Tp& __value) {
   __identity __proj;
-  return std::__count<_ClassicAlgPolicy>(__first, __last, __value, __proj);
+  return std::__count<_ClassicAlgPolicy>(std::__unwrap_iter(__first), std::__unwrap_iter(__last), __value, __proj);
 }
 
 _LIBCPP_END_NAMESPACE_STD
@@ -11,6 +11,7 @@
 
 #include <__algorithm/count.h>
 #include <__algorithm/iterator_operations.h>
+#include <__algorithm/unwrap_range.h>
 #include <__config>
 #include <__functional/identity.h>
 #include <__functional/ranges_operations.h>
@@ -35,18 +36,29 @@ _LIBCPP_BEGIN_NAMESPACE_STD
 
 namespace ranges {
 struct __count {
+  template <class _Iter, class _Sent, class _Type, class _Proj>
+  _LIBCPP_HIDE_FROM_ABI static constexpr iter_difference_t<_Iter>
+  __count_unwrap(_Iter __first, _Sent __last, const _Type& __value, _Proj& __proj) {
+    if constexpr (forward_iterator<_Iter>) {
+      auto [__first_un, __last_un] = std::__unwrap_range(std::move(__first), std::move(__last));
+      return std::__count<_RangeAlgPolicy>(std::move(__first_un), std::move(__last_un), __value, __proj);
+    } else {
+      return std::__count<_RangeAlgPolicy>(std::move(__first), std::move(__last), __value, __proj);
+    }
+  }
+
   template <input_iterator _Iter, sentinel_for<_Iter> _Sent, class _Type, class _Proj = identity>
     requires indirect_binary_predicate<ranges::equal_to, projected<_Iter, _Proj>, const _Type*>
   [[nodiscard]] _LIBCPP_HIDE_FROM_ABI constexpr iter_difference_t<_Iter>
   operator()(_Iter __first, _Sent __last, const _Type& __value, _Proj __proj = {}) const {
-    return std::__count<_RangeAlgPolicy>(std::move(__first), std::move(__last), __value, __proj);
+    return __count_unwrap(std::move(__first), std::move(__last), __value, __proj);
   }
 
   template <input_range _Range, class _Type, class _Proj = identity>
     requires indirect_binary_predicate<ranges::equal_to, projected<iterator_t<_Range>, _Proj>, const _Type*>
   [[nodiscard]] _LIBCPP_HIDE_FROM_ABI constexpr range_difference_t<_Range>
   operator()(_Range&& __r, const _Type& __value, _Proj __proj = {}) const {
-    return std::__count<_RangeAlgPolicy>(ranges::begin(__r), ranges::end(__r), __value, __proj);
+    return __count_unwrap(ranges::begin(__r), ranges::end(__r), __value, __proj);
   }
 };
 
@@ -8,6 +8,8 @@
 
 #include <algorithm>
 #include <bit>
+#include <memory>
+#include <new>
 
 _LIBCPP_BEGIN_NAMESPACE_STD
 
@@ -16,6 +18,21 @@ void __sort(RandomAccessIterator first, RandomAccessIterator last, Comp comp) {
   if (first == last) // log(0) is undefined, so don't try computing the depth
     return;
 
+  using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+  if constexpr (__is_ordered_integer_representable_v<value_type>) {
+    // Within the same bounds that stable_sort uses, an LSD radix sort beats introsort on integral and floating-point
+    // keys. It needs a scratch buffer as large as the input; if that can't be had fall back to introsort, since sort
+    // isn't allowed to fail.
+    auto len = static_cast<size_t>(last - first);
+    if (len >= std::__radix_sort_min_bound<value_type>() && len <= std::__radix_sort_max_bound<value_type>()) {
+      unique_ptr<value_type[]> buffer(new (nothrow) value_type[len]);
+      if (buffer) {
+        std::__radix_sort(first, last, buffer.get());
+        return;
+      }
+    }
+  }
+
   auto depth_limit = 2 * std::__bit_log2(static_cast<size_t>(last - first));
 
   // Only use bitset partitioning for arithmetic types.  We should also check
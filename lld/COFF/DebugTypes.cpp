@@ -1136,11 +1136,28 @@ void TypeMerger::mergeTypesWithGHash() {
   // - item records
   //   - source 0, type 1...
   //   - source 1, type 0...
-  std::vector<GHashCell> entries;
-  for (const GHashCell &cell : ArrayRef(ghashState.table.table, tableSize)) {
-    if (!cell.isEmpty())
-      entries.push_back(cell);
-  }
+  //
+  // The table is scanned in parallel: count the non-empty cells of each chunk,
+  // then copy each chunk's cells to its own range of the output.
+  constexpr size_t cellsPerChunk = 1 << 16;
+  size_t numChunks = divideCeil(tableSize, cellsPerChunk);
+  auto getChunk = [&](size_t chunkIdx) {
+    return ArrayRef(ghashState.table.table, tableSize)
+        .slice(chunkIdx * cellsPerChunk)
+        .take_front(cellsPerChunk);
+  };
+  auto isNonEmpty = [](const GHashCell &cell) { return !cell.isEmpty(); };
+  std::vector<size_t> chunkOffsets(numChunks + 1);
+  parallelFor(0, numChunks, [&](size_t chunkIdx) {
+    chunkOffsets[chunkIdx + 1] = llvm::count_if(getChunk(chunkIdx), isNonEmpty);
+  });
+  for (size_t chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx)
+    chunkOffsets[chunkIdx + 1] += chunkOffsets[chunkIdx];
+  std::vector<GHashCell> entries(chunkOffsets[numChunks]);
+  parallelFor(0, numChunks, [&](size_t chunkIdx) {
+    llvm::copy_if(getChunk(chunkIdx), entries.begin() + chunkOffsets[chunkIdx],
+                  isNonEmpty);
+  });
   parallelSort(entries, std::less<GHashCell>());
   Log(ctx) << formatv(
       "ghash table load factor: {0:p} (size {1} / capacity {2})\n",
@@ -1161,20 +1178,21 @@ void TypeMerger::mergeTypesWithGHash() {
   // merging will skip indices not on this list. Store the destination PDB type
   // index for these unique types in the tpiMap for each source. The entries for
   // non-unique types will be filled in prior to type merging.
-  for (uint32_t i = 0, e = entries.size(); i < e; ++i) {
-    auto &cell = entries[i];
-    uint32_t tpiSrcIdx = cell.getTpiSrcIdx();
-    TpiSource *source = ctx.tpiSourceList[tpiSrcIdx];
-    source->uniqueTypes.push_back(cell.getGHashIdx());
-
-    // Update the ghash table to store the destination PDB type index in the
-    // table.
+  for (const GHashCell &cell : entries)
+    ctx.tpiSourceList[cell.getTpiSrcIdx()]->uniqueTypes.push_back(
+        cell.getGHashIdx());
+
+  // Update the ghash table to store the destination PDB type index in the
+  // table. Every entry owns a distinct cell, so this can be done in parallel.
+  parallelFor(0, entries.size(), [&](size_t i) {
+    const GHashCell &cell = entries[i];
+    TpiSource *source = ctx.tpiSourceList[cell.getTpiSrcIdx()];
     uint32_t pdbTypeIndex = i < numTypes ? i : i - numTypes;
     uint32_t ghashCellIndex =
         source->indexMapStorage[cell.getGHashIdx()].toArrayIndex();
     ghashState.table.table[ghashCellIndex] =
         GHashCell(cell.isItem(), cell.getTpiSrcIdx(), pdbTypeIndex);
-  }
+  });
 
   // In parallel, remap all types.
   for (TpiSource *source : dependencySources)
@@ -24,11 +24,16 @@ class InputSectionBase;
 /// Run Balanced Partitioning to find the optimal function and data order to
 /// improve startup time and compressed size.
 ///
+/// Startup traces come from either a temporal instrumented profile
+/// (\p profilePath) or a text file listing one symbol per line in order of
+/// first execution, with traces separated by empty lines (\p startupTracePath).
+///
 /// It is important that -ffunction-sections and -fdata-sections compiler flags
 /// are used to ensure functions and data are in their own sections and thus
 /// can be reordered.
 llvm::DenseMap<const InputSectionBase *, int>
 runBalancedPartitioning(Ctx &ctx, llvm::StringRef profilePath,
+                        llvm::StringRef startupTracePath,
                         bool forFunctionCompression, bool forDataCompression,
                         bool compressionSortStartupFunctions, bool verbose);
 
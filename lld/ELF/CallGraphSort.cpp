@@ -322,6 +322,13 @@ computeCacheDirectedSortOrder(Ctx &ctx) {
     funcCounts[to] += weight;
   }
 
+  // Entry counts from the PGO analysis map also cover calls that are missing
+  // from the call graph profile, such as indirect calls.
+  for (auto [sec, count] : ctx.arg.functionEntryCounts) {
+    size_t node = getOrCreateNode(sec);
+    funcCounts[node] = std::max(funcCounts[node], count);
+  }
+
   // Run the layout algorithm.
   std::vector<uint64_t> sortedSections = codelayout::computeCacheDirectedLayout(
       funcSizes, funcCounts, callCounts, callOffsets);
@@ -219,6 +219,7 @@ struct Config {
   uint32_t andFeatures = 0;
   llvm::CachePruningPolicy thinLTOCachePolicy;
   llvm::SetVector<llvm::CachedHashString> dependencyFiles; // for --dependency-file
+  llvm::SetVector<llvm::CachedHashString> missingFiles; // for --incremental
   llvm::StringMap<uint64_t> sectionStartMap;
   llvm::StringRef bfdname;
   llvm::StringRef chroot;
@@ -228,6 +229,7 @@ struct Config {
   llvm::StringRef entry;
   llvm::StringRef emulation;
   llvm::StringRef fini;
+  llvm::StringRef incrementalDir;
   llvm::StringRef init;
   llvm::StringRef ltoAAPipeline;
   llvm::StringRef ltoCSProfileFile;
@@ -287,6 +289,7 @@ struct Config {
   llvm::MapVector<std::pair<const InputSectionBase *, const InputSectionBase *>,
                   uint64_t>
       callGraphProfile;
+  llvm::MapVector<const InputSectionBase *, uint64_t> functionEntryCounts;
   bool cmseImplib = false;
   bool allowMultipleDefinition;
   bool fatLTOObjects;
@@ -301,7 +304,9 @@ struct Config {
   bool armBe8 = false;
   BsymbolicKind bsymbolic = BsymbolicKind::None;
   CGProfileSortKind callGraphProfileSort;
+  bool callGraphProfileEntryCounts = false;
   llvm::StringRef irpgoProfilePath;
+  llvm::StringRef bpStartupTracePath;
   bool bpStartupFunctionSort = false;
   bool bpCompressionSortStartupFunctions = false;
   bool bpFunctionOrderForCompression = false;
@@ -402,6 +407,7 @@ struct Config {
   bool zForceIbt;
   bool zGlobal;
   bool zHazardplt;
+  uint64_t zHotTextAlign;
   bool zIfuncNoplt;
   bool zInitfirst;
   bool zInterpose;
@@ -419,6 +425,7 @@ struct Config {
   bool zRodynamic;
   bool zSectionHeader;
   bool zShstk;
+  uint64_t zSplitTextAlign;
   bool zStartStopGC;
   uint8_t zStartStopVisibility;
   bool zText;
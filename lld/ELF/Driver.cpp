@@ -60,6 +60,7 @@
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/SaveAndRestore.h"
 #include "llvm/Support/TarWriter.h"
 #include "llvm/Support/TargetSelect.h"
@@ -455,6 +456,9 @@ static void checkOptions(Ctx &ctx) {
   if (ctx.arg.zText && ctx.arg.zIfuncNoplt)
     ErrAlways(ctx) << "-z text and -z ifunc-noplt may not be used together";
 
+  if (!ctx.arg.incrementalDir.empty() && ctx.arg.outputFile == "-")
+    ErrAlways(ctx) << "--incremental may not be used with -o -";
+
   if (ctx.arg.relocatable) {
     if (ctx.arg.shared)
       ErrAlways(ctx) << "-r and -shared may not be used together";
@@ -647,6 +651,74 @@ constexpr const char *saveTempsValues[] = {
 
 LinkerDriver::LinkerDriver(Ctx &ctx) : ctx(ctx) {}
 
+// --incremental=<dir> records the state of a successful link in <dir>. The
+// state is the full command line, the linker version and the identity (path,
+// size and modification time) of every file read to create the input files,
+// every path searched for an input without success, followed by the identity
+// of the output written. If a later link finds the
+// same state and the output is untouched, the output is already the result
+// of this link and the link is skipped.
+static constexpr StringLiteral incrementalStateMagic = "lld-incremental-v2\n";
+
+static std::string getIncrementalStatePath(Ctx &ctx) {
+  SmallString<128> path(ctx.arg.incrementalDir);
+  path::append(path, path::filename(ctx.arg.outputFile) + ".state");
+  return std::string(path);
+}
+
+static std::string getFileIdentity(StringRef path) {
+  fs::file_status st;
+  if (fs::status(path, st))
+    return "";
+  return (Twine(st.getSize()) + " " +
+          Twine(st.getLastModificationTime().time_since_epoch().count()))
+      .str();
+}
+
+static std::string computeIncrementalKey(Ctx &ctx, opt::InputArgList &args) {
+  std::string key;
+  raw_string_ostream os(key);
+  os << getLLDVersion() << '\n';
+  for (const opt::Arg *arg : args)
+    os << arg->getAsString(args) << '\n';
+  for (StringRef path : ctx.arg.dependencyFiles)
+    os << "R " << path << ' ' << getFileIdentity(path) << '\n';
+  for (StringRef path : ctx.arg.missingFiles)
+    os << "N " << path << '\n';
+  return key;
+}
+
+static bool isIncrementalOutputUpToDate(Ctx &ctx, StringRef key) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr =
+      MemoryBuffer::getFile(getIncrementalStatePath(ctx), /*IsText=*/false,
+                            /*RequiresNullTerminator=*/false);
+  if (!mbOrErr)
+    return false;
+  StringRef state = (*mbOrErr)->getBuffer();
+  if (!state.consume_front(incrementalStateMagic))
+    return false;
+  auto [output, rest] = state.split('\n');
+  std::string identity = getFileIdentity(ctx.arg.outputFile);
+  return !identity.empty() && output == identity && rest == key;
+}
+
+static void writeIncrementalState(Ctx &ctx, StringRef key) {
+  if (std::error_code ec = fs::create_directories(ctx.arg.incrementalDir)) {
+    Warn(ctx) << "--incremental: cannot create " << ctx.arg.incrementalDir
+              << ": " << ec.message();
+    return;
+  }
+  std::string path = getIncrementalStatePath(ctx);
+  std::error_code ec;
+  raw_fd_ostream os(path, ec, fs::OF_None);
+  if (ec) {
+    Warn(ctx) << "--incremental: cannot open " << path << ": " << ec.message();
+    return;
+  }
+  os << incrementalStateMagic << getFileIdentity(ctx.arg.outputFile) << '\n'
+     << key;
+}
+
 void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
   ELFOptTable parser;
   opt::InputArgList args = parser.parse(ctx, argsArr.slice(1));
@@ -726,7 +798,29 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
     if (errCount(ctx))
       return;
 
-    invokeELFT(link, args);
+    // With --incremental, every input has been read at this point, so we can
+    // tell whether the previous output is still valid.
+    std::string incrementalKey;
+    if (!ctx.arg.incrementalDir.empty())
+      incrementalKey = computeIncrementalKey(ctx, args);
+    if (!incrementalKey.empty() &&
+        isIncrementalOutputUpToDate(ctx, incrementalKey)) {
+      Log(ctx) << "--incremental: " << ctx.arg.outputFile << " is up to date";
+    } else {
+      invokeELFT(link, args);
+      if (!incrementalKey.empty() && !errCount(ctx) && !ctx.e.disableOutput)
+        writeIncrementalState(ctx, incrementalKey);
+    }
+  }
+
+  // Report allocator footprint so that the effect of an alternative malloc
+  // implementation on a link can be quantified.
+  if (ctx.e.verbose) {
+    size_t inUse = sys::Process::GetMallocUsage();
+    size_t reserved = sys::Process::GetMallocReservedSize();
+    if (reserved)
+      Log(ctx) << "malloc: " << (inUse >> 20) << " MiB in use, "
+               << (reserved >> 20) << " MiB reserved";
   }
 
   if (ctx.arg.timeTraceEnabled) {
@@ -1120,6 +1214,86 @@ template <class ELFT> static void readCallGraphsFromObjectFiles(Ctx &ctx) {
   }
 }
 
+// Read the function entry counts recorded in the PGO analysis map of
+// SHT_LLVM_BB_ADDR_MAP sections (-pgo-analysis-map=func-entry-count), and
+// attribute them to the text sections the maps describe. They give the
+// Cache-Directed Sort the execution counts of functions that are only reached
+// through indirect or otherwise unprofiled calls.
+// Returns false if the first function of the map \p sec does not record its
+// entry count, which avoids decoding maps that carry no PGO analysis. The
+// feature flags are the byte after the version, or the low byte of the 16-bit
+// field in version 5 and later.
+template <class ELFT>
+static bool mayHaveFunctionEntryCounts(ObjFile<ELFT> &obj,
+                                       const Elf_Shdr_Impl<ELFT> &sec) {
+  if (sec.sh_flags & SHF_COMPRESSED)
+    return true;
+  Expected<ArrayRef<uint8_t>> contentsOrErr =
+      obj.getObj().getSectionContents(sec);
+  if (!contentsOrErr) {
+    consumeError(contentsOrErr.takeError());
+    return true;
+  }
+  ArrayRef<uint8_t> contents = *contentsOrErr;
+  size_t featureOffset = contents.empty() || contents[0] < 5 ||
+                                 ELFT::Endianness == endianness::little
+                             ? 1
+                             : 2;
+  if (contents.size() <= featureOffset)
+    return false;
+  Expected<BBAddrMap::Features> featuresOrErr =
+      BBAddrMap::Features::decode(contents[featureOffset]);
+  if (!featuresOrErr) {
+    // Let the full decode report the error.
+    consumeError(featuresOrErr.takeError());
+    return true;
+  }
+  return featuresOrErr->FuncEntryCount;
+}
+
+template <class ELFT> static void readFunctionEntryCounts(Ctx &ctx) {
+  for (auto file : ctx.objectFiles) {
+    auto *obj = cast<ObjFile<ELFT>>(file);
+    ArrayRef<Elf_Shdr_Impl<ELFT>> objSections =
+        obj->template getELFShdrs<ELFT>();
+    ArrayRef<InputSectionBase *> sections = obj->getSections();
+
+    // The addresses in a map of a relocatable file are only known from its
+    // relocation section.
+    DenseMap<uint32_t, const Elf_Shdr_Impl<ELFT> *> relocSections;
+    for (const Elf_Shdr_Impl<ELFT> &sec : objSections)
+      if (sec.sh_type == SHT_RELA || sec.sh_type == SHT_CREL)
+        relocSections[sec.sh_info] = &sec;
+
+    for (size_t i = 0, e = objSections.size(); i < e; ++i) {
+      const Elf_Shdr_Impl<ELFT> &sec = objSections[i];
+      if (sec.sh_type != SHT_LLVM_BB_ADDR_MAP ||
+          sec.sh_link >= sections.size())
+        continue;
+      InputSectionBase *text = sections[sec.sh_link];
+      if (!text || text == &InputSection::discarded || !text->isLive())
+        continue;
+      if (!mayHaveFunctionEntryCounts<ELFT>(*obj, sec))
+        continue;
+
+      std::vector<PGOAnalysisMap> pgoAnalyses;
+      auto mapsOrErr = obj->getObj().decodeBBAddrMap(
+          sec, relocSections.lookup(i), &pgoAnalyses);
+      if (!mapsOrErr) {
+        Warn(ctx) << obj << ": unable to read SHT_LLVM_BB_ADDR_MAP: "
+                  << mapsOrErr.takeError();
+        continue;
+      }
+      uint64_t count = 0;
+      for (const PGOAnalysisMap &pgo : pgoAnalyses)
+        if (pgo.FeatEnable.FuncEntryCount)
+          count += pgo.FuncEntryCount;
+      if (count)
+        ctx.arg.functionEntryCounts[text] += count;
+    }
+  }
+}
+
 template <class ELFT>
 static void ltoValidateAllVtablesHaveTypeInfos(Ctx &ctx,
                                                opt::InputArgList &args) {
@@ -1231,14 +1405,18 @@ static void parseBPOrdererOptions(Ctx &ctx, opt::InputArgList &args) {
   ctx.arg.bpVerboseSectionOrderer = args.hasArg(OPT_verbose_bp_section_orderer);
 
   ctx.arg.irpgoProfilePath = args.getLastArgValue(OPT_irpgo_profile);
-  if (ctx.arg.irpgoProfilePath.empty()) {
+  ctx.arg.bpStartupTracePath = args.getLastArgValue(OPT_bp_startup_trace);
+  if (!ctx.arg.irpgoProfilePath.empty() && !ctx.arg.bpStartupTracePath.empty())
+    ErrAlways(ctx) << "--irpgo-profile and --bp-startup-trace may not be used "
+                      "together";
+  if (ctx.arg.irpgoProfilePath.empty() && ctx.arg.bpStartupTracePath.empty()) {
     if (ctx.arg.bpStartupFunctionSort)
       ErrAlways(ctx) << "--bp-startup-sort=function must be used with "
-                        "--irpgo-profile";
+                        "--irpgo-profile or --bp-startup-trace";
     if (ctx.arg.bpCompressionSortStartupFunctions)
       ErrAlways(ctx)
           << "--bp-compression-sort-startup-functions must be used with "
-             "--irpgo-profile";
+             "--irpgo-profile or --bp-startup-trace";
   }
 }
 
@@ -1378,6 +1556,9 @@ static void readConfigs(Ctx &ctx, opt::InputArgList &args) {
       ctx.arg.bsymbolic = BsymbolicKind::All;
   }
   ctx.arg.callGraphProfileSort = getCGProfileSortKind(ctx, args);
+  ctx.arg.callGraphProfileEntryCounts =
+      args.hasFlag(OPT_call_graph_profile_entry_counts,
+                   OPT_no_call_graph_profile_entry_counts, false);
   parseBPOrdererOptions(ctx, args);
   ctx.arg.checkSections =
       args.hasFlag(OPT_check_sections, OPT_no_check_sections, true);
@@ -1442,6 +1623,7 @@ static void readConfigs(Ctx &ctx, opt::InputArgList &args) {
       args.hasArg(OPT_ignore_data_address_equality);
   ctx.arg.ignoreFunctionAddressEquality =
       args.hasArg(OPT_ignore_function_address_equality);
+  ctx.arg.incrementalDir = args.getLastArgValue(OPT_incremental);
   ctx.arg.init = args.getLastArgValue(OPT_init, "_init");
   ctx.arg.ltoAAPipeline = args.getLastArgValue(OPT_lto_aa_pipeline);
   ctx.arg.ltoCSProfileGenerate = args.hasArg(OPT_lto_cs_profile_generate);
@@ -1631,13 +1813,24 @@ static void readConfigs(Ctx &ctx, opt::InputArgList &args) {
   ctx.arg.zGlobal = hasZOption(args, "global");
   ctx.arg.zGnustack = getZGnuStack(args);
   ctx.arg.zHazardplt = hasZOption(args, "hazardplt");
+  ctx.arg.zHotTextAlign =
+      args::getZOptionValue(args, OPT_z, "hot-text-align", 0);
+  if (ctx.arg.zHotTextAlign && !isPowerOf2_64(ctx.arg.zHotTextAlign))
+    ErrAlways(ctx) << "hot-text-align: value isn't a power of 2";
+  ctx.arg.zSplitTextAlign =
+      args::getZOptionValue(args, OPT_z, "split-text-align", 0);
+  if (ctx.arg.zSplitTextAlign && !isPowerOf2_64(ctx.arg.zSplitTextAlign))
+    ErrAlways(ctx) << "split-text-align: value isn't a power of 2";
   ctx.arg.zIfuncNoplt = hasZOption(args, "ifunc-noplt");
   ctx.arg.zInitfirst = hasZOption(args, "initfirst");
   ctx.arg.zInterpose = hasZOption(args, "interpose");
   ctx.arg.zKeepDataSectionPrefix = getZFlag(
       args, "keep-data-section-prefix", "nokeep-data-section-prefix", false);
-  ctx.arg.zKeepTextSectionPrefix = getZFlag(
-      args, "keep-text-section-prefix", "nokeep-text-section-prefix", false);
+  // -z hot-text-align= and -z split-text-align= operate on the .text.hot and
+  // .text.split output sections, so they imply -z keep-text-section-prefix.
+  ctx.arg.zKeepTextSectionPrefix =
+      getZFlag(args, "keep-text-section-prefix", "nokeep-text-section-prefix",
+               ctx.arg.zHotTextAlign != 0 || ctx.arg.zSplitTextAlign != 0);
   ctx.arg.zLrodataAfterBss =
       getZFlag(args, "lrodata-after-bss", "nolrodata-after-bss", false);
   ctx.arg.zNoBtCfi = hasZOption(args, "nobtcfi");
@@ -1843,11 +2036,14 @@ static void readConfigs(Ctx &ctx, opt::InputArgList &args) {
   if (auto *arg = args.getLastArg(OPT_threads)) {
     StringRef v(arg->getValue());
     unsigned threads = 0;
-    if (!llvm::to_integer(v, threads, 0) || threads == 0)
+    if (v == "jobserver")
+      parallel::strategy = jobserver_concurrency();
+    else if (!llvm::to_integer(v, threads, 0) || threads == 0)
       ErrAlways(ctx) << arg->getSpelling()
-                     << ": expected a positive integer, but got '"
+                     << ": expected a positive integer or 'jobserver', got '"
                      << arg->getValue() << "'";
-    parallel::strategy = hardware_concurrency(threads);
+    else
+      parallel::strategy = hardware_concurrency(threads);
     ctx.arg.thinLTOJobs = v;
   } else if (parallel::strategy.compute_thread_count() > 16) {
     Log(ctx) << "set maximum concurrency to 16, specify --threads= to change";
@@ -3506,6 +3702,9 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
         readCallGraph(ctx, *buffer);
     } else
       readCallGraphsFromObjectFiles<ELFT>(ctx);
+    if (ctx.arg.callGraphProfileSort == CGProfileSortKind::Cdsort &&
+        ctx.arg.callGraphProfileEntryCounts)
+      readFunctionEntryCounts<ELFT>(ctx);
   }
 
   // Write the result to the file.
@@ -226,6 +226,10 @@ static std::optional<std::string> findFile(Ctx &ctx, StringRef path1,
 
   if (fs::exists(s))
     return std::string(s);
+  // A file created here later could change how the link resolves, so
+  // --incremental has to know about every failed lookup.
+  if (!ctx.arg.incrementalDir.empty())
+    ctx.arg.missingFiles.insert(llvm::CachedHashString(s));
   return std::nullopt;
 }
 
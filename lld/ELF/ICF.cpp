@@ -444,6 +444,19 @@ void ICF<ELFT>::parallelForEachClass(
   ++cnt;
 }
 
+// Returns a hash of the parts of a section that equalsConstant() requires to be
+// identical, i.e. the flags, the contents and the offsets and types of the
+// relocations. Addends and targets may differ between equal sections.
+template <class RelTy>
+static uint64_t getConstantHash(InputSection *isec, Relocs<RelTy> rels,
+                                bool isMips64EL) {
+  uint64_t hash = xxh3_64bits(isec->content()) ^ isec->flags;
+  for (RelTy rel : rels)
+    hash = (hash ^ (uint64_t(rel.r_offset) << 32 | rel.getType(isMips64EL))) *
+           0x100000001b3;
+  return hash;
+}
+
 // Combine the hashes of the sections referenced by the given section into its
 // hash.
 template <class RelTy>
@@ -488,10 +501,20 @@ template <class ELFT> void ICF<ELFT>::run() {
     }
   }
 
-  // Initially, we use hash values to partition sections.
+  // Initially, we use hash values to partition sections. Hashing relocation
+  // offsets and types along with the contents separates sections that only
+  // differ in their relocations, so that segregate() has less work to do.
   parallelForEach(sections, [&](InputSection *s) {
+    const RelsOrRelas<ELFT> rels = s->template relsOrRelas<ELFT>();
+    uint64_t hash;
+    if (rels.areRelocsCrel())
+      hash = getConstantHash(s, rels.crels, ctx.arg.isMips64EL);
+    else if (rels.areRelocsRel())
+      hash = getConstantHash(s, rels.rels, ctx.arg.isMips64EL);
+    else
+      hash = getConstantHash(s, rels.relas, ctx.arg.isMips64EL);
     // Set MSB to 1 to avoid collisions with unique IDs.
-    s->eqClass[0] = xxh3_64bits(s->content()) | (1U << 31);
+    s->eqClass[0] = hash | (1U << 31);
   });
 
   // Perform 2 rounds of relocation hash propagation. 2 is an empirical value to
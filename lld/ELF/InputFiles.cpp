@@ -1962,17 +1962,21 @@ void BitcodeFile::parseLazy() {
   numSymbols = obj->symbols().size();
   symbols = std::make_unique<Symbol *[]>(numSymbols);
   for (auto [i, irSym] : llvm::enumerate(obj->symbols())) {
+    // Only defined symbols are inserted into the symbol table. The names of
+    // undefined symbols are saved by createBitcodeSymbol if this file is
+    // extracted, so that archive members which are never extracted don't
+    // copy them.
+    if (irSym.isUndefined())
+      continue;
     // Symbols can be duplicated in bitcode files because of '#include' and
     // linkonce_odr. Use uniqueSaver to save symbol names for de-duplication.
     // Update objSym.Name to reference (via StringRef) the string saver's copy;
     // this way LTO can reference the same string saver's copy rather than
     // keeping copies of its own.
     irSym.Name = ctx.uniqueSaver.save(irSym.getName());
-    if (!irSym.isUndefined()) {
-      auto *sym = ctx.symtab->insert(irSym.getName());
-      sym->resolve(ctx, LazySymbol{*this});
-      symbols[i] = sym;
-    }
+    auto *sym = ctx.symtab->insert(irSym.getName());
+    sym->resolve(ctx, LazySymbol{*this});
+    symbols[i] = sym;
   }
 }
 
@@ -634,7 +634,41 @@ static void reportUndefinedSymbol(Ctx &ctx, const UndefinedDiag &undef,
     ctx.e.error(msg.str(), ErrorTag::SymbolNotFound, {sym.getName()});
 }
 
+// Returns true if relocations of `s` are scanned by scanSection() as part of
+// its file. .ARM.exidx sections are scanned with the .eh_frame sections.
+static bool isScannedRegularSection(Ctx &ctx, const InputSectionBase &s) {
+  return s.kind() == SectionBase::Regular && s.isLive() &&
+         (s.flags & SHF_ALLOC) &&
+         !(s.type == SHT_ARM_EXIDX && ctx.arg.emachine == EM_ARM);
+}
+
 void elf::reportUndefinedSymbols(Ctx &ctx) {
+  // Relocations are scanned concurrently, so sort the diagnostics into the
+  // order a serial scan would have recorded them. A section is scanned by a
+  // single task, so a stable sort keyed on the section suffices.
+  if (ctx.undefErrs.size() > 1) {
+    DenseMap<const InputSectionBase *, size_t> order;
+    for (ELFFileBase *f : ctx.objectFiles)
+      for (InputSectionBase *s : f->getSections())
+        if (s && isScannedRegularSection(ctx, *s))
+          order.try_emplace(s, order.size());
+    for (Partition &part : ctx.partitions) {
+      for (EhInputSection *sec : part.ehFrame->sections)
+        order.try_emplace(sec, order.size());
+      if (part.armExidx)
+        for (InputSection *sec : part.armExidx->exidxSections)
+          order.try_emplace(sec, order.size());
+    }
+    auto getOrder = [&](const UndefinedDiag &undef) {
+      auto it = order.find(undef.locs[0].sec);
+      return it == order.end() ? SIZE_MAX : it->second;
+    };
+    llvm::stable_sort(ctx.undefErrs,
+                      [&](const UndefinedDiag &a, const UndefinedDiag &b) {
+                        return getOrder(a) < getOrder(b);
+                      });
+  }
+
   // Find the first "undefined symbol" diagnostic for each diagnostic, and
   // collect all "referenced from" lines at the first diagnostic.
   DenseMap<Symbol *, UndefinedDiag *> firstRef;
@@ -1383,6 +1417,9 @@ void RelocScan::scanEhSection(EhInputSection &s) {
   }
 }
 
+// The number of consecutive input sections scanned by one task.
+static constexpr size_t scanSectionsPerTask = 256;
+
 template <class ELFT> void elf::scanRelocations(Ctx &ctx) {
   // Scan all relocations. Each relocation goes through a series of tests to
   // determine if it needs special treatment, such as creating GOT, PLT,
@@ -1397,18 +1434,26 @@ template <class ELFT> void elf::scanRelocations(Ctx &ctx) {
   parallel::TaskGroup tg;
   auto outerFn = [&]() {
     for (ELFFileBase *f : ctx.objectFiles) {
-      auto fn = [f, &ctx]() {
-        for (InputSectionBase *s : f->getSections()) {
-          if (s && s->kind() == SectionBase::Regular && s->isLive() &&
-              (s->flags & SHF_ALLOC) &&
-              !(s->type == SHT_ARM_EXIDX && ctx.arg.emachine == EM_ARM))
-            ctx.target->scanSection(*s);
-        }
-      };
-      if (serial)
-        fn();
-      else
-        tg.spawn(fn);
+      // A task scans a shard of consecutive sections rather than a whole file
+      // so that a single huge input, e.g. an LTO output, does not serialize
+      // the scan. Each section is scanned by exactly one task and dynamic
+      // relocations are sorted later, so the output does not depend on the
+      // sharding.
+      ArrayRef<InputSectionBase *> sections = f->getSections();
+      while (!sections.empty()) {
+        ArrayRef<InputSectionBase *> shard = sections.take_front(
+            serial ? sections.size() : scanSectionsPerTask);
+        sections = sections.drop_front(shard.size());
+        auto fn = [shard, &ctx]() {
+          for (InputSectionBase *s : shard)
+            if (s && isScannedRegularSection(ctx, *s))
+              ctx.target->scanSection(*s);
+        };
+        if (serial)
+          fn();
+        else
+          tg.spawn(fn);
+      }
     }
     auto scanEH = [&] {
       RelocScan scanner(ctx);
@@ -1281,11 +1281,31 @@ unsigned StringTableSection::addString(StringRef s, bool hashIt) {
 }
 
 void StringTableSection::writeTo(uint8_t *buf) {
-  for (StringRef s : strings) {
-    memcpy(buf, s.data(), s.size());
-    buf[s.size()] = '\0';
-    buf += s.size() + 1;
-  }
+  // .strtab may contain tens of millions of local symbol names. Split the
+  // strings into chunks, compute the output offset of each chunk, and copy the
+  // chunks in parallel.
+  constexpr size_t stringsPerChunk = 1 << 16;
+  size_t numChunks = divideCeil(strings.size(), stringsPerChunk);
+  auto getChunk = [&](size_t i) {
+    return ArrayRef(strings).slice(i * stringsPerChunk).take_front(
+        stringsPerChunk);
+  };
+  SmallVector<uint64_t, 0> chunkOffsets(numChunks + 1);
+  parallelFor(0, numChunks, [&](size_t i) {
+    for (StringRef s : getChunk(i))
+      chunkOffsets[i + 1] += s.size() + 1;
+  });
+  for (size_t i = 0; i < numChunks; ++i)
+    chunkOffsets[i + 1] += chunkOffsets[i];
+
+  parallelFor(0, numChunks, [&](size_t i) {
+    uint8_t *p = buf + chunkOffsets[i];
+    for (StringRef s : getChunk(i)) {
+      memcpy(p, s.data(), s.size());
+      p[s.size()] = '\0';
+      p += s.size() + 1;
+    }
+  });
 }
 
 // Returns the number of entries in .gnu.version_d: the number of
@@ -3920,11 +3940,13 @@ void MergeTailSection::finalizeContents() {
 
   // finalize() fixed tail-optimized strings, so we can now get
   // offsets of strings. Get an offset for each string and save it
-  // to a corresponding SectionPiece for easy access.
-  for (MergeInputSection *sec : sections)
+  // to a corresponding SectionPiece for easy access. The builder is no longer
+  // modified, so the lookups can be done in parallel.
+  parallelForEach(sections, [&](MergeInputSection *sec) {
     for (size_t i = 0, e = sec->pieces.size(); i != e; ++i)
       if (sec->pieces[i].live)
         sec->pieces[i].outputOff = builder.getOffset(sec->getData(i));
+  });
 }
 
 void MergeNoTailSection::writeTo(uint8_t *buf) {
@@ -822,10 +822,12 @@ public:
     uint32_t entryOffset;
     // Used to relocate `stringOffset` in the merged section.
     uint32_t chunkIdx;
-    SmallVector<IndexEntry *, 0> indexEntries;
+    // Most names have a single index entry. Store one inline to avoid a heap
+    // allocation per name, as there can be many millions of them.
+    SmallVector<IndexEntry *, 1> indexEntries;
 
     llvm::iterator_range<
-        llvm::pointee_iterator<typename SmallVector<IndexEntry *, 0>::iterator>>
+        llvm::pointee_iterator<typename SmallVector<IndexEntry *, 1>::iterator>>
     entries() {
       return llvm::make_pointee_range(indexEntries);
     }
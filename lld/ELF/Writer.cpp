@@ -26,6 +26,7 @@
 #include "lld/Common/Filesystem.h"
 #include "lld/Common/Strings.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/BLAKE3.h"
 #include "llvm/Support/Parallel.h"
@@ -33,6 +34,7 @@
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/xxhash.h"
 #include <climits>
+#include <thread>
 
 #define DEBUG_TYPE "lld"
 
@@ -349,7 +351,20 @@ template <class ELFT> void Writer<ELFT>::run() {
   // Handle --print-map(-M)/--Map and --cref. Dump them before checkSections()
   // because the files may be useful in case checkSections() or openFile()
   // fails, for example, due to an erroneous file size.
-  writeMapAndCref(ctx);
+  //
+  // Addresses and file offsets are final at this point, so a map file is
+  // written on a separate thread while the output file is written. Output to
+  // stdout is written first to keep it ordered with other messages.
+  std::thread mapWriter;
+  if (!ctx.arg.mapFile.empty() && ctx.arg.mapFile != "-")
+    mapWriter = std::thread([&] { writeMapAndCref(ctx); });
+  else
+    writeMapAndCref(ctx);
+  auto joinMapWriter = [&] {
+    if (mapWriter.joinable())
+      mapWriter.join();
+  };
+  auto joinMapWriterOnExit = llvm::make_scope_exit(joinMapWriter);
 
   // Handle --print-memory-usage option.
   if (ctx.arg.printMemoryUsage)
@@ -381,6 +396,8 @@ template <class ELFT> void Writer<ELFT>::run() {
     // Backfill .note.gnu.build-id section content. This is done at last
     // because the content is usually a hash value of the entire output file.
     writeBuildId();
+    // Don't commit the output if writing the map file failed.
+    joinMapWriter();
     if (errCount(ctx))
       return;
 
@@ -1108,11 +1125,13 @@ static DenseMap<const InputSectionBase *, int> buildSectionOrder(Ctx &ctx) {
     TimeTraceScope timeScope("Balanced Partitioning Section Orderer");
     sectionOrder = runBalancedPartitioning(
         ctx, ctx.arg.bpStartupFunctionSort ? ctx.arg.irpgoProfilePath : "",
+        ctx.arg.bpStartupFunctionSort ? ctx.arg.bpStartupTracePath : "",
         ctx.arg.bpFunctionOrderForCompression,
         ctx.arg.bpDataOrderForCompression,
         ctx.arg.bpCompressionSortStartupFunctions,
         ctx.arg.bpVerboseSectionOrderer);
-  } else if (!ctx.arg.callGraphProfile.empty()) {
+  } else if (!ctx.arg.callGraphProfile.empty() ||
+             !ctx.arg.functionEntryCounts.empty()) {
     sectionOrder = computeCallGraphProfileOrder(ctx);
   }
 
@@ -2023,6 +2042,28 @@ template <class ELFT> void Writer<ELFT>::finalizeSections() {
         osec->shName = ctx.in.shStrTab->addString(osec->name);
     }
 
+  // -z hot-text-align=: make .text.hot start on the given boundary and let the
+  // next section start on the next one, so the hot text can be backed by huge
+  // pages that are not shared with cold code. -z split-text-align= does the
+  // same for .text.split, which gathers the cold parts of functions split by
+  // -fsplit-machine-functions, so that they are kept off the hot pages.
+  auto alignTextRegion = [&](StringRef name, uint64_t align) {
+    auto isAlloc = [](OutputSection *osec) { return osec->flags & SHF_ALLOC; };
+    auto it = llvm::find_if(ctx.outputSections, [&](OutputSection *osec) {
+      return osec->name == name && isAlloc(osec);
+    });
+    if (it != ctx.outputSections.end()) {
+      (*it)->addralign = std::max<uint64_t>((*it)->addralign, align);
+      auto next = std::find_if(std::next(it), ctx.outputSections.end(), isAlloc);
+      if (next != ctx.outputSections.end())
+        (*next)->addralign = std::max<uint64_t>((*next)->addralign, align);
+    }
+  };
+  if (ctx.arg.zHotTextAlign)
+    alignTextRegion(".text.hot", ctx.arg.zHotTextAlign);
+  if (ctx.arg.zSplitTextAlign)
+    alignTextRegion(".text.split", ctx.arg.zSplitTextAlign);
+
   // Prefer command line supplied address over other constraints.
   for (OutputSection *sec : ctx.outputSections) {
     auto i = ctx.arg.sectionStartMap.find(sec->name);
@@ -166,6 +166,7 @@ struct Configuration {
 
   llvm::StringRef installName;
   llvm::StringRef clientName;
+  llvm::StringRef incrementalDir;
   llvm::StringRef mapFile;
   llvm::StringRef ltoNewPmPasses;
   llvm::StringRef ltoObjPath;
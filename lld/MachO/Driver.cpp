@@ -1687,6 +1687,104 @@ static SmallVector<StringRef, 0> getAllowableClients(opt::InputArgList &args) {
   return vals;
 }
 
+// --incremental=<dir> records the state of a successful link in <dir>: the
+// identity (size and modification time) of the output, of every file read
+// during the link and the paths that were searched but not found, followed by
+// the linker version and the full command line. A later link with the same
+// command line is skipped if none of those files has changed, no missing file
+// has appeared and the output is untouched. Since the state is checked before
+// any input is read, this also covers files found through LC_LINKER_OPTION.
+static constexpr StringLiteral incrementalStateMagic = "lld-incremental-v1\n";
+
+static std::string getIncrementalStatePath() {
+  SmallString<128> path(config->incrementalDir);
+  path::append(path, path::filename(config->outputFile) + ".state");
+  return std::string(path);
+}
+
+static std::string getFileIdentity(StringRef path) {
+  fs::file_status st;
+  if (fs::status(path, st))
+    return "";
+  return (Twine(st.getSize()) + " " +
+          Twine(st.getLastModificationTime().time_since_epoch().count()))
+      .str();
+}
+
+static std::string computeIncrementalKey(const InputArgList &args) {
+  std::string key;
+  raw_string_ostream os(key);
+  os << getLLDVersion() << '\n';
+  for (const Arg *arg : args)
+    os << arg->getAsString(args) << '\n';
+  return key;
+}
+
+static bool isIncrementalOutputUpToDate(StringRef key) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr =
+      MemoryBuffer::getFile(getIncrementalStatePath(), /*IsText=*/false,
+                            /*RequiresNullTerminator=*/false);
+  if (!mbOrErr)
+    return false;
+  StringRef state = (*mbOrErr)->getBuffer();
+  if (!state.consume_front(incrementalStateMagic))
+    return false;
+
+  StringRef output;
+  std::tie(output, state) = state.split('\n');
+  std::string identity = getFileIdentity(config->outputFile);
+  if (identity.empty() || output != identity)
+    return false;
+
+  // Each file line is "R <identity>\t<path>" or "N <path>" and the list is
+  // terminated by a "K" line, after which the key follows.
+  while (!state.empty()) {
+    StringRef line;
+    std::tie(line, state) = state.split('\n');
+    if (line == "K")
+      return state == key;
+    if (line.consume_front("R ")) {
+      auto [savedIdentity, path] = line.split('\t');
+      if (getFileIdentity(path) != savedIdentity)
+        return false;
+    } else if (line.consume_front("N ")) {
+      if (fs::exists(line))
+        return false;
+    } else {
+      return false;
+    }
+  }
+  return false;
+}
+
+static void writeIncrementalState(StringRef key) {
+  if (std::error_code ec = fs::create_directories(config->incrementalDir)) {
+    warn("--incremental: cannot create " + config->incrementalDir + ": " +
+         ec.message());
+    return;
+  }
+  std::string path = getIncrementalStatePath();
+  std::error_code ec;
+  raw_fd_ostream os(path, ec, fs::OF_None);
+  if (ec) {
+    warn("--incremental: cannot open " + path + ": " + ec.message());
+    return;
+  }
+
+  std::vector<StringRef> reads;
+  reads.reserve(cachedReads.size());
+  for (const auto &entry : cachedReads)
+    reads.push_back(entry.first.val());
+  llvm::sort(reads);
+
+  os << incrementalStateMagic << getFileIdentity(config->outputFile) << '\n';
+  for (StringRef read : reads)
+    os << "R " << getFileIdentity(read) << '\t' << read << '\n';
+  for (const std::string &notFound : depTracker->getNotFounds())
+    os << "N " << notFound << '\n';
+  os << "K\n" << key;
+}
+
 namespace lld {
 namespace macho {
 bool link(ArrayRef<const char *> argsArr, llvm::raw_ostream &stdoutOS,
@@ -1751,7 +1849,8 @@ bool link(ArrayRef<const char *> argsArr, llvm::raw_ostream &stdoutOS,
   config->outputType = getOutputType(args);
   target = createTargetInfo(args);
   depTracker = std::make_unique<DependencyTracker>(
-      args.getLastArgValue(OPT_dependency_info));
+      args.getLastArgValue(OPT_dependency_info),
+      /*trackNotFounds=*/args.hasArg(OPT_incremental_eq));
 
   config->ltoo = args::getInteger(args, OPT_lto_O, 2);
   if (config->ltoo > 3)
@@ -1871,6 +1970,7 @@ bool link(ArrayRef<const char *> argsArr, llvm::raw_ostream &stdoutOS,
   for (const Arg *arg : args.filtered(OPT_U))
     config->explicitDynamicLookups.insert(arg->getValue());
 
+  config->incrementalDir = args.getLastArgValue(OPT_incremental_eq);
   config->mapFile = args.getLastArgValue(OPT_map);
   config->optimize = args::getInteger(args, OPT_O, 1);
   config->outputFile = args.getLastArgValue(OPT_o, "a.out");
@@ -2260,6 +2360,17 @@ bool link(ArrayRef<const char *> argsArr, llvm::raw_ostream &stdoutOS,
             ctx->e.errs());
   }
 
+  // With --incremental, the state recorded by the previous link tells us
+  // whether the output is still valid before any input is read.
+  std::string incrementalKey;
+  if (!config->incrementalDir.empty()) {
+    incrementalKey = computeIncrementalKey(args);
+    if (isIncrementalOutputUpToDate(incrementalKey)) {
+      log("--incremental: " + config->outputFile + " is up to date");
+      return errorCount() == 0;
+    }
+  }
+
   config->progName = argsArr[0];
 
   config->timeTraceEnabled = args.hasArg(OPT_time_trace_eq);
@@ -2408,6 +2519,10 @@ bool link(ArrayRef<const char *> argsArr, llvm::raw_ostream &stdoutOS,
       writeResult<ILP32>();
 
     depTracker->write(getLLDVersion(), inputFiles, config->outputFile);
+
+    if (!incrementalKey.empty() && errorCount() == 0 &&
+        !ctx->e.disableOutput)
+      writeIncrementalState(incrementalKey);
   }
 
   if (config->timeTraceEnabled) {
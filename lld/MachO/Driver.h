@@ -80,14 +80,16 @@ llvm::MachO::PlatformType removeSimulator(llvm::MachO::PlatformType platform);
 // Helper class to export dependency info.
 class DependencyTracker {
 public:
-  explicit DependencyTracker(llvm::StringRef path);
+  DependencyTracker(llvm::StringRef path, bool trackNotFounds);
 
   // Adds the given path to the set of not-found files.
   inline void logFileNotFound(const Twine &path) {
-    if (active)
+    if (active || trackNotFounds)
       notFounds.insert(path.str());
   }
 
+  const std::set<std::string> &getNotFounds() const { return notFounds; }
+
   // Writes the dependencies to specified path. The content is first sorted by
   // OpCode and then by the filename (in alphabetical order).
   void write(llvm::StringRef version,
@@ -108,6 +110,8 @@ private:
 
   const llvm::StringRef path;
   bool active;
+  // --incremental needs the not-found files even without -dependency_info.
+  bool trackNotFounds;
 
   // The paths need to be alphabetically ordered.
   // We need to own the paths because some of them are temporarily
@@ -376,8 +376,9 @@ void macho::printArchiveMemberLoad(StringRef reason, const InputFile *f) {
     message(reason + " forced load of " + toString(f));
 }
 
-macho::DependencyTracker::DependencyTracker(StringRef path)
-    : path(path), active(!path.empty()) {
+macho::DependencyTracker::DependencyTracker(StringRef path,
+                                             bool trackNotFounds)
+    : path(path), active(!path.empty()), trackNotFounds(trackNotFounds) {
   if (active && fs::exists(path) && !fs::can_write(path)) {
     warn("Ignoring dependency_info option since specified path is not "
          "writeable.");
@@ -0,0 +1,37 @@
+//===- BPSectionOrdererTest.cpp -------------------------------------------===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "LinkerTest.h"
+
+using namespace lld::elf;
+
+namespace {
+
+class BPSectionOrdererTest : public LinkerTest {};
+
+TEST_F(BPSectionOrdererTest, MissingStartupTrace) {
+  writeObject("a.o", startObjectYAML);
+  EXPECT_NE(link({"--bp-startup-sort=function",
+                  "--bp-startup-trace=" + path("missing.txt"), path("a.o"),
+                  "-o", path("a.out")}),
+            0);
+  EXPECT_NE(errors.find(path("missing.txt")), std::string::npos) << errors;
+  EXPECT_FALSE(llvm::sys::fs::exists(path("a.out")));
+}
+
+TEST_F(BPSectionOrdererTest, StartupTrace) {
+  writeObject("a.o", startObjectYAML);
+  writeFile("trace.txt", "# A single trace.\n_start\n");
+  EXPECT_EQ(link({"--bp-startup-sort=function",
+                  "--bp-startup-trace=" + path("trace.txt"), path("a.o"),
+                  "-o", path("a.out")}),
+            0)
+      << errors;
+}
+
+} // namespace
@@ -0,0 +1,113 @@
+//===- CallGraphSortTest.cpp ----------------------------------------------===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "LinkerTest.h"
+#include "llvm/Object/ObjectFile.h"
+
+using namespace lld::elf;
+using namespace llvm;
+
+namespace {
+
+// .text.hot has a SHT_LLVM_BB_ADDR_MAP with a function entry count, and
+// .text.cold comes first in the input. There is no call graph profile.
+constexpr const char *entryCountObjectYAML = R"(
+--- !ELF
+FileHeader:
+  Class:   ELFCLASS64
+  Data:    ELFDATA2LSB
+  Type:    ET_REL
+  Machine: EM_X86_64
+Sections:
+  - Name:    .text.cold
+    Type:    SHT_PROGBITS
+    Flags:   [ SHF_ALLOC, SHF_EXECINSTR ]
+    Content: C3
+  - Name:    .text.hot
+    Type:    SHT_PROGBITS
+    Flags:   [ SHF_ALLOC, SHF_EXECINSTR ]
+    Content: C3
+  - Name:    .llvm_bb_addr_map.hot
+    Type:    SHT_LLVM_BB_ADDR_MAP
+    Link:    .text.hot
+    Entries:
+      - Version: 2
+        Feature: 0x1
+        BBRanges:
+          - BaseAddress: 0x0
+            BBEntries:
+              - ID:            0
+                AddressOffset: 0x0
+                Size:          0x1
+                Metadata:      0x1
+    PGOAnalyses:
+      - FuncEntryCount: 1000
+Symbols:
+  - Name:    cold
+    Type:    STT_FUNC
+    Section: .text.cold
+    Binding: STB_GLOBAL
+  - Name:    hot
+    Type:    STT_FUNC
+    Section: .text.hot
+    Binding: STB_GLOBAL
+)";
+
+class CallGraphSortTest : public LinkerTest {
+protected:
+  // Links the object above with \p extraArgs and returns whether hot was
+  // placed before cold.
+  bool isHotFirst(std::vector<std::string> extraArgs) {
+    writeObject("a.o", entryCountObjectYAML);
+    std::vector<std::string> args{"-e", "hot", path("a.o"), "-o",
+                                  path("a.out")};
+    args.insert(args.end(), extraArgs.begin(), extraArgs.end());
+    EXPECT_EQ(link(args), 0) << errors;
+
+    Expected<object::OwningBinary<object::ObjectFile>> objOrErr =
+        object::ObjectFile::createObjectFile(path("a.out"));
+    if (!objOrErr) {
+      ADD_FAILURE() << toString(objOrErr.takeError());
+      return false;
+    }
+    uint64_t hot = 0, cold = 0;
+    for (const object::SymbolRef &sym : objOrErr->getBinary()->symbols()) {
+      Expected<StringRef> name = sym.getName();
+      Expected<uint64_t> addr = sym.getAddress();
+      if (!name || !addr) {
+        consumeError(name.takeError());
+        consumeError(addr.takeError());
+        continue;
+      }
+      if (*name == "hot")
+        hot = *addr;
+      else if (*name == "cold")
+        cold = *addr;
+    }
+    EXPECT_NE(hot, 0u);
+    EXPECT_NE(cold, 0u);
+    return hot < cold;
+  }
+};
+
+TEST_F(CallGraphSortTest, EntryCountsAreOptIn) {
+  EXPECT_FALSE(isHotFirst({}));
+  EXPECT_FALSE(isHotFirst({"--call-graph-profile-sort=cdsort"}));
+}
+
+TEST_F(CallGraphSortTest, EntryCountsWithoutCallGraphProfile) {
+  EXPECT_TRUE(isHotFirst({"--call-graph-profile-entry-counts"}));
+  EXPECT_TRUE(isHotFirst({"--call-graph-profile-sort=cdsort",
+                          "--call-graph-profile-entry-counts"}));
+  EXPECT_FALSE(isHotFirst({"--call-graph-profile-sort=hfsort",
+                           "--call-graph-profile-entry-counts"}));
+  EXPECT_FALSE(isHotFirst({"--call-graph-profile-entry-counts",
+                           "--no-call-graph-profile-entry-counts"}));
+}
+
+} // namespace
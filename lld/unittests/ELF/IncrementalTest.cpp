@@ -0,0 +1,69 @@
+//===- IncrementalTest.cpp ------------------------------------------------===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "LinkerTest.h"
+
+using namespace lld::elf;
+
+namespace {
+
+constexpr const char *fooObjectYAML = R"(
+--- !ELF
+FileHeader:
+  Class:   ELFCLASS64
+  Data:    ELFDATA2LSB
+  Type:    ET_REL
+  Machine: EM_X86_64
+Sections:
+  - Name:    .text
+    Type:    SHT_PROGBITS
+    Flags:   [ SHF_ALLOC, SHF_EXECINSTR ]
+    Content: C3
+Symbols:
+  - Name:    foo
+    Type:    STT_FUNC
+    Section: .text
+    Binding: STB_GLOBAL
+)";
+
+class IncrementalTest : public LinkerTest {
+protected:
+  void SetUp() override {
+    LinkerTest::SetUp();
+    ASSERT_FALSE(llvm::sys::fs::create_directory(path("dir1")));
+    ASSERT_FALSE(llvm::sys::fs::create_directory(path("dir2")));
+    writeObject("a.o", startObjectYAML);
+    writeObject("dir2/foo.o", fooObjectYAML);
+  }
+
+  // Links a.o against foo.o found in dir1 or dir2 and returns whether the
+  // previous output was reused.
+  bool linkIsUpToDate() {
+    EXPECT_EQ(link({"--verbose", "--incremental=" + path("state"), "-L",
+                    path("dir1"), "-L", path("dir2"), "-l:foo.o", path("a.o"),
+                    "-o", path("a.out")}),
+              0)
+        << errors;
+    return errors.find("is up to date") != std::string::npos;
+  }
+};
+
+TEST_F(IncrementalTest, UpToDate) {
+  EXPECT_FALSE(linkIsUpToDate());
+  EXPECT_TRUE(linkIsUpToDate());
+}
+
+TEST_F(IncrementalTest, LibraryInEarlierSearchPath) {
+  EXPECT_FALSE(linkIsUpToDate());
+  // dir1 is searched before dir2, so the new foo.o must be picked up.
+  writeObject("dir1/foo.o", fooObjectYAML);
+  EXPECT_FALSE(linkIsUpToDate());
+  EXPECT_TRUE(linkIsUpToDate());
+}
+
+} // namespace
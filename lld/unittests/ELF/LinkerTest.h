@@ -0,0 +1,109 @@
+//===- LinkerTest.h ---------------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// A fixture that runs the ELF driver in-process on objects built from YAML in a
+// scratch directory.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLD_UNITTESTS_ELF_LINKERTEST_H
+#define LLD_UNITTESTS_ELF_LINKERTEST_H
+
+#include "lld/Common/Driver.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ObjectYAML/yaml2obj.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/YAMLTraits.h"
+#include "llvm/Support/raw_ostream.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+LLD_HAS_DRIVER(elf)
+
+namespace lld {
+namespace elf {
+
+class LinkerTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory("lld-elf-test", dir));
+  }
+
+  void TearDown() override { llvm::sys::fs::remove_directories(dir); }
+
+  // Returns the path of \p name in the scratch directory.
+  std::string path(llvm::StringRef name) const {
+    llvm::SmallString<128> p(dir);
+    llvm::sys::path::append(p, name);
+    return std::string(p);
+  }
+
+  // Writes \p contents to \p name in the scratch directory.
+  void writeFile(llvm::StringRef name, llvm::StringRef contents) {
+    std::error_code ec;
+    llvm::raw_fd_ostream os(path(name), ec);
+    ASSERT_FALSE(ec) << ec.message();
+    os << contents;
+  }
+
+  // Writes the object file described by \p yaml to \p name in the scratch
+  // directory.
+  void writeObject(llvm::StringRef name, llvm::StringRef yaml) {
+    std::error_code ec;
+    llvm::raw_fd_ostream os(path(name), ec);
+    ASSERT_FALSE(ec) << ec.message();
+    llvm::yaml::Input yin(yaml);
+    ASSERT_TRUE(llvm::yaml::convertYAML(yin, os, [](const llvm::Twine &msg) {
+      ADD_FAILURE() << msg.str();
+    }));
+  }
+
+  // Runs ld.lld with \p args and returns its exit code. Diagnostics are
+  // collected in `errors`.
+  int link(const std::vector<std::string> &args) {
+    std::vector<const char *> argv{"ld.lld"};
+    for (const std::string &arg : args)
+      argv.push_back(arg.c_str());
+    errors.clear();
+    std::string out;
+    llvm::raw_string_ostream outOS(out), errOS(errors);
+    Result r = lldMain(argv, outOS, errOS, {{Gnu, &elf::link}});
+    EXPECT_TRUE(r.canRunAgain);
+    return r.retCode;
+  }
+
+  llvm::SmallString<128> dir;
+  std::string errors;
+};
+
+// A relocatable x86-64 object that defines _start in .text.
+constexpr const char *startObjectYAML = R"(
+--- !ELF
+FileHeader:
+  Class:   ELFCLASS64
+  Data:    ELFDATA2LSB
+  Type:    ET_REL
+  Machine: EM_X86_64
+Sections:
+  - Name:    .text
+    Type:    SHT_PROGBITS
+    Flags:   [ SHF_ALLOC, SHF_EXECINSTR ]
+    Content: C3
+Symbols:
+  - Name:    _start
+    Type:    STT_FUNC
+    Section: .text
+    Binding: STB_GLOBAL
+)";
+
+} // namespace elf
+} // namespace lld
+
+#endif
@@ -14,6 +14,7 @@
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/PluginManager.h"
+#include "lldb/Core/Progress.h"
 #include "lldb/Core/Section.h"
 #include "lldb/Symbol/Function.h"
 #include "lldb/Symbol/ObjectFile.h"
@@ -703,8 +704,15 @@ void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
   m_process->PrefetchModuleSpecs(
       module_names, m_process->GetTarget().GetArchitecture().GetTriple());
 
-  auto load_module_fn = [this, &module_list,
-                         &log](const DYLDRendezvous::SOEntry &so_entry) {
+  // Loading the initial modules can take a long time when attaching to a
+  // process with many shared libraries, so report it.
+  Progress progress("Loading shared libraries", "", module_names.size(),
+                    &m_process->GetTarget().GetDebugger(),
+                    Progress::kDefaultHighFrequencyReportTime);
+
+  auto load_module_fn = [this, &module_list, &log,
+                         &progress](const DYLDRendezvous::SOEntry &so_entry) {
+    progress.Increment(1, so_entry.file_spec.GetFilename().GetString());
     ModuleSP module_sp = LoadModuleAtAddress(
         so_entry.file_spec, so_entry.link_addr, so_entry.base_addr, true);
     if (module_sp.get()) {
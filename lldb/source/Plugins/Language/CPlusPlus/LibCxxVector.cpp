@@ -38,6 +38,8 @@ public:
 private:
   ValueObject *m_start = nullptr;
   ValueObject *m_finish = nullptr;
+  /// The value of m_start, read once per Update() instead of once per child.
+  std::optional<lldb::addr_t> m_start_addr;
   CompilerType m_element_type;
   uint32_t m_element_size = 0;
 };
@@ -116,8 +118,10 @@ lldb_private::formatters::LibcxxStdVectorSyntheticFrontEnd::GetChildAtIndex(
   if (!m_start || !m_finish)
     return lldb::ValueObjectSP();
 
+  if (!m_start_addr)
+    m_start_addr = m_start->GetValueAsUnsigned(0);
   uint64_t offset = idx * m_element_size;
-  offset = offset + m_start->GetValueAsUnsigned(0);
+  offset = offset + *m_start_addr;
   StreamString name;
   name.Printf("[%" PRIu64 "]", (uint64_t)idx);
   return CreateValueObjectFromAddress(name.GetString(), offset,
@@ -140,6 +144,7 @@ static ValueObjectSP GetDataPointer(ValueObject &root) {
 lldb::ChildCacheState
 lldb_private::formatters::LibcxxStdVectorSyntheticFrontEnd::Update() {
   m_start = m_finish = nullptr;
+  m_start_addr.reset();
   ValueObjectSP data_sp(GetDataPointer(m_backend));
 
   if (!data_sp)
@@ -95,6 +95,9 @@ void GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers() {
       &GDBRemoteCommunicationServerLLGS::Handle_memory_read);
   RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_M,
                                 &GDBRemoteCommunicationServerLLGS::Handle_M);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_MultiMemRead,
+      &GDBRemoteCommunicationServerLLGS::Handle_MultiMemRead);
   RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType__M,
                                 &GDBRemoteCommunicationServerLLGS::Handle__M);
   RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType__m,
@@ -2636,6 +2639,88 @@ GDBRemoteCommunicationServerLLGS::Handle_memory_read(
   return SendPacketNoLock(response.GetString());
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_MultiMemRead(
+    StringExtractorGDBRemote &packet) {
+  Log *log = GetLog(LLDBLog::Process);
+
+  if (!m_current_process ||
+      (m_current_process->GetID() == LLDB_INVALID_PROCESS_ID)) {
+    LLDB_LOGF(
+        log,
+        "GDBRemoteCommunicationServerLLGS::%s failed, no process available",
+        __FUNCTION__);
+    return SendErrorResponse(0x15);
+  }
+
+  // The packet looks like "MultiMemRead:ranges:<addr>,<size>,...;" with all
+  // numbers in hex. Unknown keys are ignored for forward compatibility.
+  llvm::StringRef packet_str = packet.GetStringRef();
+  packet_str.consume_front("MultiMemRead:");
+
+  std::vector<std::pair<lldb::addr_t, uint64_t>> ranges;
+  bool found_ranges = false;
+  for (llvm::StringRef field : llvm::split(packet_str, ';')) {
+    auto [key, value] = field.split(':');
+    if (key != "ranges")
+      continue;
+    found_ranges = true;
+    llvm::SmallVector<llvm::StringRef, 16> numbers;
+    value.split(numbers, ',');
+    if (numbers.size() % 2 != 0)
+      return SendIllFormedResponse(packet,
+                                   "Incomplete range in MultiMemRead packet");
+    for (size_t i = 0; i < numbers.size(); i += 2) {
+      lldb::addr_t addr;
+      uint64_t size;
+      if (numbers[i].getAsInteger(16, addr) ||
+          numbers[i + 1].getAsInteger(16, size))
+        return SendIllFormedResponse(packet,
+                                     "Invalid range in MultiMemRead packet");
+      ranges.emplace_back(addr, size);
+    }
+  }
+  if (!found_ranges)
+    return SendIllFormedResponse(packet,
+                                 "Ranges missing in MultiMemRead packet");
+
+  // The reply lists the number of bytes read for every range, followed by the
+  // binary data of all ranges back to back. A range that could not be read
+  // has a size of zero. The sizes come from the peer, so the total amount
+  // read is capped at the packet size advertised in qSupported; the client
+  // copes with short reads.
+  constexpr uint64_t max_total_size = 128 * 1024;
+  uint64_t remaining = max_total_size;
+  StreamGDBRemote sizes;
+  std::string data;
+  std::string buf;
+  for (auto [i, range] : llvm::enumerate(ranges)) {
+    auto [addr, requested_size] = range;
+    uint64_t size = std::min(requested_size, remaining);
+    size_t bytes_read = 0;
+    if (size != 0) {
+      buf.resize(size);
+      Status error = m_current_process->ReadMemoryWithoutTrap(
+          addr, buf.data(), size, bytes_read);
+      LLDB_LOG(log,
+               "ReadMemoryWithoutTrap({0}) read {1} of {2} requested bytes "
+               "(error: {3})",
+               addr, bytes_read, size, error);
+      data.append(buf.data(), bytes_read);
+      remaining -= bytes_read;
+    }
+    if (i != 0)
+      sizes.PutChar(',');
+    sizes.Printf("%" PRIx64, static_cast<uint64_t>(bytes_read));
+  }
+
+  StreamGDBRemote response;
+  response.PutCString(sizes.GetString());
+  response.PutChar(';');
+  response.PutEscapedBytes(data.data(), data.size());
+  return SendPacketNoLock(response.GetString());
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle__M(StringExtractorGDBRemote &packet) {
   Log *log = GetLog(LLDBLog::Process);
@@ -4309,6 +4394,7 @@ std::vector<std::string> GDBRemoteCommunicationServerLLGS::HandleFeatures(
                             "QListThreadsInStopReply+",
                             "qXfer:features:read+",
                             "QNonStop+",
+                            "MultiMemRead+",
                         });
 
   // report server-only features
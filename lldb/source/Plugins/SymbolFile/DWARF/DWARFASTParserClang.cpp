@@ -1709,7 +1709,10 @@ void DWARFASTParserClang::GetUniqueTypeNameAndDeclaration(
       unique_typename.IsEmpty())
     return;
   decl_declaration.Clear();
-  std::string qualified_name;
+  // Collect the enclosing scopes innermost first and join them once at the
+  // end; prepending to the name for every scope is quadratic in the nesting
+  // depth of heavily templated types.
+  llvm::SmallVector<std::string, 8> scopes;
   DWARFDIE parent_decl_ctx_die = die.GetParentDeclContextDIE();
   // TODO: change this to get the correct decl context parent....
   while (parent_decl_ctx_die) {
@@ -1719,12 +1722,10 @@ void DWARFASTParserClang::GetUniqueTypeNameAndDeclaration(
     const dw_tag_t parent_tag = parent_decl_ctx_die.Tag();
     switch (parent_tag) {
     case DW_TAG_namespace: {
-      if (const char *namespace_name = parent_decl_ctx_die.GetName()) {
-        qualified_name.insert(0, "::");
-        qualified_name.insert(0, namespace_name);
-      } else {
-        qualified_name.insert(0, "(anonymous namespace)::");
-      }
+      if (const char *namespace_name = parent_decl_ctx_die.GetName())
+        scopes.emplace_back(namespace_name);
+      else
+        scopes.emplace_back("(anonymous namespace)");
       parent_decl_ctx_die = parent_decl_ctx_die.GetParentDeclContextDIE();
       break;
     }
@@ -1732,12 +1733,9 @@ void DWARFASTParserClang::GetUniqueTypeNameAndDeclaration(
     case DW_TAG_class_type:
     case DW_TAG_structure_type:
     case DW_TAG_union_type: {
-      if (const char *class_union_struct_name = parent_decl_ctx_die.GetName()) {
-        qualified_name.insert(0, "::");
-        qualified_name.insert(0,
-                              GetDIEClassTemplateParams(parent_decl_ctx_die));
-        qualified_name.insert(0, class_union_struct_name);
-      }
+      if (const char *class_union_struct_name = parent_decl_ctx_die.GetName())
+        scopes.push_back(class_union_struct_name +
+                         GetDIEClassTemplateParams(parent_decl_ctx_die));
       parent_decl_ctx_die = parent_decl_ctx_die.GetParentDeclContextDIE();
       break;
     }
@@ -1748,6 +1746,11 @@ void DWARFASTParserClang::GetUniqueTypeNameAndDeclaration(
     }
   }
 
+  std::string qualified_name;
+  for (const std::string &scope : llvm::reverse(scopes)) {
+    qualified_name.append(scope);
+    qualified_name.append("::");
+  }
   if (qualified_name.empty())
     qualified_name.append("::");
 
@@ -130,11 +130,19 @@ void ManualDWARFIndex::IndexImpl() {
         IndexUnit(*unit, dwp_dwarf, sets[worker_id]);
       });
 
+  // The indexes only refer to DIEs by DIERef, so the DIEs that were extracted
+  // just for indexing can be released before merging.
+  clear_cu_dies.clear();
+
   // Merge partial indexes into a single index. Process each index in a set in
   // parallel.
   for (NameToDIE IndexSet<NameToDIE>::*index : indices) {
     task_group.async([this, &sets, index, &progress]() {
       NameToDIE &result = m_set.*index;
+      size_t total_size = 0;
+      for (auto &set : sets)
+        total_size += (set.*index).GetSize();
+      result.Reserve(total_size);
       for (auto &set : sets)
         result.Append(set.*index);
       result.Finalize();
@@ -142,6 +150,7 @@ void ManualDWARFIndex::IndexImpl() {
     });
   }
   task_group.wait();
+  sets.clear();
 
   SaveToCache();
 }
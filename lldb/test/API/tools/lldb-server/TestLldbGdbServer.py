@@ -567,6 +567,72 @@ class LldbGdbServerTestCase(
         read_contents = seven.unhexlify(context.get("read_contents"))
         self.assertEqual(read_contents, MEMORY_CONTENTS)
 
+    @skipIfWindows  # No pty support to test any inferior output
+    def test_MultiMemRead_packet_reads_memory(self):
+        self.build()
+        self.set_inferior_startup_launch()
+        MEMORY_CONTENTS = "Test contents 0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ abcdefghijklmnopqrstuvwxyz"
+
+        # Start up the inferior.
+        procs = self.prep_debug_monitor_and_inferior(
+            inferior_args=[
+                "set-message:%s" % MEMORY_CONTENTS,
+                "get-data-address-hex:g_message",
+                "sleep:5",
+            ]
+        )
+
+        # Run the process and stop it once the message address is known.
+        self.test_sequence.add_log_lines(
+            [
+                "read packet: $c#63",
+                {
+                    "type": "output_match",
+                    "regex": self.maybe_strict_output_regex(
+                        r"data address: 0x([0-9a-fA-F]+)\r\n"
+                    ),
+                    "capture": {1: "message_address"},
+                },
+                "read packet: {}".format(chr(3)),
+                {
+                    "direction": "send",
+                    "regex": r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);",
+                    "capture": {1: "stop_signo", 2: "stop_thread_id"},
+                },
+            ],
+            True,
+        )
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        self.assertIsNotNone(context.get("message_address"))
+        message_address = int(context.get("message_address"), 16)
+
+        # Read the whole message, an empty range and part of the message with a
+        # single packet.
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            [
+                "read packet: $MultiMemRead:ranges:{0:x},{1:x},{0:x},0,{2:x},a;#00".format(
+                    message_address, len(MEMORY_CONTENTS), message_address + 5
+                ),
+                {
+                    "direction": "send",
+                    "regex": r"^\$([0-9a-fA-F,]+);(.*)#[0-9a-fA-F]{2}$",
+                    "capture": {1: "sizes", 2: "read_contents"},
+                },
+            ],
+            True,
+        )
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        self.assertEqual(
+            context.get("sizes"), "{0:x},0,a".format(len(MEMORY_CONTENTS))
+        )
+        self.assertEqual(
+            context.get("read_contents"), MEMORY_CONTENTS + MEMORY_CONTENTS[5:15]
+        )
+
     def breakpoint_set_and_remove_work(self, want_hardware):
         # Start up the inferior.
         procs = self.prep_debug_monitor_and_inferior(
@@ -35,7 +35,7 @@ VariablesRequestHandler::Run(const VariablesArguments &arguments) const {
   if (lldb::SBValueList *top_scope = dap.variables.GetTopLevelScope(var_ref)) {
     // variablesReference is one of our scopes, not an actual variable it is
     // asking for the list of args, locals or globals.
-    int64_t start_idx = 0;
+    const int64_t start_idx = start;
     int64_t num_children = 0;
 
     if (var_ref == VARREF_REGS) {
@@ -82,19 +82,25 @@ VariablesRequestHandler::Run(const VariablesArguments &arguments) const {
         variables.emplace_back(var);
       }
     }
-    const int64_t end_idx = start_idx + ((count == 0) ? num_children : count);
-
-    // We first find out which variable names are duplicated
+    const int64_t end_idx =
+        std::min(num_children,
+                 start_idx + ((count == 0) ? num_children
+                                           : static_cast<int64_t>(count)));
+
+    // We first find out which variable names are duplicated. Look at the whole
+    // scope so that a client paging through it with start/count sees the same
+    // display names as one that fetches everything at once.
     std::map<std::string, int> variable_name_counts;
-    for (auto i = start_idx; i < end_idx; ++i) {
+    for (int64_t i = 0; i < num_children; ++i) {
       lldb::SBValue variable = top_scope->GetValueAtIndex(i);
       if (!variable.IsValid())
         break;
       variable_name_counts[GetNonNullVariableName(variable)]++;
     }
 
-    // Show return value if there is any ( in the local top frame )
-    if (var_ref == VARREF_LOCALS) {
+    // Show return value if there is any ( in the local top frame ). It goes
+    // before the locals, so only the first page includes it.
+    if (var_ref == VARREF_LOCALS && start_idx == 0) {
       auto process = dap.target.GetProcess();
       auto selected_thread = process.GetSelectedThread();
       lldb::SBValue stop_return_value = selected_thread.GetStopReturnValue();
@@ -0,0 +1,33 @@
+//===-- StopConditionTest.cpp ---------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Breakpoint/StopCondition.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+TEST(StopConditionTest, HashTracksText) {
+  StopCondition empty;
+  EXPECT_FALSE(empty);
+
+  StopCondition a("x == 1");
+  StopCondition b("x == 2");
+  EXPECT_TRUE(a);
+  EXPECT_EQ(a.GetText(), "x == 1");
+  EXPECT_NE(a.GetHash(), b.GetHash());
+  EXPECT_EQ(a.GetHash(), StopCondition("x == 1").GetHash());
+
+  // Changing the text must change the hash, since breakpoint locations use it
+  // to decide whether their cached condition expression is still valid.
+  size_t old_hash = a.GetHash();
+  a.SetText("x == 2");
+  EXPECT_NE(a.GetHash(), old_hash);
+  EXPECT_EQ(a.GetHash(), b.GetHash());
+}
@@ -0,0 +1,66 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures APInt arithmetic for widths that fit in a single word, which take
+// the inline fast path, and for multi-word widths.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/APInt.h"
+#include <vector>
+
+using namespace llvm;
+
+static std::vector<APInt> makeValues(unsigned BitWidth) {
+  std::vector<APInt> Values;
+  for (uint64_t I = 1; I != 257; ++I)
+    Values.push_back(APInt(BitWidth, I * 0x9E3779B97F4A7C15ULL,
+                           /*isSigned=*/false, /*implicitTrunc=*/true)
+                         .rotl(I));
+  return Values;
+}
+
+static void BM_APIntAddMul(benchmark::State &State) {
+  std::vector<APInt> Values = makeValues(State.range(0));
+  for (auto _ : State) {
+    APInt Acc(State.range(0), 0);
+    for (const APInt &V : Values) {
+      Acc += V;
+      Acc *= V;
+    }
+    benchmark::DoNotOptimize(Acc);
+  }
+  State.SetItemsProcessed(State.iterations() * Values.size());
+}
+
+static void BM_APIntUDiv(benchmark::State &State) {
+  std::vector<APInt> Values = makeValues(State.range(0));
+  for (auto _ : State) {
+    for (unsigned I = 1; I != Values.size(); ++I)
+      benchmark::DoNotOptimize(Values[I].udiv(Values[I - 1].lshr(3) + 1));
+  }
+  State.SetItemsProcessed(State.iterations() * (Values.size() - 1));
+}
+
+static void BM_APIntCompare(benchmark::State &State) {
+  std::vector<APInt> Values = makeValues(State.range(0));
+  for (auto _ : State) {
+    unsigned Count = 0;
+    for (unsigned I = 1; I != Values.size(); ++I)
+      Count += Values[I].ult(Values[I - 1]);
+    benchmark::DoNotOptimize(Count);
+  }
+  State.SetItemsProcessed(State.iterations() * (Values.size() - 1));
+}
+
+BENCHMARK(BM_APIntAddMul)->Arg(64)->Arg(128)->Arg(512);
+BENCHMARK(BM_APIntUDiv)->Arg(64)->Arg(128)->Arg(512);
+BENCHMARK(BM_APIntCompare)->Arg(64)->Arg(128)->Arg(512);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,81 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures BitstreamWriter and BitstreamCursor throughput on a block of
+// abbreviated and unabbreviated records, the shape of bitcode function blocks.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Bitstream/BitstreamReader.h"
+#include "llvm/Bitstream/BitstreamWriter.h"
+#include "llvm/Support/Error.h"
+#include <cstdint>
+
+using namespace llvm;
+
+static constexpr unsigned BlockID = bitc::FIRST_APPLICATION_BLOCKID;
+static constexpr unsigned NumRecords = 1 << 14;
+
+static void writeBlock(SmallVectorImpl<char> &Buffer) {
+  BitstreamWriter Stream(Buffer);
+  Stream.EnterSubblock(BlockID, 3);
+  auto Abbv = std::make_shared<BitCodeAbbrev>();
+  Abbv->Add(BitCodeAbbrevOp(1));
+  Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Array));
+  Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 6));
+  unsigned AbbrevID = Stream.EmitAbbrev(std::move(Abbv));
+
+  SmallVector<uint64_t, 8> Vals;
+  for (unsigned I = 0; I != NumRecords; ++I) {
+    Vals.assign({I, I * 3, uint64_t(I) << 20, 7});
+    if (I % 4)
+      Stream.EmitRecord(1, Vals, AbbrevID);
+    else
+      Stream.EmitRecord(2, Vals);
+  }
+  Stream.ExitBlock();
+}
+
+static void BM_BitstreamWrite(benchmark::State &State) {
+  SmallVector<char, 0> Buffer;
+  for (auto _ : State) {
+    Buffer.clear();
+    writeBlock(Buffer);
+    benchmark::DoNotOptimize(Buffer.data());
+  }
+  State.SetItemsProcessed(State.iterations() * NumRecords);
+}
+
+static void BM_BitstreamRead(benchmark::State &State) {
+  SmallVector<char, 0> Buffer;
+  writeBlock(Buffer);
+  SmallVector<uint64_t, 8> Vals;
+  for (auto _ : State) {
+    BitstreamCursor Cursor(StringRef(Buffer.data(), Buffer.size()));
+    cantFail(Cursor.advance());
+    cantFail(Cursor.EnterSubBlock(BlockID));
+    uint64_t Sum = 0;
+    while (true) {
+      BitstreamEntry Entry = cantFail(Cursor.advance());
+      if (Entry.Kind != BitstreamEntry::Record)
+        break;
+      Vals.clear();
+      cantFail(Cursor.readRecord(Entry.ID, Vals));
+      Sum += Vals[0];
+    }
+    benchmark::DoNotOptimize(Sum);
+  }
+  State.SetItemsProcessed(State.iterations() * NumRecords);
+}
+
+BENCHMARK(BM_BitstreamWrite);
+BENCHMARK(BM_BitstreamRead);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,98 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures multi-threaded string interning throughput of
+// ConcurrentHashTableByPtr backed by a PerThreadBumpPtrAllocator, the building
+// blocks of the parallel DWARFLinker string pool, against a StringSet guarded
+// by a single mutex. Every name is interned several times, as happens when the
+// same symbol or type name shows up in many input files.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/ConcurrentHashtable.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/PerThreadBumpPtrAllocator.h"
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+using StringEntry = StringMapEntry<EmptyStringSetTag>;
+
+namespace {
+class StringEntryInfo {
+public:
+  static inline uint64_t getHashValue(const StringRef &Key) {
+    return xxh3_64bits(Key);
+  }
+
+  static inline bool isEqual(const StringRef &LHS, const StringRef &RHS) {
+    return LHS == RHS;
+  }
+
+  static inline StringRef getKey(const StringEntry &KeyData) {
+    return KeyData.getKey();
+  }
+
+  static inline StringEntry *
+  create(const StringRef &Key, parallel::PerThreadBumpPtrAllocator &Allocator) {
+    return StringEntry::create(Key, Allocator);
+  }
+};
+} // namespace
+
+static constexpr unsigned NumDuplicates = 4;
+
+static std::vector<std::string> makeNames(unsigned N) {
+  std::vector<std::string> Names;
+  Names.reserve(N * NumDuplicates);
+  for (unsigned Dup = 0; Dup != NumDuplicates; ++Dup)
+    for (unsigned I = 0; I != N; ++I)
+      Names.push_back("_ZN4llvm6detail" + std::to_string(I) + "E");
+  return Names;
+}
+
+static void BM_ConcurrentHashTableIntern(benchmark::State &State) {
+  std::vector<std::string> Names = makeNames(State.range(0));
+  for (auto _ : State) {
+    parallel::PerThreadBumpPtrAllocator Allocator;
+    ConcurrentHashTableByPtr<StringRef, StringEntry,
+                             parallel::PerThreadBumpPtrAllocator,
+                             StringEntryInfo>
+        Pool(Allocator, State.range(0));
+    parallelFor(0, Names.size(), [&](size_t I) {
+      benchmark::DoNotOptimize(Pool.insert(Names[I]).first);
+    });
+  }
+  State.SetItemsProcessed(State.iterations() * Names.size());
+}
+
+static void BM_LockedStringSetIntern(benchmark::State &State) {
+  std::vector<std::string> Names = makeNames(State.range(0));
+  for (auto _ : State) {
+    std::mutex Lock;
+    StringSet<> Pool;
+    parallelFor(0, Names.size(), [&](size_t I) {
+      std::lock_guard<std::mutex> Guard(Lock);
+      benchmark::DoNotOptimize(Pool.insert(Names[I]).first->getKey().data());
+    });
+  }
+  State.SetItemsProcessed(State.iterations() * Names.size());
+}
+
+BENCHMARK(BM_ConcurrentHashTableIntern)
+    ->Arg(1 << 12)
+    ->Arg(1 << 18)
+    ->UseRealTime();
+BENCHMARK(BM_LockedStringSetIntern)->Arg(1 << 12)->Arg(1 << 18)->UseRealTime();
+
+BENCHMARK_MAIN();
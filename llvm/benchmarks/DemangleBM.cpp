@@ -0,0 +1,71 @@
+//===- DemangleBM.cpp - Itanium demangler throughput benchmark ------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures the throughput of the Itanium demangler in the two ways tools use
+// it: full demangling as done by llvm-cxxfilt and llvm-nm -C, and partial
+// demangling with a reused ItaniumPartialDemangler as done by LLDB's symbol
+// table indexing.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/Demangle/Demangle.h"
+#include <cstdlib>
+#include <string>
+
+using namespace llvm;
+
+// A mix of plain functions, methods, templates and heavily nested standard
+// library instantiations.
+static const char *const MangledNames[] = {
+    "_Z3fooi",
+    "_ZN4llvm5Value11setNameImplERKNS_5TwineE",
+    "_ZNK4llvm9StringRef4findEcm",
+    "_ZN4llvm11raw_ostreamlsENS_9StringRefE",
+    "_ZNSt6vectorIiSaIiEE9push_backERKi",
+    "_ZN4llvm8DenseMapIPKNS_5ValueEjNS_12DenseMapInfoIS3_vEENS_6detail12"
+    "DenseMapPairIS3_jEEE4growEj",
+    "_ZNSt3__112basic_stringIcNS_11char_traitsIcEENS_9allocatorIcEEEC2ERKS5_",
+    "_ZNSt3__16__treeINS_12__value_typeINS_12basic_stringIcNS_11char_traits"
+    "IcEENS_9allocatorIcEEEEiEENS_19__map_value_compareIS7_S8_NS_4lessIS7_EE"
+    "Lb1EEENS5_IS8_EEE7destroyEPNS_11__tree_nodeIS8_PvEE",
+    "_ZZN4llvm2cl6parserIbE5parseERNS0_6OptionENS_9StringRefES5_RbE1a",
+    "_ZN5clang4Sema13BuildCallExprEPNS_5ScopeEPNS_4ExprENS_14SourceLocation"
+    "EN4llvm15MutableArrayRefIS4_EES5_S4_bb",
+};
+
+static void BM_ItaniumDemangle(benchmark::State &State) {
+  for (auto _ : State) {
+    for (const char *Name : MangledNames) {
+      char *Demangled = itaniumDemangle(Name);
+      benchmark::DoNotOptimize(Demangled);
+      std::free(Demangled);
+    }
+  }
+  State.SetItemsProcessed(State.iterations() * std::size(MangledNames));
+}
+BENCHMARK(BM_ItaniumDemangle);
+
+static void BM_PartialDemangleBaseName(benchmark::State &State) {
+  ItaniumPartialDemangler IPD;
+  char *Buf = nullptr;
+  size_t BufSize = 0;
+  for (auto _ : State) {
+    for (const char *Name : MangledNames) {
+      if (IPD.partialDemangle(Name))
+        continue;
+      Buf = IPD.getFunctionBaseName(Buf, &BufSize);
+      benchmark::DoNotOptimize(Buf);
+    }
+  }
+  std::free(Buf);
+  State.SetItemsProcessed(State.iterations() * std::size(MangledNames));
+}
+BENCHMARK(BM_PartialDemangleBaseName);
+
+BENCHMARK_MAIN();
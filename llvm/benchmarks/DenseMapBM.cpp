@@ -0,0 +1,104 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Compares lookup throughput of the string-keyed maps used for symbol tables
+// (DenseMap<CachedHashStringRef>, StringMap) and of pointer-keyed DenseMaps,
+// for both hits and misses.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/CachedHashString.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+static std::vector<std::string> makeNames(unsigned N,
+                                          const std::string &Prefix) {
+  std::vector<std::string> Names;
+  Names.reserve(N);
+  for (unsigned I = 0; I != N; ++I)
+    Names.push_back(Prefix + "_ZN4llvm6detail" + std::to_string(I) + "E");
+  return Names;
+}
+
+static void BM_DenseMapCachedHashStringLookup(benchmark::State &State) {
+  const unsigned N = State.range(0);
+  std::vector<std::string> Names = makeNames(N, "sym");
+  std::vector<std::string> Misses = makeNames(N, "miss");
+  DenseMap<CachedHashStringRef, unsigned> Map;
+  for (unsigned I = 0; I != N; ++I)
+    Map[CachedHashStringRef(Names[I])] = I;
+
+  // Hash the keys up front, as callers of CachedHashStringRef do.
+  std::vector<CachedHashStringRef> Keys;
+  for (unsigned I = 0; I != N; ++I) {
+    Keys.emplace_back(Names[I]);
+    Keys.emplace_back(Misses[I]);
+  }
+
+  for (auto _ : State) {
+    unsigned Found = 0;
+    for (const CachedHashStringRef &Key : Keys)
+      Found += Map.count(Key);
+    benchmark::DoNotOptimize(Found);
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+static void BM_StringMapLookup(benchmark::State &State) {
+  const unsigned N = State.range(0);
+  std::vector<std::string> Names = makeNames(N, "sym");
+  std::vector<std::string> Misses = makeNames(N, "miss");
+  StringMap<unsigned> Map;
+  for (unsigned I = 0; I != N; ++I)
+    Map[Names[I]] = I;
+
+  std::vector<StringRef> Keys;
+  for (unsigned I = 0; I != N; ++I) {
+    Keys.push_back(Names[I]);
+    Keys.push_back(Misses[I]);
+  }
+
+  for (auto _ : State) {
+    unsigned Found = 0;
+    for (StringRef Key : Keys)
+      Found += Map.count(Key);
+    benchmark::DoNotOptimize(Found);
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+static void BM_DenseMapPointerLookup(benchmark::State &State) {
+  const unsigned N = State.range(0);
+  // Keys are spaced like small heap-allocated objects such as AST nodes.
+  struct Object {
+    alignas(16) char Storage[16];
+  };
+  std::vector<Object> Objects(2 * N);
+  DenseMap<const Object *, unsigned> Map;
+  for (unsigned I = 0; I != N; ++I)
+    Map[&Objects[2 * I]] = I;
+
+  for (auto _ : State) {
+    unsigned Found = 0;
+    for (const Object &Obj : Objects)
+      Found += Map.count(&Obj);
+    benchmark::DoNotOptimize(Found);
+  }
+  State.SetItemsProcessed(State.iterations() * Objects.size());
+}
+
+BENCHMARK(BM_DenseMapCachedHashStringLookup)->Arg(1 << 10)->Arg(1 << 18);
+BENCHMARK(BM_StringMapLookup)->Arg(1 << 10)->Arg(1 << 18);
+BENCHMARK(BM_DenseMapPointerLookup)->Arg(1 << 10)->Arg(1 << 18);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures FoldingSet uniquing, the pattern behind SCEV, SDNode and type
+// uniquing: every lookup profiles a node, and hits are as common as misses.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/FoldingSet.h"
+#include "llvm/Support/Allocator.h"
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+class Node : public FoldingSetNode {
+public:
+  Node(unsigned Opcode, unsigned LHS, unsigned RHS)
+      : Opcode(Opcode), LHS(LHS), RHS(RHS) {}
+
+  static void Profile(FoldingSetNodeID &ID, unsigned Opcode, unsigned LHS,
+                      unsigned RHS) {
+    ID.AddInteger(Opcode);
+    ID.AddInteger(LHS);
+    ID.AddInteger(RHS);
+  }
+  void Profile(FoldingSetNodeID &ID) const { Profile(ID, Opcode, LHS, RHS); }
+
+private:
+  unsigned Opcode, LHS, RHS;
+};
+} // namespace
+
+static void BM_FoldingSetGetOrInsert(benchmark::State &State) {
+  const unsigned N = State.range(0);
+  for (auto _ : State) {
+    BumpPtrAllocator Alloc;
+    FoldingSet<Node> Set;
+    // Each node is requested twice, so half of the lookups hit.
+    for (unsigned I = 0; I != 2 * N; ++I) {
+      unsigned Key = I % N;
+      FoldingSetNodeID ID;
+      Node::Profile(ID, Key % 7, Key, Key * 3);
+      void *InsertPos;
+      if (!Set.FindNodeOrInsertPos(ID, InsertPos))
+        Set.InsertNode(new (Alloc) Node(Key % 7, Key, Key * 3), InsertPos);
+    }
+    benchmark::DoNotOptimize(Set.size());
+  }
+  State.SetItemsProcessed(State.iterations() * 2 * N);
+}
+
+BENCHMARK(BM_FoldingSetGetOrInsert)->Arg(1 << 10)->Arg(1 << 16);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,77 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures raw_ostream formatting of the kinds used by the printers and
+// emitters: integers, hex, padded fields and short strings.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+
+static constexpr unsigned NumValues = 1024;
+
+static void BM_RawOstreamIntegers(benchmark::State &State) {
+  SmallString<0> Buffer;
+  for (auto _ : State) {
+    Buffer.clear();
+    raw_svector_ostream OS(Buffer);
+    for (unsigned I = 0; I != NumValues; ++I)
+      OS << I * 7919 << ' ' << -int64_t(I) << '\n';
+    benchmark::DoNotOptimize(Buffer.data());
+  }
+  State.SetItemsProcessed(State.iterations() * NumValues);
+}
+
+static void BM_RawOstreamHex(benchmark::State &State) {
+  SmallString<0> Buffer;
+  for (auto _ : State) {
+    Buffer.clear();
+    raw_svector_ostream OS(Buffer);
+    for (unsigned I = 0; I != NumValues; ++I)
+      OS << format_hex(uint64_t(I) * 0x9E3779B97F4A7C15ULL, 18) << '\n';
+    benchmark::DoNotOptimize(Buffer.data());
+  }
+  State.SetItemsProcessed(State.iterations() * NumValues);
+}
+
+static void BM_RawOstreamPadded(benchmark::State &State) {
+  SmallString<0> Buffer;
+  for (auto _ : State) {
+    Buffer.clear();
+    raw_svector_ostream OS(Buffer);
+    for (unsigned I = 0; I != NumValues; ++I)
+      OS << left_justify("symbol", 20) << right_justify("text", 8)
+         << format_decimal(I, 10) << '\n';
+    benchmark::DoNotOptimize(Buffer.data());
+  }
+  State.SetItemsProcessed(State.iterations() * NumValues);
+}
+
+static void BM_RawOstreamUnbuffered(benchmark::State &State) {
+  std::string Str;
+  for (auto _ : State) {
+    Str.clear();
+    raw_string_ostream OS(Str);
+    for (unsigned I = 0; I != NumValues; ++I)
+      OS << "name" << I << ", ";
+    benchmark::DoNotOptimize(Str.data());
+  }
+  State.SetItemsProcessed(State.iterations() * NumValues);
+}
+
+BENCHMARK(BM_RawOstreamIntegers);
+BENCHMARK(BM_RawOstreamHex);
+BENCHMARK(BM_RawOstreamPadded);
+BENCHMARK(BM_RawOstreamUnbuffered);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,57 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures SmallVector growth and copying for element counts that fit in the
+// inline storage and for counts that spill to the heap.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/SmallVector.h"
+#include <cstdint>
+
+using namespace llvm;
+
+static void BM_SmallVectorPushBack(benchmark::State &State) {
+  const unsigned N = State.range(0);
+  for (auto _ : State) {
+    SmallVector<uint64_t, 16> Vec;
+    for (unsigned I = 0; I != N; ++I)
+      Vec.push_back(I);
+    benchmark::DoNotOptimize(Vec.data());
+  }
+  State.SetItemsProcessed(State.iterations() * N);
+}
+
+static void BM_SmallVectorPushBackReserved(benchmark::State &State) {
+  const unsigned N = State.range(0);
+  for (auto _ : State) {
+    SmallVector<uint64_t, 16> Vec;
+    Vec.reserve(N);
+    for (unsigned I = 0; I != N; ++I)
+      Vec.push_back(I);
+    benchmark::DoNotOptimize(Vec.data());
+  }
+  State.SetItemsProcessed(State.iterations() * N);
+}
+
+static void BM_SmallVectorCopy(benchmark::State &State) {
+  const unsigned N = State.range(0);
+  SmallVector<uint64_t, 16> Source(N, 42);
+  for (auto _ : State) {
+    SmallVector<uint64_t, 16> Copy(Source);
+    benchmark::DoNotOptimize(Copy.data());
+  }
+  State.SetItemsProcessed(State.iterations() * N);
+}
+
+BENCHMARK(BM_SmallVectorPushBack)->Arg(8)->Arg(1 << 10);
+BENCHMARK(BM_SmallVectorPushBackReserved)->Arg(8)->Arg(1 << 10);
+BENCHMARK(BM_SmallVectorCopy)->Arg(8)->Arg(1 << 10);
+
+BENCHMARK_MAIN();
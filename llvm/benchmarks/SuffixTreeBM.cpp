@@ -0,0 +1,63 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures SuffixTree construction and repeated-substring enumeration, as done
+// by the MachineOutliner over the instruction mapping of a module.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/Support/SuffixTree.h"
+#include <vector>
+
+using namespace llvm;
+
+// A sequence with a small alphabet and a few long repeats, resembling the
+// mapped instruction stream of a module with outlining candidates.
+static std::vector<unsigned> makeString(unsigned N) {
+  std::vector<unsigned> Str;
+  Str.reserve(N);
+  uint32_t Seed = 1;
+  while (Str.size() < N) {
+    Seed = Seed * 1103515245 + 12345;
+    if (Seed % 4 == 0)
+      for (unsigned I = 0; I != 16 && Str.size() < N; ++I)
+        Str.push_back(I);
+    else
+      Str.push_back(Seed % 64);
+  }
+  // Terminate the string with a value outside of the alphabet, as the outliner
+  // does at the end of each basic block.
+  Str.push_back(1000);
+  return Str;
+}
+
+static void BM_SuffixTreeBuild(benchmark::State &State) {
+  std::vector<unsigned> Str = makeString(State.range(0));
+  for (auto _ : State) {
+    SuffixTree ST(Str);
+    benchmark::DoNotOptimize(ST.begin());
+  }
+  State.SetItemsProcessed(State.iterations() * Str.size());
+}
+
+static void BM_SuffixTreeRepeatedSubstrings(benchmark::State &State) {
+  std::vector<unsigned> Str = makeString(State.range(0));
+  SuffixTree ST(Str);
+  for (auto _ : State) {
+    unsigned Count = 0;
+    for (const SuffixTree::RepeatedSubstring &RS : ST)
+      Count += RS.StartIndices.size();
+    benchmark::DoNotOptimize(Count);
+  }
+}
+
+BENCHMARK(BM_SuffixTreeBuild)->Arg(1 << 12)->Arg(1 << 18);
+BENCHMARK(BM_SuffixTreeRepeatedSubstrings)->Arg(1 << 12)->Arg(1 << 18);
+
+BENCHMARK_MAIN();
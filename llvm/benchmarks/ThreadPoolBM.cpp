@@ -0,0 +1,64 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures how fast the thread pool and the parallel:: executor can spawn and
+// retire tiny tasks, which is dominated by scheduling overhead and contention
+// on the task queue.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/ThreadPool.h"
+#include <atomic>
+
+using namespace llvm;
+
+static void BM_ThreadPoolAsync(benchmark::State &State) {
+  const unsigned NumTasks = State.range(0);
+  DefaultThreadPool Pool;
+  std::atomic<unsigned> Counter{0};
+  for (auto _ : State) {
+    for (unsigned I = 0; I != NumTasks; ++I)
+      Pool.async([&] { Counter.fetch_add(1, std::memory_order_relaxed); });
+    Pool.wait();
+  }
+  benchmark::DoNotOptimize(Counter.load());
+  State.SetItemsProcessed(State.iterations() * NumTasks);
+}
+
+static void BM_ThreadPoolGroupAsync(benchmark::State &State) {
+  const unsigned NumTasks = State.range(0);
+  DefaultThreadPool Pool;
+  std::atomic<unsigned> Counter{0};
+  for (auto _ : State) {
+    ThreadPoolTaskGroup Group(Pool);
+    for (unsigned I = 0; I != NumTasks; ++I)
+      Group.async([&] { Counter.fetch_add(1, std::memory_order_relaxed); });
+    Group.wait();
+  }
+  benchmark::DoNotOptimize(Counter.load());
+  State.SetItemsProcessed(State.iterations() * NumTasks);
+}
+
+static void BM_ParallelFor(benchmark::State &State) {
+  const unsigned NumTasks = State.range(0);
+  std::atomic<unsigned> Counter{0};
+  for (auto _ : State)
+    parallelFor(0, NumTasks, [&](size_t) {
+      Counter.fetch_add(1, std::memory_order_relaxed);
+    });
+  benchmark::DoNotOptimize(Counter.load());
+  State.SetItemsProcessed(State.iterations() * NumTasks);
+}
+
+BENCHMARK(BM_ThreadPoolAsync)->Arg(1 << 10)->Arg(1 << 14);
+BENCHMARK(BM_ThreadPoolGroupAsync)->Arg(1 << 10)->Arg(1 << 14);
+BENCHMARK(BM_ParallelFor)->Arg(1 << 10)->Arg(1 << 14);
+
+BENCHMARK_MAIN();
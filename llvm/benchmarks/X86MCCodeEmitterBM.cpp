@@ -0,0 +1,136 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures the throughput of X86MCCodeEmitter::encodeInstruction on a mix of
+// the register-register, register-immediate and register-memory forms that
+// dominate JIT-compiled code.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/MC/MCAsmInfo.h"
+#include "llvm/MC/MCCodeEmitter.h"
+#include "llvm/MC/MCContext.h"
+#include "llvm/MC/MCFixup.h"
+#include "llvm/MC/MCInst.h"
+#include "llvm/MC/MCInstrInfo.h"
+#include "llvm/MC/MCRegisterInfo.h"
+#include "llvm/MC/MCSubtargetInfo.h"
+#include "llvm/MC/MCTargetOptions.h"
+#include "llvm/MC/TargetRegistry.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/TargetParser/Triple.h"
+#include <memory>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+/// Owns the MC layer objects needed to run the x86-64 code emitter.
+struct X86EmitterState {
+  Triple TT{"x86_64-unknown-linux-gnu"};
+  std::unique_ptr<MCRegisterInfo> MRI;
+  std::unique_ptr<MCAsmInfo> MAI;
+  std::unique_ptr<MCSubtargetInfo> STI;
+  std::unique_ptr<MCInstrInfo> MII;
+  std::unique_ptr<MCContext> Ctx;
+  std::unique_ptr<MCCodeEmitter> Emitter;
+  StringMap<unsigned> Opcodes;
+  StringMap<MCRegister> Regs;
+
+  bool init() {
+    LLVMInitializeX86TargetInfo();
+    LLVMInitializeX86TargetMC();
+
+    std::string Error;
+    const Target *TheTarget = TargetRegistry::lookupTarget(TT, Error);
+    if (!TheTarget)
+      return false;
+
+    MRI.reset(TheTarget->createMCRegInfo(TT));
+    MCTargetOptions MCOptions;
+    MAI.reset(TheTarget->createMCAsmInfo(*MRI, TT, MCOptions));
+    STI.reset(TheTarget->createMCSubtargetInfo(TT, "x86-64-v3", ""));
+    MII.reset(TheTarget->createMCInstrInfo());
+    Ctx = std::make_unique<MCContext>(TT, MAI.get(), MRI.get(), STI.get());
+    Emitter.reset(TheTarget->createMCCodeEmitter(*MII, *Ctx));
+
+    // Look opcodes and registers up by name so that the benchmark does not
+    // depend on the target's private generated enums.
+    for (unsigned I = 0, E = MII->getNumOpcodes(); I != E; ++I)
+      Opcodes[MII->getName(I)] = I;
+    for (unsigned I = 1, E = MRI->getNumRegs(); I != E; ++I)
+      Regs[MRI->getName(I)] = I;
+    return Emitter != nullptr;
+  }
+
+  MCInst inst(StringRef Opcode, ArrayRef<MCOperand> Ops) const {
+    MCInst Inst;
+    Inst.setOpcode(Opcodes.lookup(Opcode));
+    for (const MCOperand &Op : Ops)
+      Inst.addOperand(Op);
+    return Inst;
+  }
+
+  MCOperand reg(StringRef Name) const {
+    return MCOperand::createReg(Regs.lookup(Name));
+  }
+};
+
+} // namespace
+
+static MCOperand imm(int64_t Val) { return MCOperand::createImm(Val); }
+
+static std::vector<MCInst> buildInstructionMix(const X86EmitterState &S) {
+  MCOperand NoReg = MCOperand::createReg(MCRegister());
+  return {
+      // addq %rcx, %rax
+      S.inst("ADD64rr", {S.reg("RAX"), S.reg("RAX"), S.reg("RCX")}),
+      // addl $42, %r9d
+      S.inst("ADD32ri", {S.reg("R9D"), S.reg("R9D"), imm(42)}),
+      // movq 8(%rdi), %rsi
+      S.inst("MOV64rm",
+             {S.reg("RSI"), S.reg("RDI"), imm(1), NoReg, imm(8), NoReg}),
+      // movq %r10, -16(%rsp,%r11,8)
+      S.inst("MOV64mr", {S.reg("RSP"), imm(8), S.reg("R11"), imm(-16), NoReg,
+                         S.reg("R10")}),
+      // leaq 4(%rax,%rbx,2), %rdx
+      S.inst("LEA64r",
+             {S.reg("RDX"), S.reg("RAX"), imm(2), S.reg("RBX"), imm(4), NoReg}),
+      // vaddps %ymm2, %ymm1, %ymm0
+      S.inst("VADDPSYrr", {S.reg("YMM0"), S.reg("YMM1"), S.reg("YMM2")}),
+  };
+}
+
+static void BM_X86EncodeInstructions(benchmark::State &State) {
+  X86EmitterState S;
+  if (!S.init()) {
+    State.SkipWithError("X86 target not available");
+    return;
+  }
+  std::vector<MCInst> Insts = buildInstructionMix(S);
+
+  SmallVector<char, 256> Code;
+  SmallVector<MCFixup, 4> Fixups;
+  for (auto _ : State) {
+    Code.clear();
+    for (const MCInst &Inst : Insts) {
+      Fixups.clear();
+      S.Emitter->encodeInstruction(Inst, Code, Fixups, *S.STI);
+    }
+    benchmark::DoNotOptimize(Code.data());
+  }
+  State.SetItemsProcessed(State.iterations() * Insts.size());
+}
+
+BENCHMARK(BM_X86EncodeInstructions);
+
+BENCHMARK_MAIN();
@@ -212,7 +212,8 @@ private:
   Factory *factory;
   ImutAVLTree *left;
   ImutAVLTree *right;
-  ImutAVLTree *prev = nullptr;
+  /// The next canonical tree with the same digest. Digest collisions are
+  /// rare, so the chain is singly linked to keep the nodes small.
   ImutAVLTree *next = nullptr;
 
   unsigned height : 28;
@@ -335,13 +336,13 @@ public:
     if (right)
       right->release();
     if (IsCanonicalized) {
-      if (next)
-        next->prev = prev;
-
-      if (prev)
-        prev->next = next;
-      else
-        factory->Cache[factory->maskCacheIndex(computeDigest())] = next;
+      ImutAVLTree **Link =
+          &factory->Cache[factory->maskCacheIndex(computeDigest())];
+      while (*Link != this) {
+        assert(*Link && "Canonical tree is missing from the cache");
+        Link = &(*Link)->next;
+      }
+      *Link = next;
     }
 
     // We need to clear the mutability bit in case we are
@@ -648,7 +649,6 @@ public:
           TNew->destroy();
         return T;
       }
-      entry->prev = TNew;
       TNew->next = entry;
     }
 
@@ -269,6 +269,11 @@ public:
   using AliasCacheT = SmallDenseMap<LocPair, CacheEntry, 8>;
   AliasCacheT AliasCache;
 
+  /// Underlying objects of the pointers queried so far. Batched queries often
+  /// compare one location against many others, so this avoids walking the
+  /// same pointer's chain of GEPs and casts for every one of them.
+  SmallDenseMap<const Value *, const Value *, 4> UnderlyingObjects;
+
   CaptureAnalysis *CA;
 
   /// Query depth used to distinguish recursive queries.
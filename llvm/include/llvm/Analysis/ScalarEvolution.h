@@ -1503,6 +1503,10 @@ private:
   /// This is a cache of the values we have analyzed so far.
   ValueExprMapType ValueExprMap;
 
+  /// The number of instructions SCEVs have been built for, which is limited
+  /// by -scalar-evolution-max-analyzed-values.
+  unsigned NumValuesAnalyzed = 0;
+
   /// This is a cache for expressions that got folded to a different existing
   /// SCEV.
   DenseMap<FoldID, const SCEV *> FoldCache;
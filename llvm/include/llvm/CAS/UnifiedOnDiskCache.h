@@ -127,10 +127,14 @@ public:
   ///
   /// It is recommended that garbage-collection is triggered concurrently in the
   /// background, so that it has minimal effect on the workload of the process.
-  static Error collectGarbage(StringRef Path);
+  ///
+  /// \param ReclaimedBytes if not null, set to the total size of the files that
+  /// were removed.
+  static Error collectGarbage(StringRef Path,
+                              uint64_t *ReclaimedBytes = nullptr);
 
   /// Remove unused data from the current UnifiedOnDiskCache.
-  Error collectGarbage();
+  Error collectGarbage(uint64_t *ReclaimedBytes = nullptr);
 
   /// Helper function to convert the value stored in KeyValueDB and ObjectID.
   static ObjectID getObjectIDFromValue(ArrayRef<char> Value);
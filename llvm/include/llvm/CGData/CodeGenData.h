@@ -115,7 +115,8 @@ class CodeGenData {
   /// Global stable function map that has stable function info across modules.
   std::unique_ptr<StableFunctionMap> PublishedStableFunctionMap;
 
-  /// This flag is set when -fcodegen-data-generate is passed.
+  /// This flag is set when -fcodegen-data-generate is passed, also when
+  /// codegen data from a previous build is read with -fcodegen-data-use-path.
   /// Or, it can be mutated with -fcodegen-data-thinlto-two-rounds.
   bool EmitCGData;
 
@@ -14,6 +14,8 @@
 #ifndef LLVM_CODEGEN_SELECTIONDAGISEL_H
 #define LLVM_CODEGEN_SELECTIONDAGISEL_H
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/CodeGen/MachineFunctionPass.h"
 #include "llvm/CodeGen/MachinePassManager.h"
@@ -534,6 +536,14 @@ private:
   /// state machines that start with a OPC_SwitchOpcode node.
   std::vector<unsigned> OpcodeOffset;
 
+  /// SwitchOpcodeCases - Cache of the cases of the OPC_SwitchOpcode nodes
+  /// nested in the state machine, keyed by the index of the node. Large
+  /// switches are decoded into a list of (opcode, case index) pairs sorted by
+  /// opcode, so they can be binary searched instead of scanned. The list is
+  /// left empty for small switches, which are cheaper to scan.
+  DenseMap<unsigned, SmallVector<std::pair<uint16_t, unsigned>, 0>>
+      SwitchOpcodeCases;
+
   void UpdateChains(SDNode *NodeToMatch, SDValue InputChain,
                     SmallVectorImpl<SDNode *> &ChainNodesMatched,
                     bool isMorphNodeTo);
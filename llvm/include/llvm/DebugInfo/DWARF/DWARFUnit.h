@@ -489,6 +489,11 @@ public:
   Expected<DWARFLocationExpressionsVector>
   findLoclistFromOffset(uint64_t Offset);
 
+  /// Clear parsed DIEs to keep memory usage low. They are extracted again the
+  /// next time they are needed. This invalidates all DWARFDie handles into
+  /// this unit, including the one for the unit DIE when \p KeepCUDie is set.
+  LLVM_ABI void clearDIEs(bool KeepCUDie);
+
   /// Returns subprogram DIE with address range encompassing the provided
   /// address. The pointer is alive as long as parsed compile unit DIEs are not
   /// cleared.
@@ -588,9 +593,6 @@ private:
   void extractDIEsToVector(bool AppendCUDie, bool AppendNonCUDIEs,
                            std::vector<DWARFDebugInfoEntry> &DIEs) const;
 
-  /// clearDIEs - Clear parsed DIEs to keep memory usage low.
-  void clearDIEs(bool KeepCUDie);
-
   /// parseDWO - Parses .dwo file for current compile unit. Returns true if
   /// it was actually constructed.
   /// The \p AlternativeLocation specifies an alternative location to get
@@ -0,0 +1,69 @@
+//===--- OnDiskObjectCache.h - Persistent object cache for ORC --*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// An ObjectCache that persists compiled objects in a directory so that they
+// can be reused across process restarts.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_ONDISKOBJECTCACHE_H
+#define LLVM_EXECUTIONENGINE_ORC_ONDISKOBJECTCACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/Support/Compiler.h"
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace llvm {
+
+class TargetMachine;
+
+namespace orc {
+
+/// Stores compiled objects in a directory, keyed by a hash of the module's
+/// bitcode and a target key. Unlike identifier-based caches, a module is only
+/// matched when its IR is identical, so the cache can be shared by unrelated
+/// processes and survives restarts.
+///
+/// Pass an instance to SimpleCompiler or ConcurrentIRCompiler to skip codegen
+/// for modules that were compiled before.
+class LLVM_ABI OnDiskObjectCache : public ObjectCache {
+public:
+  /// Creates a cache that stores objects under \p CacheDir. \p TargetKey must
+  /// describe everything besides the IR that affects the generated code; see
+  /// getTargetKey().
+  OnDiskObjectCache(std::string CacheDir, std::string TargetKey)
+      : CacheDir(std::move(CacheDir)), TargetKey(std::move(TargetKey)) {}
+
+  /// Returns a key describing the triple, CPU, features, optimization level,
+  /// relocation model and code model of \p TM.
+  static std::string getTargetKey(const TargetMachine &TM);
+
+  void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override;
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override;
+
+  /// Returns the path of the cache entry for \p M.
+  std::string getCachePath(const Module &M) const;
+
+private:
+  std::string CacheDir;
+  std::string TargetKey;
+
+  // Cache paths computed by getObject for modules that missed, keyed by the
+  // module. The compiler runs codegen IR passes on the module before calling
+  // notifyObjectCompiled, so its key has to be taken before compilation.
+  std::mutex PendingPathsMutex;
+  DenseMap<const Module *, std::string> PendingPaths;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_ONDISKOBJECTCACHE_H
@@ -18,6 +18,7 @@
 #include "llvm/ExecutionEngine/Orc/RedirectionManager.h"
 #include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
 #include "llvm/IR/IRBuilder.h"
+#include "llvm/Passes/OptimizationLevel.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
 #include "llvm/Transforms/Utils/Cloning.h"
@@ -79,6 +80,16 @@ public:
                                         unsigned CurVersion,
                                         ThreadSafeModule &TSM);
 
+  /// Returns an AddProfilerFunc that requests reoptimization once any function
+  /// in the module has been called \p Threshold times.
+  static AddProfilerFunc reoptimizeAfterCalls(uint64_t Threshold);
+
+  /// Returns a ReOptimizeFunc that runs the default module pipeline for
+  /// \p Level on the new version. Paired with a base layer that compiles
+  /// quickly, this gives a two-tier JIT: cheap code first, optimized code for
+  /// the functions that turn out to be hot.
+  static ReOptimizeFunc optimizeWithPipeline(OptimizationLevel Level);
+
   static Error identity(ReOptimizeLayer &Parent,
                         ReOptMaterializationUnitID MUID, unsigned CurVersion,
                         ResourceTrackerSP OldRT, ThreadSafeModule &TSM) {
@@ -148,6 +159,10 @@ private:
   void rt_reoptimize(SendErrorFn SendResult, ReOptMaterializationUnitID MUID,
                      uint32_t CurVersion);
 
+  static Error addCallCountProfiler(ReOptMaterializationUnitID MUID,
+                                    unsigned CurVersion, ThreadSafeModule &TSM,
+                                    uint64_t Threshold);
+
   static Expected<Constant *>
   createReoptimizeArgBuffer(Module &M, ReOptMaterializationUnitID MUID,
                             uint32_t CurVersion);
@@ -131,6 +131,7 @@ private:
 
   Error readBytes(char *Dst, size_t Size, bool *IsEOF = nullptr);
   int writeBytes(const char *Src, size_t Size);
+  int writeMessage(const char *Header, ArrayRef<char> ArgBytes);
   void listenLoop();
 
   std::mutex M;
@@ -23,6 +23,7 @@
 #include <string>
 
 #if LLVM_ENABLE_THREADS
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <mutex>
@@ -126,15 +127,46 @@ public:
 
 class LLVM_ABI DynamicThreadPoolTaskDispatcher : public TaskDispatcher {
 public:
+  /// Counters describing how long tasks sat in one of the dispatcher's queues
+  /// before a thread became available for them.
+  struct QueueStats {
+    /// Number of tasks that had to be queued.
+    size_t NumQueued = 0;
+    /// Largest number of tasks waiting at the same time.
+    size_t MaxQueueLength = 0;
+    /// Total and longest time between dispatch and start of a queued task.
+    std::chrono::nanoseconds TotalWait{0};
+    std::chrono::nanoseconds MaxWait{0};
+  };
+
   DynamicThreadPoolTaskDispatcher(
       std::optional<size_t> MaxMaterializationThreads)
       : MaxMaterializationThreads(MaxMaterializationThreads) {}
 
   void dispatch(std::unique_ptr<Task> T) override;
   void shutdown() override;
+
+  /// Queueing statistics for materialization tasks, which only wait when
+  /// MaxMaterializationThreads is reached.
+  QueueStats getMaterializationQueueStats();
+
+  /// Queueing statistics for idle tasks.
+  QueueStats getIdleQueueStats();
+
 private:
+  using ClockType = std::chrono::steady_clock;
+
+  struct QueuedTask {
+    std::unique_ptr<Task> T;
+    ClockType::time_point Enqueued;
+  };
+
   bool canRunMaterializationTaskNow();
   bool canRunIdleTaskNow();
+  void enqueue(std::deque<QueuedTask> &Queue, QueueStats &Stats,
+               std::unique_ptr<Task> T);
+  std::unique_ptr<Task> dequeue(std::deque<QueuedTask> &Queue,
+                                QueueStats &Stats);
 
   std::mutex DispatchMutex;
   bool Shutdown = false;
@@ -143,8 +175,10 @@ private:
 
   std::optional<size_t> MaxMaterializationThreads;
   size_t NumMaterializationThreads = 0;
-  std::deque<std::unique_ptr<Task>> MaterializationTaskQueue;
-  std::deque<std::unique_ptr<Task>> IdleTaskQueue;
+  std::deque<QueuedTask> MaterializationTaskQueue;
+  std::deque<QueuedTask> IdleTaskQueue;
+  QueueStats MaterializationStats;
+  QueueStats IdleStats;
 };
 
 #endif // LLVM_ENABLE_THREADS
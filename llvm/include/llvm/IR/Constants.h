@@ -100,6 +100,11 @@ class ConstantInt final : public ConstantData {
   static ConstantInt *get(LLVMContext &Context, ElementCount EC,
                           const APInt &V);
 
+  /// Return the uniqued ConstantInt for V. Ty is the integer type for the bit
+  /// width of V if the caller already has it, or null.
+  static ConstantInt *getImpl(LLVMContext &Context, IntegerType *Ty,
+                              const APInt &V);
+
 public:
   ConstantInt(const ConstantInt &) = delete;
 
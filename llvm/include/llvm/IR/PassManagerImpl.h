@@ -167,11 +167,17 @@ inline void AnalysisManager<IRUnitT, ExtraArgTs...>::invalidate(
   if (PA.allAnalysesInSetPreserved<AllAnalysesOn<IRUnitT>>())
     return;
 
+  // Nothing to do if no results are cached for this IR unit. Avoid creating
+  // (and then erasing) an empty list for it.
+  auto ResultsListI = AnalysisResultLists.find(&IR);
+  if (ResultsListI == AnalysisResultLists.end())
+    return;
+
   // Track whether each analysis's result is invalidated in
   // IsResultInvalidated.
   SmallDenseMap<AnalysisKey *, bool, 8> IsResultInvalidated;
   Invalidator Inv(IsResultInvalidated, AnalysisResults);
-  AnalysisResultListT &ResultsList = AnalysisResultLists[&IR];
+  AnalysisResultListT &ResultsList = ResultsListI->second;
   for (auto &AnalysisResultPair : ResultsList) {
     // This is basically the same thing as Invalidator::invalidate, but we
     // can't call it here because we're operating on the type-erased result.
@@ -199,6 +205,8 @@ inline void AnalysisManager<IRUnitT, ExtraArgTs...>::invalidate(
 
   // Now erase the results that were marked above as invalidated.
   if (!IsResultInvalidated.empty()) {
+    // PassInstrumentation is never invalidated, so it can be looked up once.
+    auto *PI = getCachedResult<PassInstrumentationAnalysis>(IR);
     for (auto I = ResultsList.begin(), E = ResultsList.end(); I != E;) {
       AnalysisKey *ID = I->first;
       if (!IsResultInvalidated.lookup(ID)) {
@@ -206,7 +214,7 @@ inline void AnalysisManager<IRUnitT, ExtraArgTs...>::invalidate(
         continue;
       }
 
-      if (auto *PI = getCachedResult<PassInstrumentationAnalysis>(IR))
+      if (PI)
         PI->runAnalysisInvalidated(this->lookUpPass(ID), IR);
 
       I = ResultsList.erase(I);
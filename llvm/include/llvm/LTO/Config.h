@@ -127,6 +127,11 @@ struct Config {
   /// Name remapping file for profile data.
   std::string ProfileRemapping;
 
+  /// Attribute to apply to functions that the profile identifies as cold, so
+  /// that they take the size-oriented paths through the optimization
+  /// pipeline.
+  PGOOptions::ColdFuncOpt PGOColdFuncOpt = PGOOptions::ColdFuncOpt::Default;
+
   /// The directory to store .dwo files.
   std::string DwoDir;
 
@@ -103,9 +103,9 @@ private:
   bool fixupNeedsRelaxation(const MCFragment &, const MCFixup &) const;
 
   void layoutSection(MCSection &Sec);
-  /// Perform one layout iteration and return the index of the first stable
-  /// section for subsequent optimization.
-  unsigned relaxOnce(unsigned FirstStable);
+  /// Perform one layout iteration over \p Secs and return the index of the
+  /// first stable section for subsequent optimization.
+  unsigned relaxOnce(ArrayRef<MCSection *> Secs, unsigned FirstStable);
 
   /// Perform relaxation on a single fragment.
   bool relaxFragment(MCFragment &F);
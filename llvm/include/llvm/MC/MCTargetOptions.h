@@ -82,6 +82,11 @@ public:
   // Whether to compress DWARF debug sections.
   DebugCompressionType CompressDebugSections = DebugCompressionType::None;
 
+  // Whether large zstd-compressed debug sections may be compressed as shards
+  // on the parallel:: thread pool. Off by default, since compilers are usually
+  // run many at a time; standalone tools that own the machine can enable it.
+  bool ParallelCompressDebugSections = false;
+
   std::string ABIName;
   std::string AssemblyLanguage;
   std::string SplitDwarfFile;
@@ -111,6 +111,13 @@ public:
   void clear() {
     Descriptors.clear();
     VariantDescriptors.clear();
+    resetState();
+  }
+
+  /// Reset the state that is tracked per code region. Unlike clear(), this
+  /// keeps the cached descriptors, which only depend on the subtarget and the
+  /// instruments, so that they can be reused by the next region.
+  void resetState() {
     FirstCallInst = true;
     FirstReturnInst = true;
   }
@@ -15,6 +15,7 @@
 #ifndef LLVM_PASSES_STANDARDINSTRUMENTATIONS_H
 #define LLVM_PASSES_STANDARDINSTRUMENTATIONS_H
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
@@ -31,6 +32,7 @@
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Transforms/IPO/SampleProfileProbe.h"
 
+#include <map>
 #include <string>
 #include <utility>
 
@@ -474,6 +476,9 @@ protected:
 
 class VerifyInstrumentation {
   bool DebugLogging;
+  // The number of passes after which verification was considered, for
+  // -verify-each-interval.
+  uint64_t NumPassesSeen = 0;
 
 public:
   VerifyInstrumentation(bool DebugLogging) : DebugLogging(DebugLogging) {}
@@ -594,6 +599,45 @@ private:
   static void SignalHandler(void *);
 };
 
+/// This class implements --analysis-invalidation-report. For every pass it
+/// records how often it ran and changed the IR, which analyses it invalidated,
+/// and how many of those analyses later had to be computed again on the same
+/// IR unit. The statistics are written as JSON when the object is destroyed.
+class AnalysisInvalidationReporter {
+public:
+  AnalysisInvalidationReporter(bool Enabled) : Enabled(Enabled) {}
+  LLVM_ABI ~AnalysisInvalidationReporter();
+  // We intend this to be unique per-compilation, thus no copies.
+  AnalysisInvalidationReporter(const AnalysisInvalidationReporter &) = delete;
+  void operator=(const AnalysisInvalidationReporter &) = delete;
+
+  LLVM_ABI void registerCallbacks(PassInstrumentationCallbacks &PIC);
+
+  /// Write the statistics collected so far as JSON to \p OS.
+  LLVM_ABI void writeReport(raw_ostream &OS) const;
+
+private:
+  struct PassStats {
+    unsigned Runs = 0;
+    unsigned Changed = 0;
+    std::map<std::string, unsigned> Invalidated;
+    std::map<std::string, unsigned> Recomputed;
+  };
+
+  void runBeforePass(StringRef PassID);
+  void runAfterPass(const PreservedAnalyses &PA);
+  void runAnalysisInvalidated(StringRef AnalysisID, Any IR);
+  void runBeforeAnalysis(StringRef AnalysisID, Any IR);
+
+  bool Enabled;
+  /// Statistics by pass name, ordered for a stable report.
+  std::map<std::string, PassStats> Stats;
+  /// The passes that are currently running, innermost last.
+  SmallVector<PassStats *, 8> PassStack;
+  /// The pass that last invalidated an analysis on an IR unit.
+  DenseMap<std::pair<StringRef, const void *>, PassStats *> InvalidatedBy;
+};
+
 /// This class provides an interface to register all the standard pass
 /// instrumentations and manages their state (if any).
 class StandardInstrumentations {
@@ -612,6 +656,7 @@ class StandardInstrumentations {
   IRChangedTester ChangeTester;
   VerifyInstrumentation Verify;
   DroppedVariableStatsIR DroppedStatsIR;
+  AnalysisInvalidationReporter InvalidationReporter;
 
   bool VerifyEach;
 
@@ -762,6 +762,10 @@ private:
   StringRef VTableName;
   /// A memory buffer holding binary ids.
   ArrayRef<uint8_t> BinaryIdsBuffer;
+  /// The encoded temporal profile traces. They are only decoded when first
+  /// requested, since compilers reading the profile never need them.
+  const unsigned char *TemporalProfTracesPtr = nullptr;
+  uint64_t NumTemporalProfTraces = 0;
 
   // Index to the current record in the record array.
   unsigned RecordIndex = 0;
@@ -888,6 +892,12 @@ public:
   // the client is the compiler.
   InstrProfSymtab &getSymtab() override;
 
+  SmallVector<TemporalProfTraceTy> &
+  getTemporalProfTraces(std::optional<uint64_t> Weight = {}) override;
+
+  /// Decode the temporal profile traces if that hasn't been done yet.
+  Error readTemporalProfTraces();
+
   /// Return the profile summary.
   /// \c UseCS indicates whether to use the context-sensitive summary.
   ProfileSummary &getSummary(bool UseCS) {
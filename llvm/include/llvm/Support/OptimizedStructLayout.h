@@ -36,6 +36,7 @@
 #define LLVM_SUPPORT_OPTIMIZEDSTRUCTLAYOUT_H
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/Support/Alignment.h"
 #include "llvm/Support/Compiler.h"
 #include <utility>
@@ -139,6 +140,19 @@ struct OptimizedStructLayoutField {
 LLVM_ABI std::pair<uint64_t, Align> performOptimizedStructLayout(
     MutableArrayRef<OptimizedStructLayoutField> Fields);
 
+/// Compute a layout like performOptimizedStructLayout, but start with the
+/// flexible-offset fields for which \p IsHot returns true, e.g. because an
+/// access profile shows them to be frequently accessed.  The hot fields are
+/// packed ahead of all other flexible-offset fields so that they occupy as
+/// few cache lines as possible; cold fields are only placed into padding
+/// between hot fields, or after them.
+///
+/// The same requirements on fixed-offset fields and the same guarantees on
+/// return apply as for performOptimizedStructLayout.
+LLVM_ABI std::pair<uint64_t, Align> performHotColdStructLayout(
+    MutableArrayRef<OptimizedStructLayoutField> Fields,
+    function_ref<bool(const OptimizedStructLayoutField &)> IsHot);
+
 } // namespace llvm
 
 #endif
@@ -75,6 +75,12 @@ public:
   /// allocated space.
   LLVM_ABI static size_t GetMallocUsage();
 
+  /// Return the amount of memory the malloc implementation has obtained from
+  /// the operating system, including memory it keeps cached for reuse. The
+  /// difference to GetMallocUsage() approximates allocator fragmentation.
+  /// Returns 0 if this cannot be determined on the host.
+  LLVM_ABI static size_t GetMallocReservedSize();
+
   /// This static function will set \p user_time to the amount of CPU time
   /// spent in user (non-kernel) mode and \p sys_time to the amount of CPU
   /// time spent in system (kernel) mode.  If the operating system does not
@@ -171,6 +171,8 @@ private:
       // Don't allow enqueueing after disabling the pool
       assert(EnableFlag && "Queuing a thread during ThreadPool destruction");
       Tasks.emplace_back(std::make_pair(std::move(Task), Group));
+      if (Group != nullptr)
+        ++PendingGroups[Group]; // Increment or set to 1 if new item
       requestedThreads = ActiveThreads + Tasks.size();
     }
     QueueCondition.notify_one();
@@ -202,8 +204,11 @@ private:
 
   /// Keep track of the number of thread actually busy
   unsigned ActiveThreads = 0;
-  /// Number of threads active for tasks in the given group (only non-zero).
-  DenseMap<ThreadPoolTaskGroup *, unsigned> ActiveGroups;
+  /// Number of queued or running tasks in the given group (only non-zero).
+  /// Counted separately from ActiveThreads, which would never be 0 if waiting
+  /// for another group inside a wait, and kept up to date on enqueue so that
+  /// checking a group for completion does not have to scan the whole queue.
+  DenseMap<ThreadPoolTaskGroup *, unsigned> PendingGroups;
 
   /// Signal for the destruction of the pool, asking thread to exit.
   bool EnableFlag = true;
@@ -154,6 +154,7 @@ using once_flag = std::once_flag;
   /// strategy, we attempt to equally allocate the threads on all CPU sockets.
   /// "0" or an empty string will return the \p Default strategy.
   /// "all" for using all hardware threads.
+  /// "jobserver" for sharing the job slots of a GNU Make jobserver.
   LLVM_ABI std::optional<ThreadPoolStrategy>
   get_threadpool_strategy(StringRef Num, ThreadPoolStrategy Default = {});
 
@@ -18,6 +18,7 @@
 #include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Errc.h"
@@ -31,6 +32,7 @@
 #include <cstdint>
 #include <ctime>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <system_error>
@@ -1205,6 +1207,49 @@ protected:
                  unsigned IndentLevel) const override;
 };
 
+/// File system that remembers which paths the underlying file system reported
+/// as missing, and answers later \c status, \c exists and \c openFileForRead
+/// queries for them without calling into it again. Header search probes the
+/// same non-existent candidate paths over and over, which is expensive on
+/// network file systems.
+///
+/// Only \c errc::no_such_file_or_directory results are cached, keyed by the
+/// absolute path. The cache assumes files are not created behind its back;
+/// call \c clearCache if they might be.
+class LLVM_ABI NegativeLookupCacheFileSystem
+    : public llvm::RTTIExtends<NegativeLookupCacheFileSystem, ProxyFileSystem> {
+public:
+  static const char ID;
+
+  NegativeLookupCacheFileSystem(
+      llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> FS)
+      : RTTIExtends(std::move(FS)) {}
+
+  ErrorOr<Status> status(const Twine &Path) override;
+  bool exists(const Twine &Path) override;
+  ErrorOr<std::unique_ptr<File>> openFileForRead(const Twine &Path) override;
+
+  /// Forget all cached misses.
+  void clearCache();
+
+  /// Number of lookups answered from the cache.
+  std::size_t getNumCacheHits() const;
+
+protected:
+  void printImpl(raw_ostream &OS, PrintType Type,
+                 unsigned IndentLevel) const override;
+
+private:
+  /// Returns true if \p Path is known to be missing. \p AbsPath is set to the
+  /// cache key for \p Path, or left empty if it cannot be made absolute.
+  bool isKnownMissing(const Twine &Path, SmallVectorImpl<char> &AbsPath);
+  void recordMissing(StringRef AbsPath);
+
+  mutable std::mutex Mutex;
+  StringSet<> Missing;
+  std::size_t NumCacheHits = 0;
+};
+
 } // namespace vfs
 } // namespace llvm
 
@@ -48,6 +48,10 @@ public:
 /// is no callback was applied.
 bool ApplyCallback(const RecordKeeper &Records, raw_ostream &OS);
 
+/// Returns the callback registered for the command line option \p Name (given
+/// without the leading dash), or a null callback if there is no such option.
+FnT getCallback(StringRef Name);
+
 } // namespace TableGen::Emitter
 
 /// emitSourceFileHeader - Output an LLVM style file header to the specified
@@ -1613,8 +1613,14 @@ AliasResult BasicAAResult::aliasCheck(const Value *V1, LocationSize V1Size,
     return AliasResult::MustAlias;
 
   // Figure out what objects these things are pointing to if we can.
-  const Value *O1 = getUnderlyingObject(V1, MaxLookupSearchDepth);
-  const Value *O2 = getUnderlyingObject(V2, MaxLookupSearchDepth);
+  auto GetUnderlyingObject = [&](const Value *V) {
+    auto [It, Inserted] = AAQI.UnderlyingObjects.try_emplace(V);
+    if (Inserted)
+      It->second = getUnderlyingObject(V, MaxLookupSearchDepth);
+    return It->second;
+  };
+  const Value *O1 = GetUnderlyingObject(V1);
+  const Value *O2 = GetUnderlyingObject(V2);
 
   // Null values in the default address space don't point to any object, so they
   // don't alias any other pointer.
@@ -143,6 +143,8 @@ STATISTIC(NumExitCountsNotComputed,
           "Number of loop exits without predictable exit counts");
 STATISTIC(NumBruteForceTripCountsComputed,
           "Number of loops with trip counts computed by force");
+STATISTIC(NumValuesLeftUnanalyzed,
+          "Number of values treated as unknown after exceeding the budget");
 
 #ifdef EXPENSIVE_CHECKS
 bool llvm::VerifySCEV = true;
@@ -218,6 +220,13 @@ static cl::opt<unsigned>
                   cl::desc("Size of the expression which is considered huge"),
                   cl::init(4096));
 
+static cl::opt<unsigned> MaxAnalyzedValues(
+    "scalar-evolution-max-analyzed-values", cl::Hidden,
+    cl::desc("Maximum number of instructions to build SCEVs for in a "
+             "function, after which new ones are treated as unknown "
+             "(0 = unlimited)"),
+    cl::init(0));
+
 static cl::opt<unsigned> RangeIterThreshold(
     "scev-range-iter-threshold", cl::Hidden,
     cl::desc("Threshold for switching to iteratively computing SCEV ranges"),
@@ -7525,6 +7534,14 @@ const SCEV *ScalarEvolution::createSCEVIter(Value *V) {
   using PointerTy = PointerIntPair<Value *, 1, bool>;
   SmallVector<PointerTy> Stack;
 
+  // Instructions that count against -scalar-evolution-max-analyzed-values.
+  // Unreachable ones and ones of non-SCEVable type are never analyzed.
+  auto IsBudgeted = [&](Value *V) {
+    auto *I = dyn_cast<Instruction>(V);
+    return I && isSCEVable(I->getType()) &&
+           DT.isReachableFromEntry(I->getParent());
+  };
+
   Stack.emplace_back(V, true);
   Stack.emplace_back(V, false);
   while (!Stack.empty()) {
@@ -7534,6 +7551,15 @@ const SCEV *ScalarEvolution::createSCEVIter(Value *V) {
     if (getExistingSCEV(CurV))
       continue;
 
+    // Once the budget for this function is used up, degrade gracefully by
+    // treating further instructions as opaque values.
+    if (MaxAnalyzedValues && NumValuesAnalyzed >= MaxAnalyzedValues &&
+        IsBudgeted(CurV)) {
+      ++NumValuesLeftUnanalyzed;
+      insertValueToMap(CurV, getUnknown(CurV));
+      continue;
+    }
+
     SmallVector<Value *> Ops;
     const SCEV *CreatedSCEV = nullptr;
     // If all operands have been visited already, create the SCEV.
@@ -7548,6 +7574,8 @@ const SCEV *ScalarEvolution::createSCEVIter(Value *V) {
 
     if (CreatedSCEV) {
       insertValueToMap(CurV, CreatedSCEV);
+      if (MaxAnalyzedValues && IsBudgeted(CurV))
+        ++NumValuesAnalyzed;
     } else {
       // Queue CurV for SCEV creation, followed by its's operands which need to
       // be constructed first.
@@ -13764,6 +13792,7 @@ ScalarEvolution::ScalarEvolution(ScalarEvolution &&Arg)
     : F(Arg.F), DL(Arg.DL), HasGuards(Arg.HasGuards), TLI(Arg.TLI), AC(Arg.AC),
       DT(Arg.DT), LI(Arg.LI), CouldNotCompute(std::move(Arg.CouldNotCompute)),
       ValueExprMap(std::move(Arg.ValueExprMap)),
+      NumValuesAnalyzed(Arg.NumValuesAnalyzed),
       PendingLoopPredicates(std::move(Arg.PendingLoopPredicates)),
       PendingPhiRanges(std::move(Arg.PendingPhiRanges)),
       PendingMerges(std::move(Arg.PendingMerges)),
@@ -7067,14 +7067,21 @@ Error BitcodeReader::materialize(GlobalValue *GV) {
     }
 
     if (auto *CI = dyn_cast<CallBase>(&I)) {
-      // Remove incompatible attributes on function calls.
-      CI->removeRetAttrs(AttributeFuncs::typeIncompatible(
-          CI->getFunctionType()->getReturnType(), CI->getRetAttributes()));
-
-      for (unsigned ArgNo = 0; ArgNo < CI->arg_size(); ++ArgNo)
-        CI->removeParamAttrs(ArgNo, AttributeFuncs::typeIncompatible(
-                                        CI->getArgOperand(ArgNo)->getType(),
-                                        CI->getParamAttributes(ArgNo)));
+      // Remove incompatible attributes on function calls. Most call sites
+      // carry no attributes at all, so don't build masks for them.
+      if (!CI->getAttributes().isEmpty()) {
+        if (AttributeSet RetAttrs = CI->getRetAttributes();
+            RetAttrs.hasAttributes())
+          CI->removeRetAttrs(AttributeFuncs::typeIncompatible(
+              CI->getFunctionType()->getReturnType(), RetAttrs));
+
+        for (unsigned ArgNo = 0; ArgNo < CI->arg_size(); ++ArgNo)
+          if (AttributeSet ParamAttrs = CI->getParamAttributes(ArgNo);
+              ParamAttrs.hasAttributes())
+            CI->removeParamAttrs(
+                ArgNo, AttributeFuncs::typeIncompatible(
+                           CI->getArgOperand(ArgNo)->getType(), ParamAttrs));
+      }
 
       // Upgrade intrinsics.
       if (Function *OldFn = CI->getCalledFunction()) {
@@ -5350,8 +5350,10 @@ void ModuleBitcodeWriter::write() {
 
   Stream.EnterSubblock(bitc::MODULE_BLOCK_ID, 3);
   // We will want to write the module hash at this point. Block any flushing so
-  // we can have access to the whole underlying data later.
-  Stream.markAndBlockFlushing();
+  // we can have access to the whole underlying data later. Without a hash the
+  // stream may keep flushing, so large modules are not held in memory whole.
+  if (GenerateHash)
+    Stream.markAndBlockFlushing();
 
   writeModuleVersion();
 
@@ -5402,7 +5404,8 @@ void ModuleBitcodeWriter::write() {
 
   writeGlobalValueSymbolTable(FunctionToBitcodeIndex);
 
-  writeModuleHash(Stream.getMarkedBufferAndResumeFlushing());
+  if (GenerateHash)
+    writeModuleHash(Stream.getMarkedBufferAndResumeFlushing());
 
   Stream.ExitBlock();
 }
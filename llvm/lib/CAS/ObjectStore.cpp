@@ -193,6 +193,32 @@ Expected<ObjectRef> ObjectStore::importObject(ObjectStore &Upstream,
     CursorStack.push_back({Ref, Node, NumRefs, std::move(Refs)});
   };
 
+  // If both stores hash the same way, a node that is already materialized here
+  // does not need to be loaded from upstream, and neither does its subtree.
+  // This is what makes importing from a slow upstream cheap when most of the
+  // graph is already present locally.
+  const bool SameContext = &getContext() == &Upstream.getContext();
+  auto findExisting =
+      [&](ObjectRef UpstreamRef) -> Expected<std::optional<ObjectRef>> {
+    if (!SameContext)
+      return std::nullopt;
+    std::optional<ObjectRef> Ref = getReference(Upstream.getID(UpstreamRef));
+    if (!Ref)
+      return std::nullopt;
+    Expected<bool> Materialized = isMaterialized(*Ref);
+    if (!Materialized)
+      return Materialized.takeError();
+    if (!*Materialized)
+      return std::nullopt;
+    return Ref;
+  };
+
+  std::optional<ObjectRef> ExistingRoot;
+  if (Error E = findExisting(Other).moveInto(ExistingRoot))
+    return std::move(E);
+  if (ExistingRoot)
+    return *ExistingRoot;
+
   auto UpstreamHandle = Upstream.load(Other);
   if (!UpstreamHandle)
     return UpstreamHandle.takeError();
@@ -233,6 +259,15 @@ Expected<ObjectRef> ObjectStore::importObject(ObjectStore &Upstream,
       continue;
     }
 
+    std::optional<ObjectRef> Existing;
+    if (Error E = findExisting(CurrentID).moveInto(Existing))
+      return std::move(E);
+    if (Existing) {
+      PrimaryRefStack.push_back(*Existing);
+      CreatedObjects.try_emplace(CurrentID, *Existing);
+      continue;
+    }
+
     // Load child.
     auto PrimaryID = Upstream.load(CurrentID);
     if (LLVM_UNLIKELY(!PrimaryID))
@@ -593,7 +593,29 @@ UnifiedOnDiskCache::UnifiedOnDiskCache() = default;
 
 UnifiedOnDiskCache::~UnifiedOnDiskCache() { consumeError(close()); }
 
-Error UnifiedOnDiskCache::collectGarbage(StringRef Path) {
+/// \returns the total size of the regular files under \p Path.
+static Expected<uint64_t> getDirectorySize(StringRef Path) {
+  uint64_t TotalSize = 0;
+  std::error_code EC;
+  for (sys::fs::recursive_directory_iterator I(Path, EC), E; !EC && I != E;
+       I.increment(EC)) {
+    if (I->type() == sys::fs::file_type::directory_file)
+      continue;
+    ErrorOr<sys::fs::basic_file_status> Stat = I->status();
+    if (!Stat)
+      return createFileError(I->path(), Stat.getError());
+    TotalSize += Stat->getSize();
+  }
+  if (EC)
+    return createFileError(Path, EC);
+  return TotalSize;
+}
+
+Error UnifiedOnDiskCache::collectGarbage(StringRef Path,
+                                         uint64_t *ReclaimedBytes) {
+  if (ReclaimedBytes)
+    *ReclaimedBytes = 0;
+
   auto DBDirs = getAllGarbageDirs(Path);
   if (!DBDirs)
     return DBDirs.takeError();
@@ -601,6 +623,12 @@ Error UnifiedOnDiskCache::collectGarbage(StringRef Path) {
   SmallString<256> PathBuf(Path);
   for (StringRef UnusedSubDir : *DBDirs) {
     sys::path::append(PathBuf, UnusedSubDir);
+    if (ReclaimedBytes) {
+      Expected<uint64_t> Size = getDirectorySize(PathBuf);
+      if (!Size)
+        return Size.takeError();
+      *ReclaimedBytes += *Size;
+    }
     if (std::error_code EC = sys::fs::remove_directories(PathBuf))
       return createFileError(PathBuf, EC);
     sys::path::remove_filename(PathBuf);
@@ -608,4 +636,6 @@ Error UnifiedOnDiskCache::collectGarbage(StringRef Path) {
   return Error::success();
 }
 
-Error UnifiedOnDiskCache::collectGarbage() { return collectGarbage(RootPath); }
+Error UnifiedOnDiskCache::collectGarbage(uint64_t *ReclaimedBytes) {
+  return collectGarbage(RootPath, ReclaimedBytes);
+}
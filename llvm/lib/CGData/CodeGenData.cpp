@@ -30,7 +30,9 @@ static cl::opt<bool>
                         cl::desc("Emit CodeGen Data into custom sections"));
 static cl::opt<std::string>
     CodeGenDataUsePath("codegen-data-use-path", cl::init(""), cl::Hidden,
-                       cl::desc("File path to where .cgdata file is read"));
+                       cl::desc("File path to where .cgdata file is read. "
+                                "With -codegen-data-generate, codegen data "
+                                "is also emitted for a subsequent build"));
 
 namespace llvm {
 cl::opt<bool> CodeGenDataThinLTOTwoRounds(
@@ -148,7 +150,8 @@ CodeGenData &CodeGenData::getInstance() {
   std::call_once(CodeGenData::OnceFlag, []() {
     Instance = std::unique_ptr<CodeGenData>(new CodeGenData());
 
-    if (CodeGenDataGenerate || CodeGenDataThinLTOTwoRounds)
+    if (CodeGenDataThinLTOTwoRounds ||
+        (CodeGenDataGenerate && CodeGenDataUsePath.empty()))
       Instance->EmitCGData = true;
     else if (!CodeGenDataUsePath.empty()) {
       // Initialize the global CGData if the input file name is given.
@@ -159,6 +162,7 @@ CodeGenData &CodeGenData::getInstance() {
       auto ReaderOrErr = CodeGenDataReader::create(CodeGenDataUsePath, *FS);
       if (Error E = ReaderOrErr.takeError()) {
         warn(std::move(E), CodeGenDataUsePath);
+        Instance->EmitCGData = CodeGenDataGenerate;
         return;
       }
       // Publish each CGData based on the data type in the header.
@@ -167,6 +171,11 @@ CodeGenData &CodeGenData::getInstance() {
         Instance->publishOutlinedHashTree(Reader->releaseOutlinedHashTree());
       if (Reader->hasStableFunctionMap())
         Instance->publishStableFunctionMap(Reader->releaseStableFunctionMap());
+      // With both -codegen-data-use-path and -codegen-data-generate, the
+      // codegen data of a previous build is used while the codegen data for
+      // the next build is emitted, so that no second codegen round is needed.
+      if (CodeGenDataGenerate)
+        Instance->EmitCGData = true;
     }
   });
   return *Instance;
@@ -559,6 +559,11 @@ bool GlobalMergeFunc::run(Module &M) {
       emitFunctionMap(M);
     LocalFunctionMap->finalize();
     FuncMap = LocalFunctionMap.get();
+    // When the codegen data of a previous build is also available, merge
+    // against it as in the second codegen round of a two-round build.
+    if (MergerMode == HashFunctionMode::BuildingHashFuncion &&
+        cgdata::hasStableFunctionMap())
+      FuncMap = cgdata::getStableFunctionMap();
   }
 
   return merge(M, FuncMap);
@@ -84,6 +84,8 @@ STATISTIC(NumInstrsScheduledPreRA,
 STATISTIC(NumInstrsScheduledPostRA,
           "Number of instructions scheduled by post-RA scheduler");
 STATISTIC(NumClustered, "Number of load/store pairs clustered");
+STATISTIC(NumRegionsSplit,
+          "Number of scheduling regions split at the region size limit");
 
 STATISTIC(NumTopPreRA,
           "Number of scheduling units chosen from top queue pre-RA");
@@ -249,6 +251,14 @@ static cl::opt<unsigned> SchedOnlyBlock("misched-only-block", cl::Hidden,
 static cl::opt<unsigned> ReadyListLimit("misched-limit", cl::Hidden,
   cl::desc("Limit ready list to N instructions"), cl::init(256));
 
+/// Building the DAG is quadratic in the region size for memory-heavy code, so
+/// optionally cut giant regions into windows that are scheduled separately.
+static cl::opt<unsigned> MaxRegionInstrs(
+    "misched-max-region-instrs", cl::Hidden,
+    cl::desc("Split scheduling regions larger than N instructions "
+             "(0 = unlimited)"),
+    cl::init(0));
+
 static cl::opt<bool> EnableRegPressure("misched-regpressure", cl::Hidden,
   cl::desc("Enable register pressure scheduling."), cl::init(true));
 
@@ -795,6 +805,12 @@ getSchedRegions(MachineBasicBlock *MBB,
       if (isSchedBoundary(&MI, &*MBB, MF, TII))
         break;
       if (!MI.isDebugOrPseudoInstr()) {
+        // Once the window is full, MI stays in place and acts as the
+        // boundary between this region and the next one.
+        if (MaxRegionInstrs && NumRegionInstrs == MaxRegionInstrs) {
+          ++NumRegionsSplit;
+          break;
+        }
         // MBB::size() uses instr_iterator to count. Here we need a bundle to
         // count as a single instruction.
         ++NumRegionInstrs;
@@ -138,8 +138,8 @@ stable_hash llvm::stableHashValue(const MachineOperand &MO) {
               MachineOperand::getRegMaskSize(TRI->getNumRegs());
           const uint32_t *RegMask =
               MO.isRegMask() ? MO.getRegMask() : MO.getRegLiveOut();
-          std::vector<llvm::stable_hash> RegMaskHashes(RegMask,
-                                                       RegMask + RegMaskSize);
+          SmallVector<stable_hash, 32> RegMaskHashes(RegMask,
+                                                     RegMask + RegMaskSize);
           return stable_hash_combine(MO.getType(), MO.getTargetFlags(),
                                      stable_hash_combine(RegMaskHashes));
         }
@@ -151,7 +151,7 @@ stable_hash llvm::stableHashValue(const MachineOperand &MO) {
   }
 
   case MachineOperand::MO_ShuffleMask: {
-    std::vector<llvm::stable_hash> ShuffleMaskHashes;
+    SmallVector<stable_hash, 16> ShuffleMaskHashes;
 
     llvm::transform(
         MO.getShuffleMask(), std::back_inserter(ShuffleMaskHashes),
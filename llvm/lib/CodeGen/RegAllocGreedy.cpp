@@ -81,6 +81,8 @@ using namespace llvm;
 STATISTIC(NumGlobalSplits, "Number of split global live ranges");
 STATISTIC(NumLocalSplits,  "Number of split local live ranges");
 STATISTIC(NumEvicted,      "Number of interferences evicted");
+STATISTIC(NumRegionSplitCandidatesCutOff,
+          "Number of region split searches stopped at the candidate limit");
 
 static cl::opt<SplitEditor::ComplementSpillMode> SplitSpillMode(
     "split-spill-mode", cl::Hidden,
@@ -119,6 +121,12 @@ static cl::opt<unsigned long> GrowRegionComplexityBudget(
              "limit its budget and bail out once we reach the limit."),
     cl::init(10000), cl::Hidden);
 
+static cl::opt<unsigned> RegionSplitMaxCandidates(
+    "regalloc-region-split-max-candidates",
+    cl::desc("Maximum number of physical registers to evaluate as global "
+             "region split candidates for one live range (0 = unlimited)"),
+    cl::init(0), cl::Hidden);
+
 static cl::opt<bool> GreedyRegClassPriorityTrumpsGlobalness(
     "greedy-regclass-priority-trumps-globalness",
     cl::desc("Change the greedy register allocator's live range priority "
@@ -1309,11 +1317,20 @@ unsigned RAGreedy::calculateRegionSplitCost(const LiveInterval &VirtReg,
                                             unsigned &NumCands,
                                             bool IgnoreCSR) {
   unsigned BestCand = NoCand;
+  unsigned NumTried = 0;
   for (MCPhysReg PhysReg : Order) {
     assert(PhysReg);
     if (IgnoreCSR && EvictAdvisor->isUnusedCalleeSavedReg(PhysReg))
       continue;
 
+    // Every candidate runs the spill placer over the whole interference
+    // region. On huge functions with wide register classes this dominates
+    // allocation time, so optionally stop after a fixed number of tries.
+    if (RegionSplitMaxCandidates && NumTried++ == RegionSplitMaxCandidates) {
+      ++NumRegionSplitCandidatesCutOff;
+      break;
+    }
+
     calculateRegionSplitCostAroundReg(PhysReg, Order, BestCost, NumCands,
                                       BestCand);
   }
@@ -1399,8 +1399,15 @@ bool SelectionDAG::shouldOptForSize() const {
 void SelectionDAG::allnodes_clear() {
   assert(&*AllNodes.begin() == &EntryNode);
   AllNodes.remove(AllNodes.begin());
-  while (!AllNodes.empty())
-    DeallocateNode(&AllNodes.front());
+  // Both callers drop the operand pools, the debug value maps and the extra
+  // info tables right after this, so only return the node memory instead of
+  // unregistering every node from those tables one by one.
+  while (!AllNodes.empty()) {
+    SDNode *N = &AllNodes.front();
+    NodeAllocator.Deallocate(AllNodes.remove(N));
+    __asan_unpoison_memory_region(&N->NodeType, sizeof(N->NodeType));
+    N->NodeType = ISD::DELETED_NODE;
+  }
 #ifndef NDEBUG
   NextPersistentId = 0;
 #endif
@@ -2715,6 +2715,34 @@ getSimpleVT(const unsigned char *MatcherTable, unsigned &MatcherIndex) {
   return static_cast<MVT::SimpleValueType>(SimpleVT);
 }
 
+/// Decode the cases of the OPC_SwitchOpcode whose first case starts at
+/// \p Idx into \p Cases, sorted by opcode. Nothing is decoded for switches
+/// with few cases, for which a linear scan is faster than a binary search.
+static void
+decodeSwitchOpcodeCases(const unsigned char *MatcherTable, unsigned Idx,
+                        SmallVectorImpl<std::pair<uint16_t, unsigned>> &Cases) {
+  const unsigned MinCasesToDecode = 16;
+  while (true) {
+    unsigned CaseSize = MatcherTable[Idx++];
+    if (CaseSize & 128)
+      CaseSize = GetVBR(CaseSize, MatcherTable, Idx);
+    if (CaseSize == 0)
+      break;
+
+    uint16_t Opc = MatcherTable[Idx++];
+    Opc |= static_cast<uint16_t>(MatcherTable[Idx++]) << 8;
+    Cases.emplace_back(Opc, Idx);
+    Idx += CaseSize;
+  }
+
+  if (Cases.size() < MinCasesToDecode) {
+    Cases.clear();
+    return;
+  }
+  // The first case for an opcode is the one that a linear scan would pick.
+  llvm::stable_sort(Cases, llvm::less_first());
+}
+
 void SelectionDAGISel::Select_JUMP_TABLE_DEBUG_INFO(SDNode *N) {
   SDLoc dl(N);
   CurDAG->SelectNodeTo(N, TargetOpcode::JUMP_TABLE_DEBUG_INFO, MVT::Glue,
@@ -3698,7 +3726,28 @@ void SelectionDAGISel::SelectCodeCommon(SDNode *NodeToMatch,
 
     case OPC_SwitchOpcode: {
       unsigned CurNodeOpcode = N.getOpcode();
-      unsigned SwitchStart = MatcherIndex-1; (void)SwitchStart;
+      unsigned SwitchStart = MatcherIndex-1;
+
+      auto [CasesIt, Inserted] = SwitchOpcodeCases.try_emplace(SwitchStart);
+      if (Inserted)
+        decodeSwitchOpcodeCases(MatcherTable, MatcherIndex, CasesIt->second);
+      if (!CasesIt->second.empty()) {
+        const auto &Cases = CasesIt->second;
+        auto Case = llvm::lower_bound(
+            Cases, CurNodeOpcode,
+            [](const std::pair<uint16_t, unsigned> &C, unsigned Opc) {
+              return C.first < Opc;
+            });
+        // If no cases matched, bail out.
+        if (Case == Cases.end() || Case->first != CurNodeOpcode)
+          break;
+
+        MatcherIndex = Case->second;
+        LLVM_DEBUG(dbgs() << "  OpcodeSwitch from " << SwitchStart << " to "
+                          << MatcherIndex << "\n");
+        continue;
+      }
+
       unsigned CaseSize;
       while (true) {
         // Get the size of this case.
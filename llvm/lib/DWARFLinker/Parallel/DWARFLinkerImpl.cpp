@@ -864,8 +864,21 @@ void DWARFLinkerImpl::glueCompileUnitsAndWriteToTheOutput() {
   // units into the resulting file.
   emitCommonSectionsAndWriteCompileUnitsToTheOutput();
 
-  if (ArtificialTypeUnit != nullptr)
+  if (ArtificialTypeUnit != nullptr) {
+    if (GlobalData.getOptions().Statistics) {
+      std::function<void(TypeEntry *)> CountTypes = [&](TypeEntry *Entry) {
+        ++NumDeduplicatedTypes;
+        Entry->getValue().load()->Children.forEach(CountTypes);
+      };
+      TypeEntry *Root = ArtificialTypeUnit->getTypePool().getRoot();
+      Root->getValue().load()->Children.forEach(CountTypes);
+      if (std::optional<SectionDescriptor *> DebugInfo =
+              ArtificialTypeUnit->tryGetSectionDescriptor(
+                  DebugSectionKind::DebugInfo))
+        TypeUnitDebugInfoSize = (*DebugInfo)->getContents().size();
+    }
     ArtificialTypeUnit.reset();
+  }
 
   // Write common debug sections into the resulting file.
   writeCommonSectionsToTheOutput();
@@ -939,6 +952,20 @@ void DWARFLinkerImpl::printStatistic() {
                           ComputePercentange(InputTotal, OutputTotal));
   outs() << "----------------------------------------------------------------"
             "---------------\n\n";
+
+  // The sizes above do not include the types moved into the artificial type
+  // unit, so report it separately.
+  if (NumDeduplicatedTypes != 0) {
+    outs() << "Artificial type unit\n";
+    outs() << "----------------------------------------------------------------"
+              "---------------\n";
+    outs() << formatv("{0,-45} {1,10}\n", "Unique types",
+                      NumDeduplicatedTypes);
+    outs() << formatv("{0,-45} {1,10}b\n", ".debug_info size",
+                      TypeUnitDebugInfoSize);
+    outs() << "----------------------------------------------------------------"
+              "---------------\n\n";
+  }
 }
 
 void DWARFLinkerImpl::assignOffsets() {
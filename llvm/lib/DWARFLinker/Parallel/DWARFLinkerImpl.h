@@ -370,6 +370,12 @@ protected:
 
   /// Overall compile units number.
   uint64_t OverallNumberOfCU = 0;
+
+  /// Number of types kept in the artificial type unit, for statistics.
+  uint64_t NumDeduplicatedTypes = 0;
+
+  /// Size of the artificial type unit's .debug_info, for statistics.
+  uint64_t TypeUnitDebugInfoSize = 0;
   /// @}
 };
 
@@ -11,6 +11,8 @@
 //
 //===----------------------------------------------------------------------===//
 #include "llvm/DWP/DWP.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/DWP/DWPError.h"
 #include "llvm/MC/MCContext.h"
@@ -18,7 +20,10 @@
 #include "llvm/MC/MCTargetOptionsCommandFlags.h"
 #include "llvm/Object/Decompressor.h"
 #include "llvm/Object/ELFObjectFile.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/Parallel.h"
 #include <limits>
+#include <optional>
 
 using namespace llvm;
 using namespace llvm::object;
@@ -415,12 +420,16 @@ Expected<InfoSectionUnitHeader> parseInfoSectionUnitHeader(StringRef Info) {
 static void writeNewOffsetsTo(MCStreamer &Out, DataExtractor &Data,
                               DenseMap<uint64_t, uint32_t> &OffsetRemapping,
                               uint64_t &Offset, uint64_t &Size) {
-
+  // Remap the whole contribution into a local buffer and hand it to the
+  // streamer at once rather than emitting every offset individually.
+  SmallString<256> Buffer;
+  raw_svector_ostream OS(Buffer);
+  support::endian::Writer W(OS, llvm::endianness::little);
   while (Offset < Size) {
     auto OldOffset = Data.getU32(&Offset);
-    auto NewOffset = OffsetRemapping[OldOffset];
-    Out.emitIntValue(NewOffset, 4);
+    W.write<uint32_t>(OffsetRemapping.lookup(OldOffset));
   }
+  Out.emitBytes(Buffer);
 }
 
 void writeStringsAndOffsets(MCStreamer &Out, DWPStringPool &Strings,
@@ -659,8 +668,25 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs,
 
   std::deque<SmallString<32>> UncompressedSections;
 
-  for (const auto &Input : Inputs) {
-    auto ErrOrObj = object::ObjectFile::createObjectFile(Input);
+  // Opening and mapping the inputs is independent for every file and
+  // dominates the run time when packaging many small .dwo files, so do it up
+  // front in parallel. The inputs are still processed in order below.
+  std::vector<std::optional<Expected<OwningBinary<object::ObjectFile>>>>
+      OpenedInputs(Inputs.size());
+  parallelFor(0, Inputs.size(), [&](size_t I) {
+    OpenedInputs[I].emplace(object::ObjectFile::createObjectFile(Inputs[I]));
+  });
+  // Drop the inputs that were not reached because of an earlier error.
+  auto ConsumeOpenedInputs = make_scope_exit([&] {
+    for (auto &Opened : OpenedInputs)
+      if (Opened)
+        consumeError(Opened->takeError());
+  });
+
+  for (auto [InputIdx, Input] : enumerate(Inputs)) {
+    Expected<OwningBinary<object::ObjectFile>> ErrOrObj =
+        std::move(*OpenedInputs[InputIdx]);
+    OpenedInputs[InputIdx].reset();
     if (!ErrOrObj) {
       return handleErrors(ErrOrObj.takeError(),
                           [&](std::unique_ptr<ECError> EC) -> Error {
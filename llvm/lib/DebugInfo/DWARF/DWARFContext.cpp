@@ -51,6 +51,7 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
+#include <atomic>
 #include <cstdint>
 #include <deque>
 #include <map>
@@ -625,21 +626,33 @@ public:
 
 class ThreadSafeState : public ThreadUnsafeDWARFContextState {
   std::recursive_mutex Mutex;
+  // The unit vectors are requested by nearly every lookup and never change
+  // once they have been populated, so publish them for lock-free access.
+  std::atomic<DWARFUnitVector *> NormalUnitsPtr = nullptr;
+  std::atomic<DWARFUnitVector *> DWOUnitsPtr = nullptr;
 
 public:
   ThreadSafeState(DWARFContext &DC, std::string &DWP) :
       ThreadUnsafeDWARFContextState(DC, DWP) {}
 
   DWARFUnitVector &getNormalUnits() override {
+    if (DWARFUnitVector *Units = NormalUnitsPtr.load(std::memory_order_acquire))
+      return *Units;
     std::unique_lock<std::recursive_mutex> LockGuard(Mutex);
-    return ThreadUnsafeDWARFContextState::getNormalUnits();
+    DWARFUnitVector &Units = ThreadUnsafeDWARFContextState::getNormalUnits();
+    NormalUnitsPtr.store(&Units, std::memory_order_release);
+    return Units;
   }
   DWARFUnitVector &getDWOUnits(bool Lazy) override {
+    if (DWARFUnitVector *Units = DWOUnitsPtr.load(std::memory_order_acquire))
+      return *Units;
     std::unique_lock<std::recursive_mutex> LockGuard(Mutex);
     // We need to not do lazy parsing when we need thread safety as
     // DWARFUnitVector, in lazy mode, will slowly add things to itself and
     // will cause problems in a multi-threaded environment.
-    return ThreadUnsafeDWARFContextState::getDWOUnits(false);
+    DWARFUnitVector &Units = ThreadUnsafeDWARFContextState::getDWOUnits(false);
+    DWOUnitsPtr.store(&Units, std::memory_order_release);
+    return Units;
   }
   const DWARFUnitIndex &getCUIndex() override {
     std::unique_lock<std::recursive_mutex> LockGuard(Mutex);
@@ -400,7 +400,6 @@ void DWARFUnit::clear() {
   AddrOffsetSectionBase = std::nullopt;
   SU = nullptr;
   clearDIEs(false);
-  AddrDieMap.clear();
   if (DWO)
     DWO->clear();
   DWO.reset();
@@ -668,6 +667,10 @@ void DWARFUnit::clearDIEs(bool KeepCUDie) {
   DieArray = (KeepCUDie && !DieArray.empty())
                  ? std::vector<DWARFDebugInfoEntry>({DieArray[0]})
                  : std::vector<DWARFDebugInfoEntry>();
+  // These maps point into the DIEs that were just freed.
+  AddrDieMap.clear();
+  VariableDieMap.clear();
+  RootsParsedForVariables.clear();
 }
 
 Expected<DWARFAddressRangesVector>
@@ -668,6 +668,14 @@ Error DwarfTransformer::convert(uint32_t NumThreads, OutputAggregator &Out) {
       DWARFDie Die = getDie(*CU);
       CUInfo CUI(DICtx, dyn_cast<DWARFCompileUnit>(CU.get()));
       handleDie(Out, CUI, Die);
+      // The FunctionInfo objects do not refer back to the DWARF, so release
+      // the DIEs and line table of each unit once it has been converted.
+      // Units referenced again from later ones are re-parsed on demand.
+      DWARFUnit *DieUnit = Die.getDwarfUnit();
+      if (DieUnit && DieUnit != CU.get())
+        DieUnit->clearDIEs(/*KeepCUDie=*/true);
+      CU->clearDIEs(/*KeepCUDie=*/true);
+      DICtx.clearLineTableForUnit(CU.get());
     }
   } else {
     // LLVM Dwarf parser is not thread-safe and we need to parse all DWARF up
@@ -13,7 +13,11 @@
 #ifndef LIB_EXECUTIONENGINE_JITLINK_JITLINKGENERIC_H
 #define LIB_EXECUTIONENGINE_JITLINK_JITLINKGENERIC_H
 
+#include "llvm/Config/llvm-config.h"
 #include "llvm/ExecutionEngine/JITLink/JITLink.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/Parallel.h"
+#include <vector>
 
 #define DEBUG_TYPE "jitlink"
 
@@ -132,14 +136,12 @@ private:
   Error fixUpBlocks(LinkGraph &G) const override {
     LLVM_DEBUG(dbgs() << "Fixing up blocks:\n");
 
+    std::vector<Block *> Blocks;
+    size_t NumRelocations = 0;
     for (auto &Sec : G.sections()) {
       bool NoAllocSection = Sec.getMemLifetime() == orc::MemLifetime::NoAlloc;
 
       for (auto *B : Sec.blocks()) {
-        LLVM_DEBUG(dbgs() << "  " << *B << ":\n");
-
-        // Copy Block data and apply fixups.
-        LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
         assert((!B->isZeroFill() || all_of(B->edges(),
                                            [](const Edge &E) {
                                              return E.getKind() ==
@@ -149,33 +151,65 @@ private:
 
         // If this is a no-alloc section then copy the block content into
         // memory allocated on the Graph's allocator (if it hasn't been
-        // already).
+        // already). The allocator is not thread safe, so this must happen
+        // before fixups are applied in parallel.
         if (NoAllocSection)
           (void)B->getMutableContent(G);
 
-        for (auto &E : B->edges()) {
+        Blocks.push_back(B);
+        NumRelocations += B->edges_size();
+      }
+    }
 
-          // Skip non-relocation edges.
-          if (!E.isRelocation())
-            continue;
+    // Once addresses are assigned each block's fixups only write to that
+    // block's content, so large graphs can be fixed up in parallel.
+    // Debug output is only coherent when running serially.
+#if LLVM_ENABLE_THREADS
+    if (NumRelocations >= ParallelFixupThreshold && !DebugFlag)
+      return parallelForEachError(
+          Blocks, [&](Block *B) { return fixUpBlock(G, *B); });
+#endif
 
-          // If B is a block in a Standard or Finalize section then make sure
-          // that no edges point to symbols in NoAlloc sections.
-          assert((NoAllocSection || !E.getTarget().isDefined() ||
-                  E.getTarget().getSection().getMemLifetime() !=
-                      orc::MemLifetime::NoAlloc) &&
-                 "Block in allocated section has edge pointing to no-alloc "
-                 "section");
+    for (auto *B : Blocks)
+      if (auto Err = fixUpBlock(G, *B))
+        return Err;
 
-          // Dispatch to LinkerImpl for fixup.
-          if (auto Err = impl().applyFixup(G, *B, E))
-            return Err;
-        }
-      }
+    return Error::success();
+  }
+
+  // Copy Block data and apply fixups.
+  Error fixUpBlock(LinkGraph &G, Block &B) const {
+    LLVM_DEBUG(dbgs() << "  " << B << ":\n");
+    LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
+    bool NoAllocSection =
+        B.getSection().getMemLifetime() == orc::MemLifetime::NoAlloc;
+    (void)NoAllocSection;
+
+    for (auto &E : B.edges()) {
+
+      // Skip non-relocation edges.
+      if (!E.isRelocation())
+        continue;
+
+      // If B is a block in a Standard or Finalize section then make sure
+      // that no edges point to symbols in NoAlloc sections.
+      assert((NoAllocSection || !E.getTarget().isDefined() ||
+              E.getTarget().getSection().getMemLifetime() !=
+                  orc::MemLifetime::NoAlloc) &&
+             "Block in allocated section has edge pointing to no-alloc "
+             "section");
+
+      // Dispatch to LinkerImpl for fixup.
+      if (auto Err = impl().applyFixup(G, B, E))
+        return Err;
     }
 
     return Error::success();
   }
+
+  // Graphs with fewer edges than this are fixed up serially, since the cost
+  // of distributing the work would outweigh the gain.
+  static constexpr size_t ParallelFixupThreshold = 16384;
 };
 
 /// Removes dead symbols/blocks/addressables.
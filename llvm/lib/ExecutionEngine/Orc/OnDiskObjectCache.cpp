@@ -0,0 +1,97 @@
+//===---- OnDiskObjectCache.cpp - Persistent object cache for ORC ---------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/OnDiskObjectCache.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA256.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+
+#define DEBUG_TYPE "orc"
+
+namespace llvm {
+namespace orc {
+
+std::string OnDiskObjectCache::getTargetKey(const TargetMachine &TM) {
+  std::string Key;
+  raw_string_ostream OS(Key);
+  OS << TM.getTargetTriple().str() << ';' << TM.getTargetCPU() << ';'
+     << TM.getTargetFeatureString() << ";O"
+     << static_cast<int>(TM.getOptLevel()) << ";R"
+     << static_cast<int>(TM.getRelocationModel()) << ";C"
+     << static_cast<int>(TM.getCodeModel());
+  return Key;
+}
+
+std::string OnDiskObjectCache::getCachePath(const Module &M) const {
+  SmallVector<char, 0> Bitcode;
+  {
+    raw_svector_ostream OS(Bitcode);
+    WriteBitcodeToFile(M, OS);
+  }
+
+  SHA256 Hasher;
+  Hasher.update(TargetKey);
+  Hasher.update(StringRef("\0", 1));
+  Hasher.update(StringRef(Bitcode.data(), Bitcode.size()));
+
+  SmallString<256> Path(CacheDir);
+  sys::path::append(Path, toHex(Hasher.final(), /*LowerCase=*/true) + ".o");
+  return std::string(Path);
+}
+
+void OnDiskObjectCache::notifyObjectCompiled(const Module *M,
+                                             MemoryBufferRef Obj) {
+  if (sys::fs::create_directories(CacheDir))
+    return;
+
+  // Use the key computed when the lookup missed; by now codegen may have
+  // changed the module.
+  std::string Path;
+  {
+    std::lock_guard<std::mutex> Lock(PendingPathsMutex);
+    auto I = PendingPaths.find(M);
+    if (I != PendingPaths.end()) {
+      Path = std::move(I->second);
+      PendingPaths.erase(I);
+    }
+  }
+  if (Path.empty())
+    Path = getCachePath(*M);
+
+  // Write through a temporary file so that concurrent readers never observe a
+  // partially written object.
+  if (Error Err = writeToOutput(Path, [&](raw_ostream &OS) {
+        OS << Obj.getBuffer();
+        return Error::success();
+      }))
+    consumeError(std::move(Err));
+}
+
+std::unique_ptr<MemoryBuffer> OnDiskObjectCache::getObject(const Module *M) {
+  std::string Path = getCachePath(*M);
+  auto Buffer = MemoryBuffer::getFile(Path, /*IsText=*/false,
+                                      /*RequiresNullTerminator=*/false);
+  if (Buffer)
+    return std::move(*Buffer);
+
+  // A missing entry is a cache miss, not an error. Remember the key so the
+  // compiled object is stored under it.
+  std::lock_guard<std::mutex> Lock(PendingPathsMutex);
+  PendingPaths[M] = std::move(Path);
+  return nullptr;
+}
+
+} // end namespace orc
+} // end namespace llvm
@@ -1,5 +1,6 @@
 #include "llvm/ExecutionEngine/Orc/ReOptimizeLayer.h"
 #include "llvm/ExecutionEngine/Orc/Mangling.h"
+#include "llvm/Passes/PassBuilder.h"
 
 using namespace llvm;
 using namespace orc;
@@ -83,6 +84,47 @@ Error ReOptimizeLayer::reoptimizeIfCallFrequent(ReOptimizeLayer &Parent,
                                                 ReOptMaterializationUnitID MUID,
                                                 unsigned CurVersion,
                                                 ThreadSafeModule &TSM) {
+  return addCallCountProfiler(MUID, CurVersion, TSM, CallCountThreshold);
+}
+
+ReOptimizeLayer::AddProfilerFunc
+ReOptimizeLayer::reoptimizeAfterCalls(uint64_t Threshold) {
+  return [Threshold](ReOptimizeLayer &Parent, ReOptMaterializationUnitID MUID,
+                     unsigned CurVersion, ThreadSafeModule &TSM) {
+    return addCallCountProfiler(MUID, CurVersion, TSM, Threshold);
+  };
+}
+
+ReOptimizeLayer::ReOptimizeFunc
+ReOptimizeLayer::optimizeWithPipeline(OptimizationLevel Level) {
+  return [Level](ReOptimizeLayer &Parent, ReOptMaterializationUnitID MUID,
+                 unsigned CurVersion, ResourceTrackerSP OldRT,
+                 ThreadSafeModule &TSM) {
+    TSM.withModuleDo([&](Module &M) {
+      LoopAnalysisManager LAM;
+      FunctionAnalysisManager FAM;
+      CGSCCAnalysisManager CGAM;
+      ModuleAnalysisManager MAM;
+      PassBuilder PB;
+      PB.registerModuleAnalyses(MAM);
+      PB.registerCGSCCAnalyses(CGAM);
+      PB.registerFunctionAnalyses(FAM);
+      PB.registerLoopAnalyses(LAM);
+      PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+
+      ModulePassManager MPM = Level == OptimizationLevel::O0
+                                  ? PB.buildO0DefaultPipeline(Level)
+                                  : PB.buildPerModuleDefaultPipeline(Level);
+      MPM.run(M, MAM);
+    });
+    return Error::success();
+  };
+}
+
+Error ReOptimizeLayer::addCallCountProfiler(ReOptMaterializationUnitID MUID,
+                                            unsigned CurVersion,
+                                            ThreadSafeModule &TSM,
+                                            uint64_t Threshold) {
   return TSM.withModuleDo([&](Module &M) -> Error {
     Type *I64Ty = Type::getInt64Ty(M.getContext());
     GlobalVariable *Counter = new GlobalVariable(
@@ -100,10 +142,10 @@ Error ReOptimizeLayer::reoptimizeIfCallFrequent(ReOptimizeLayer &Parent,
       auto &BB = F.getEntryBlock();
       auto *IP = &*BB.getFirstInsertionPt();
       IRBuilder<> IRB(IP);
-      Value *Threshold = ConstantInt::get(I64Ty, CallCountThreshold, true);
+      Value *ThresholdVal = ConstantInt::get(I64Ty, Threshold, true);
       Value *Cnt = IRB.CreateLoad(I64Ty, Counter);
       // Use EQ to prevent further reoptimize calls.
-      Value *Cmp = IRB.CreateICmpEQ(Cnt, Threshold);
+      Value *Cmp = IRB.CreateICmpEQ(Cnt, ThresholdVal);
       Value *Added = IRB.CreateAdd(Cnt, ConstantInt::get(I64Ty, 1));
       (void)IRB.CreateStore(Added, Counter);
       Instruction *SplitTerminator = SplitBlockAndInsertIfThen(Cmp, IP, false);
@@ -16,6 +16,7 @@
 #include "llvm/Support/Endian.h"
 
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
+#include <sys/uio.h>
 #include <unistd.h>
 #else
 #include <io.h>
@@ -101,9 +102,7 @@ Error FDSimpleRemoteEPCTransport::sendMessage(SimpleRemoteEPCOpcode OpC,
   if (Disconnected)
     return make_error<StringError>("FD-transport disconnected",
                                    inconvertibleErrorCode());
-  if (int ErrNo = writeBytes(HeaderBuffer, FDMsgHeader::Size))
-    return errorCodeToError(std::error_code(ErrNo, std::generic_category()));
-  if (int ErrNo = writeBytes(ArgBytes.data(), ArgBytes.size()))
+  if (int ErrNo = writeMessage(HeaderBuffer, ArgBytes))
     return errorCodeToError(std::error_code(ErrNo, std::generic_category()));
   return Error::success();
 }
@@ -183,6 +182,43 @@ int FDSimpleRemoteEPCTransport::writeBytes(const char *Src, size_t Size) {
   return 0;
 }
 
+int FDSimpleRemoteEPCTransport::writeMessage(const char *Header,
+                                             ArrayRef<char> ArgBytes) {
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+  // Send the header and the arguments with a single gathering write. Besides
+  // saving a syscall per message this keeps small messages in one segment on
+  // sockets, so they are not held back by Nagle's algorithm waiting for the
+  // peer to acknowledge the header.
+  struct iovec IOV[2] = {
+      {const_cast<char *>(Header), FDMsgHeader::Size},
+      {const_cast<char *>(ArgBytes.data()), ArgBytes.size()}};
+  size_t Remaining = FDMsgHeader::Size + ArgBytes.size();
+  unsigned First = 0;
+  while (true) {
+    ssize_t Written = ::writev(OutFD, IOV + First, 2 - First);
+    if (Written < 0) {
+      auto ErrNo = errno;
+      if (ErrNo == EAGAIN || ErrNo == EINTR)
+        continue;
+      return ErrNo;
+    }
+    Remaining -= Written;
+    if (Remaining == 0)
+      return 0;
+    // Partial write: skip what has been sent and retry with the rest.
+    for (; Written > 0 && static_cast<size_t>(Written) >= IOV[First].iov_len;
+         ++First)
+      Written -= IOV[First].iov_len;
+    IOV[First].iov_base = static_cast<char *>(IOV[First].iov_base) + Written;
+    IOV[First].iov_len -= Written;
+  }
+#else
+  if (int ErrNo = writeBytes(Header, FDMsgHeader::Size))
+    return ErrNo;
+  return writeBytes(ArgBytes.data(), ArgBytes.size());
+#endif
+}
+
 void FDSimpleRemoteEPCTransport::listenLoop() {
   Error Err = Error::success();
   do {
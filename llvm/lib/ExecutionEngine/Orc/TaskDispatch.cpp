@@ -52,13 +52,14 @@ void DynamicThreadPoolTaskDispatcher::dispatch(std::unique_ptr<Task> T) {
       // If this is a materialization task and there are too many running
       // already then queue this one up and return early.
       if (!canRunMaterializationTaskNow())
-        return MaterializationTaskQueue.push_back(std::move(T));
+        return enqueue(MaterializationTaskQueue, MaterializationStats,
+                       std::move(T));
 
       // Otherwise record that we have a materialization task running.
       ++NumMaterializationThreads;
     } else if (TaskKind == Idle) {
       if (!canRunIdleTaskNow())
-        return IdleTaskQueue.push_back(std::move(T));
+        return enqueue(IdleTaskQueue, IdleStats, std::move(T));
     }
 
     ++Outstanding;
@@ -86,14 +87,12 @@ void DynamicThreadPoolTaskDispatcher::dispatch(std::unique_ptr<Task> T) {
 
       if (!MaterializationTaskQueue.empty() && canRunMaterializationTaskNow()) {
         // If there are any materialization tasks running then steal that work.
-        T = std::move(MaterializationTaskQueue.front());
-        MaterializationTaskQueue.pop_front();
+        T = dequeue(MaterializationTaskQueue, MaterializationStats);
         TaskKind = Materialization;
         ++NumMaterializationThreads;
         ++Outstanding;
       } else if (!IdleTaskQueue.empty() && canRunIdleTaskNow()) {
-        T = std::move(IdleTaskQueue.front());
-        IdleTaskQueue.pop_front();
+        T = dequeue(IdleTaskQueue, IdleStats);
         TaskKind = Idle;
         ++Outstanding;
       } else {
@@ -111,6 +110,37 @@ void DynamicThreadPoolTaskDispatcher::shutdown() {
   OutstandingCV.wait(Lock, [this]() { return Outstanding == 0; });
 }
 
+DynamicThreadPoolTaskDispatcher::QueueStats
+DynamicThreadPoolTaskDispatcher::getMaterializationQueueStats() {
+  std::lock_guard<std::mutex> Lock(DispatchMutex);
+  return MaterializationStats;
+}
+
+DynamicThreadPoolTaskDispatcher::QueueStats
+DynamicThreadPoolTaskDispatcher::getIdleQueueStats() {
+  std::lock_guard<std::mutex> Lock(DispatchMutex);
+  return IdleStats;
+}
+
+void DynamicThreadPoolTaskDispatcher::enqueue(std::deque<QueuedTask> &Queue,
+                                              QueueStats &Stats,
+                                              std::unique_ptr<Task> T) {
+  Queue.push_back({std::move(T), ClockType::now()});
+  ++Stats.NumQueued;
+  Stats.MaxQueueLength = std::max(Stats.MaxQueueLength, Queue.size());
+}
+
+std::unique_ptr<Task>
+DynamicThreadPoolTaskDispatcher::dequeue(std::deque<QueuedTask> &Queue,
+                                         QueueStats &Stats) {
+  QueuedTask QT = std::move(Queue.front());
+  Queue.pop_front();
+  auto Wait = ClockType::now() - QT.Enqueued;
+  Stats.TotalWait += Wait;
+  Stats.MaxWait = std::max<std::chrono::nanoseconds>(Stats.MaxWait, Wait);
+  return std::move(QT.T);
+}
+
 bool DynamicThreadPoolTaskDispatcher::canRunMaterializationTaskNow() {
   return !MaxMaterializationThreads ||
          (NumMaterializationThreads < *MaxMaterializationThreads);
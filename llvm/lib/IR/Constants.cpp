@@ -906,8 +906,10 @@ Constant *ConstantInt::getBool(Type *Ty, bool V) {
   return V ? getTrue(Ty) : getFalse(Ty);
 }
 
-// Get a ConstantInt from an APInt.
-ConstantInt *ConstantInt::get(LLVMContext &Context, const APInt &V) {
+ConstantInt *ConstantInt::getImpl(LLVMContext &Context, IntegerType *Ty,
+                                  const APInt &V) {
+  assert((!Ty || Ty->getBitWidth() == V.getBitWidth()) &&
+         "Type doesn't match the bit width of the value!");
   // get an existing value or the insertion position
   LLVMContextImpl *pImpl = Context.pImpl;
   std::unique_ptr<ConstantInt> &Slot =
@@ -915,14 +917,21 @@ ConstantInt *ConstantInt::get(LLVMContext &Context, const APInt &V) {
       : V.isOne() ? pImpl->IntOneConstants[V.getBitWidth()]
                   : pImpl->IntConstants[V];
   if (!Slot) {
-    // Get the corresponding integer type for the bit width of the value.
-    IntegerType *ITy = IntegerType::get(Context, V.getBitWidth());
-    Slot.reset(new ConstantInt(ITy, V));
+    // Get the corresponding integer type for the bit width of the value,
+    // unless the caller already knows it.
+    if (!Ty)
+      Ty = IntegerType::get(Context, V.getBitWidth());
+    Slot.reset(new ConstantInt(Ty, V));
   }
   assert(Slot->getType() == IntegerType::get(Context, V.getBitWidth()));
   return Slot.get();
 }
 
+// Get a ConstantInt from an APInt.
+ConstantInt *ConstantInt::get(LLVMContext &Context, const APInt &V) {
+  return getImpl(Context, /*Ty=*/nullptr, V);
+}
+
 // Get a ConstantInt vector with each lane set to the same APInt.
 ConstantInt *ConstantInt::get(LLVMContext &Context, ElementCount EC,
                               const APInt &V) {
@@ -956,8 +965,8 @@ Constant *ConstantInt::get(Type *Ty, uint64_t V, bool isSigned) {
 ConstantInt *ConstantInt::get(IntegerType *Ty, uint64_t V, bool isSigned) {
   // TODO: Avoid implicit trunc?
   // See https://github.com/llvm/llvm-project/issues/112510.
-  return get(Ty->getContext(),
-             APInt(Ty->getBitWidth(), V, isSigned, /*implicitTrunc=*/true));
+  return getImpl(Ty->getContext(), Ty,
+                 APInt(Ty->getBitWidth(), V, isSigned, /*implicitTrunc=*/true));
 }
 
 Constant *ConstantInt::get(Type *Ty, const APInt& V) {
@@ -973,7 +982,7 @@ Constant *ConstantInt::get(Type *Ty, const APInt& V) {
 }
 
 ConstantInt *ConstantInt::get(IntegerType* Ty, StringRef Str, uint8_t radix) {
-  return get(Ty->getContext(), APInt(Ty->getBitWidth(), Str, radix));
+  return getImpl(Ty->getContext(), Ty, APInt(Ty->getBitWidth(), Str, radix));
 }
 
 /// Remove the constant from the constant table.
@@ -75,6 +75,13 @@ static cl::opt<bool>
     DumpThinCGSCCs("dump-thin-cg-sccs", cl::init(false), cl::Hidden,
                    cl::desc("Dump the SCCs in the ThinLTO index's callgraph"));
 
+static cl::opt<bool> ThinLTOScheduleBySummaryCost(
+    "thinlto-schedule-by-summary-cost", cl::init(false), cl::Hidden,
+    cl::desc("When running ThinLTO backends in parallel, start them in "
+             "decreasing order of the instruction count that each module "
+             "defines or imports according to the summary index, instead of "
+             "in decreasing order of bitcode size"));
+
 namespace llvm {
 extern cl::opt<bool> CodeGenDataThinLTOTwoRounds;
 extern cl::opt<bool> ForceImportAll;
@@ -270,8 +277,15 @@ std::string llvm::computeLTOCacheKey(
   };
 
   // Include the hash for the linkage type to reflect internalization and weak
-  // resolution, and collect any used type identifier resolutions.
-  for (auto &GS : DefinedGlobals) {
+  // resolution, and collect any used type identifier resolutions. Visit the
+  // defined globals in GUID order: DefinedGlobals is a DenseMap whose
+  // iteration order depends on its insertion history, which in turn depends on
+  // the order the combined index was built in. Hashing in that order would
+  // make the key sensitive to link order and cause spurious cache misses.
+  std::vector<std::pair<GlobalValue::GUID, GlobalValueSummary *>>
+      SortedDefinedGlobals(DefinedGlobals.begin(), DefinedGlobals.end());
+  llvm::sort(SortedDefinedGlobals, llvm::less_first());
+  for (auto &GS : SortedDefinedGlobals) {
     GlobalValue::LinkageTypes Linkage = GS.second->linkage();
     Hasher.update(
         ArrayRef<uint8_t>((const uint8_t *)&Linkage, sizeof(Linkage)));
@@ -1077,16 +1091,22 @@ LTO::addThinLTO(BitcodeModule BM, ArrayRef<InputFile::Symbol> Syms,
                 ArrayRef<SymbolResolution> Res) {
   llvm::TimeTraceScope timeScope("LTO add thin LTO");
   const auto BMID = BM.getModuleIdentifier();
+  // Compute the GUIDs of the symbols we care about once; both walks over the
+  // symbols below need them, and hashing the names is not free when there are
+  // many inputs.
+  SmallVector<GlobalValue::GUID, 0> GUIDs(Syms.size());
   ArrayRef<SymbolResolution> ResTmp = Res;
-  for (const InputFile::Symbol &Sym : Syms) {
+  for (auto [I, Sym] : enumerate(Syms)) {
     assert(!ResTmp.empty());
     const SymbolResolution &R = ResTmp.consume_front();
 
-    if (!Sym.getIRName().empty() && R.Prevailing) {
-      auto GUID = GlobalValue::getGUIDAssumingExternalLinkage(
+    if (!Sym.getIRName().empty() &&
+        (R.Prevailing || R.FinalDefinitionInLinkageUnit)) {
+      GUIDs[I] = GlobalValue::getGUIDAssumingExternalLinkage(
           GlobalValue::getGlobalIdentifier(Sym.getIRName(),
                                            GlobalValue::ExternalLinkage, ""));
-      ThinLTO.setPrevailingModuleForGUID(GUID, BMID);
+      if (R.Prevailing)
+        ThinLTO.setPrevailingModuleForGUID(GUIDs[I], BMID);
     }
   }
 
@@ -1097,15 +1117,13 @@ LTO::addThinLTO(BitcodeModule BM, ArrayRef<InputFile::Symbol> Syms,
     return Err;
   LLVM_DEBUG(dbgs() << "Module " << BMID << "\n");
 
-  for (const InputFile::Symbol &Sym : Syms) {
+  for (auto [I, Sym] : enumerate(Syms)) {
     assert(!Res.empty());
     const SymbolResolution &R = Res.consume_front();
 
     if (!Sym.getIRName().empty() &&
         (R.Prevailing || R.FinalDefinitionInLinkageUnit)) {
-      auto GUID = GlobalValue::getGUIDAssumingExternalLinkage(
-          GlobalValue::getGlobalIdentifier(Sym.getIRName(),
-                                           GlobalValue::ExternalLinkage, ""));
+      GlobalValue::GUID GUID = GUIDs[I];
       if (R.Prevailing) {
         assert(ThinLTO.isPrevailingModuleForGUID(GUID, BMID));
 
@@ -1278,6 +1296,11 @@ Error LTO::runRegularLTO(AddStreamFn AddStream) {
     for (auto &M : RegularLTO.ModsWithSummaries)
       if (Error Err = linkRegularLTO(std::move(M), /*LivenessFromIndex=*/true))
         return Err;
+    // The modules have been moved into the combined module; release the
+    // moved-from entries and their keep lists before optimization starts,
+    // which is where peak memory usage is reached.
+    RegularLTO.ModsWithSummaries.clear();
+    RegularLTO.ModsWithSummaries.shrink_to_fit();
   }
 
   // Ensure we don't have inconsistently split LTO units with type tests.
@@ -1893,6 +1916,27 @@ ThinBackend lto::createWriteIndexesThinBackend(
   return ThinBackend(Func, Parallelism);
 }
 
+/// Estimate the cost of the ThinLTO backend of a module as the number of
+/// instructions in the functions it defines, plus those in the functions it
+/// imports as definitions.
+static uint64_t
+estimateThinLTOBackendCost(const ModuleSummaryIndex &Index,
+                           const GVSummaryMapTy &DefinedGVSummaries,
+                           const FunctionImporter::ImportMapTy &ImportList) {
+  uint64_t Cost = 0;
+  for (const auto &[GUID, Summary] : DefinedGVSummaries)
+    if (const auto *FS = dyn_cast<FunctionSummary>(Summary))
+      Cost += FS->instCount();
+  for (const auto &[FromModule, GUID, ImportType] : ImportList) {
+    if (ImportType != GlobalValueSummary::Definition)
+      continue;
+    if (const auto *FS = dyn_cast_or_null<FunctionSummary>(
+            Index.findSummaryInModule(GUID, FromModule)))
+      Cost += FS->instCount();
+  }
+  return Cost;
+}
+
 Error LTO::runThinLTO(AddStreamFn AddStream, FileCache Cache,
                       const DenseSet<GlobalValue::GUID> &GUIDPreservedSymbols) {
   llvm::TimeTraceScope timeScope("Run ThinLTO");
@@ -2088,11 +2132,30 @@ Error LTO::runThinLTO(AddStreamFn AddStream, FileCache Cache,
       // improve parallelism, and avoid starving the thread pool near the end.
       // This saves about 15 sec on a 36-core machine while link `clang.exe`
       // (out of 100 sec).
-      std::vector<BitcodeModule *> ModulesVec;
-      ModulesVec.reserve(ModuleMap.size());
-      for (auto &Mod : ModuleMap)
-        ModulesVec.push_back(&Mod.second);
-      for (int I : generateModulesOrdering(ModulesVec))
+      std::vector<int> ModulesOrdering;
+      if (ThinLTOScheduleBySummaryCost) {
+        // The bitcode size does not account for imported functions and
+        // weights debug info like code, so estimate the backend cost from the
+        // summaries instead.
+        std::vector<uint64_t> Costs;
+        Costs.reserve(ModuleMap.size());
+        for (auto &Mod : ModuleMap)
+          Costs.push_back(estimateThinLTOBackendCost(
+              ThinLTO.CombinedIndex, ModuleToDefinedGVSummaries[Mod.first],
+              ImportLists[Mod.first]));
+        auto Seq = llvm::seq<int>(0, ModuleMap.size());
+        ModulesOrdering.assign(Seq.begin(), Seq.end());
+        llvm::stable_sort(ModulesOrdering, [&](int LeftIndex, int RightIndex) {
+          return Costs[LeftIndex] > Costs[RightIndex];
+        });
+      } else {
+        std::vector<BitcodeModule *> ModulesVec;
+        ModulesVec.reserve(ModuleMap.size());
+        for (auto &Mod : ModuleMap)
+          ModulesVec.push_back(&Mod.second);
+        ModulesOrdering = generateModulesOrdering(ModulesVec);
+      }
+      for (int I : ModulesOrdering)
         if (Error E = ProcessOneModule(I))
           return E;
     }
@@ -244,18 +244,17 @@ static void runNewPMPasses(const Config &Conf, Module &Mod, TargetMachine *TM,
   if (!Conf.SampleProfile.empty())
     PGOOpt = PGOOptions(Conf.SampleProfile, "", Conf.ProfileRemapping,
                         /*MemoryProfile=*/"", PGOOptions::SampleUse,
-                        PGOOptions::NoCSAction,
-                        PGOOptions::ColdFuncOpt::Default, true);
+                        PGOOptions::NoCSAction, Conf.PGOColdFuncOpt, true);
   else if (Conf.RunCSIRInstr) {
     PGOOpt = PGOOptions("", Conf.CSIRProfile, Conf.ProfileRemapping,
                         /*MemoryProfile=*/"", PGOOptions::IRUse,
-                        PGOOptions::CSIRInstr, PGOOptions::ColdFuncOpt::Default,
+                        PGOOptions::CSIRInstr, Conf.PGOColdFuncOpt,
                         Conf.AddFSDiscriminator);
   } else if (!Conf.CSIRProfile.empty()) {
     PGOOpt =
         PGOOptions(Conf.CSIRProfile, "", Conf.ProfileRemapping,
                    /*MemoryProfile=*/"", PGOOptions::IRUse, PGOOptions::CSIRUse,
-                   PGOOptions::ColdFuncOpt::Default, Conf.AddFSDiscriminator);
+                   Conf.PGOColdFuncOpt, Conf.AddFSDiscriminator);
     NoPGOWarnMismatch = !Conf.PGOWarnMismatch;
   } else if (Conf.AddFSDiscriminator) {
     PGOOpt = PGOOptions("", "", "", /*MemoryProfile=*/"", PGOOptions::NoAction,
@@ -694,8 +693,12 @@ Error lto::thinBackend(const Config &Conf, unsigned Task, AddStreamFn AddStream,
                                      /*IsImporting*/ true);
     }
 
+    // The bitcode reader does not need a null terminator. Not requiring one
+    // lets the buffer always be mmapped instead of copied into memory when the
+    // file size happens to be a multiple of the page size.
     ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> MBOrErr =
-        llvm::MemoryBuffer::getFile(Identifier);
+        llvm::MemoryBuffer::getFile(Identifier, /*IsText=*/false,
+                                    /*RequiresNullTerminator=*/false);
     if (!MBOrErr)
       return Expected<std::unique_ptr<llvm::Module>>(make_error<StringError>(
           Twine("Error loading imported file ") + Identifier + " : ",
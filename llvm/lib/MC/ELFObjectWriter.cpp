@@ -42,6 +42,8 @@
 #include "llvm/Support/EndianStream.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/LEB128.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/SMLoc.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/TargetParser/Host.h"
@@ -695,6 +697,31 @@ MCSectionELF *ELFWriter::createRelocationSection(MCContext &Ctx,
   return RelaSection;
 }
 
+// Compress Input. With Parallel, zstd is used in 1 MiB shards that are
+// compressed in parallel, as lld does for its output sections. The concatenated
+// frames decompress like a single one, and the output does not depend on the
+// number of threads.
+static void compressSectionData(DebugCompressionType CompressionType,
+                                bool Parallel, ArrayRef<uint8_t> Input,
+                                SmallVectorImpl<uint8_t> &Output) {
+  constexpr size_t ShardSize = 1 << 20;
+  compression::Params P(CompressionType);
+  if (!Parallel || CompressionType != DebugCompressionType::Zstd ||
+      Input.size() <= ShardSize) {
+    compression::compress(P, Input, Output);
+    return;
+  }
+
+  size_t NumShards = divideCeil(Input.size(), ShardSize);
+  SmallVector<SmallVector<uint8_t, 0>, 0> Shards(NumShards);
+  parallelFor(0, NumShards, [&](size_t I) {
+    compression::compress(P, Input.slice(I * ShardSize).take_front(ShardSize),
+                          Shards[I]);
+  });
+  for (const SmallVector<uint8_t, 0> &Shard : Shards)
+    Output.append(Shard.begin(), Shard.end());
+}
+
 // Include the debug info compression header.
 bool ELFWriter::maybeWriteCompression(
     uint32_t ChType, uint64_t Size,
@@ -751,8 +778,10 @@ void ELFWriter::writeSectionData(MCSection &Sec) {
     ChType = ELF::ELFCOMPRESS_ZSTD;
     break;
   }
-  compression::compress(compression::Params(CompressionType), Uncompressed,
-                        Compressed);
+  const MCTargetOptions *TO = Ctx.getTargetOptions();
+  compressSectionData(CompressionType,
+                      TO && TO->ParallelCompressDebugSections, Uncompressed,
+                      Compressed);
   if (!maybeWriteCompression(ChType, UncompressedData.size(), Compressed,
                              Sec.getAlign())) {
     W.OS << UncompressedData;
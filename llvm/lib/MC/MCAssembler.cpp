@@ -617,6 +617,20 @@ void MCAssembler::writeSectionData(raw_ostream &OS,
          OS.tell() - Start == getSectionAddressSize(*Sec));
 }
 
+// Returns true if relaxFragment() may change the size of F. The remaining
+// kinds have a size that does not depend on the layout.
+static bool mayChangeSizeDuringRelaxation(const MCFragment &F) {
+  switch (F.getKind()) {
+  case MCFragment::FT_Data:
+  case MCFragment::FT_Align:
+  case MCFragment::FT_Nops:
+  case MCFragment::FT_SymbolId:
+    return false;
+  default:
+    return true;
+  }
+}
+
 void MCAssembler::layout() {
   assert(getBackendPtr() && "Expected assembler backend");
   DEBUG_WITH_TYPE("mc-dump-pre", {
@@ -650,10 +664,18 @@ void MCAssembler::layout() {
 
   // Layout until everything fits.
   this->HasLayout = true;
-  for (MCSection &Sec : *this)
+  // Sections made up of fixed-size fragments only, such as most data and
+  // debug info sections, keep their initial layout. Leave them out of the
+  // relaxation loop, which otherwise revisits every section on each
+  // iteration.
+  SmallVector<MCSection *, 0> RelaxableSections;
+  for (MCSection &Sec : *this) {
     layoutSection(Sec);
-  unsigned FirstStable = Sections.size();
-  while ((FirstStable = relaxOnce(FirstStable)) > 0)
+    if (any_of(Sec, mayChangeSizeDuringRelaxation))
+      RelaxableSections.push_back(&Sec);
+  }
+  unsigned FirstStable = RelaxableSections.size();
+  while ((FirstStable = relaxOnce(RelaxableSections, FirstStable)) > 0)
     if (getContext().hadError())
       return;
 
@@ -1007,7 +1029,8 @@ void MCAssembler::layoutSection(MCSection &Sec) {
   }
 }
 
-unsigned MCAssembler::relaxOnce(unsigned FirstStable) {
+unsigned MCAssembler::relaxOnce(ArrayRef<MCSection *> Secs,
+                                unsigned FirstStable) {
   ++stats::RelaxationSteps;
   PendingErrors.clear();
 
@@ -1015,7 +1038,7 @@ unsigned MCAssembler::relaxOnce(unsigned FirstStable) {
   for (unsigned I = 0; I != FirstStable; ++I) {
     // Assume each iteration finalizes at least one extra fragment. If the
     // layout does not converge after N+1 iterations, bail out.
-    auto &Sec = *Sections[I];
+    auto &Sec = *Secs[I];
     auto MaxIter = Sec.curFragList()->Tail->getLayoutOrder() + 1;
     for (;;) {
       bool Changed = false;
@@ -1027,7 +1050,7 @@ unsigned MCAssembler::relaxOnce(unsigned FirstStable) {
         break;
       // If any fragment changed size, it might impact the layout of subsequent
       // sections. Therefore, we must re-evaluate all sections.
-      FirstStable = Sections.size();
+      FirstStable = Secs.size();
       Res = I;
       if (--MaxIter == 0)
         break;
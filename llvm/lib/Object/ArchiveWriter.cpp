@@ -31,6 +31,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
@@ -335,6 +336,9 @@ struct MemberData {
   StringRef Data;
   StringRef Padding;
   uint64_t PreHeadPadSize = 0;
+  // Bitcode members are read into their own context. The SymbolicFile refers
+  // to it, so it is declared first to be destroyed last.
+  std::unique_ptr<LLVMContext> Context = nullptr;
   std::unique_ptr<SymbolicFile> SymFile = nullptr;
 };
 } // namespace
@@ -482,15 +486,15 @@ static uint64_t computeHeadersSize(object::Archive::Kind Kind,
 }
 
 static Expected<std::unique_ptr<SymbolicFile>>
-getSymbolicFile(MemoryBufferRef Buf, LLVMContext &Context,
+getSymbolicFile(MemoryBufferRef Buf, std::unique_ptr<LLVMContext> &Context,
                 object::Archive::Kind Kind, function_ref<void(Error)> Warn) {
   const file_magic Type = identify_magic(Buf.getBuffer());
-  // Don't attempt to read non-symbolic file types.
-  if (!object::SymbolicFile::isSymbolicFile(Type, &Context))
-    return nullptr;
   if (Type == file_magic::bitcode) {
+    // Give every bitcode member a context of its own so that members can be
+    // read concurrently.
+    Context = std::make_unique<LLVMContext>();
     auto ObjOrErr = object::SymbolicFile::createSymbolicFile(
-        Buf, file_magic::bitcode, &Context);
+        Buf, file_magic::bitcode, Context.get());
     // An error reading a bitcode file most likely indicates that the file
     // was created by a compiler from the future. Normally we don't try to
     // implement forwards compatibility for bitcode files, but when creating an
@@ -523,6 +527,9 @@ getSymbolicFile(MemoryBufferRef Buf, LLVMContext &Context,
     }
     return std::move(*ObjOrErr);
   } else {
+    // Don't attempt to read non-symbolic file types.
+    if (!object::SymbolicFile::isSymbolicFile(Type, /*Context=*/nullptr))
+      return nullptr;
     auto ObjOrErr = object::SymbolicFile::createSymbolicFile(Buf);
     if (!ObjOrErr)
       return ObjOrErr.takeError();
@@ -778,7 +785,7 @@ static Expected<std::vector<MemberData>>
 computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
                   object::Archive::Kind Kind, bool Thin, bool Deterministic,
                   SymtabWritingMode NeedSymbols, SymMap *SymMap,
-                  LLVMContext &Context, ArrayRef<NewArchiveMember> NewMembers,
+                  ArrayRef<NewArchiveMember> NewMembers,
                   std::optional<bool> IsEC, function_ref<void(Error)> Warn) {
   static char PaddingData[8] = {'\n', '\n', '\n', '\n', '\n', '\n', '\n', '\n'};
   uint64_t MemHeadPadSize = 0;
@@ -843,17 +850,45 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
       Entry.second = Entry.second > 1 ? 1 : 0;
   }
 
+  std::vector<std::unique_ptr<LLVMContext>> Contexts;
   std::vector<std::unique_ptr<SymbolicFile>> SymFiles;
 
   if (NeedSymbols != SymtabWritingMode::NoSymtab || isAIXBigArchive(Kind)) {
-    for (const NewArchiveMember &M : NewMembers) {
+    // Reading members, bitcode ones in particular, dominates the time spent
+    // on large archives, so read them in parallel. Warnings and errors are
+    // reported afterwards in member order.
+    const size_t NumMembers = NewMembers.size();
+    Contexts.resize(NumMembers);
+    SymFiles.resize(NumMembers);
+    std::vector<Error> ReadErrs, WarnErrs;
+    for (size_t I = 0; I != NumMembers; ++I) {
+      ReadErrs.push_back(Error::success());
+      WarnErrs.push_back(Error::success());
+    }
+    parallelFor(0, NumMembers, [&](size_t I) {
       Expected<std::unique_ptr<SymbolicFile>> SymFileOrErr = getSymbolicFile(
-          M.Buf->getMemBufferRef(), Context, Kind, [&](Error Err) {
-            Warn(createFileError(M.MemberName, std::move(Err)));
+          NewMembers[I].Buf->getMemBufferRef(), Contexts[I], Kind,
+          [&](Error Err) {
+            WarnErrs[I] = joinErrors(std::move(WarnErrs[I]), std::move(Err));
           });
-      if (!SymFileOrErr)
-        return createFileError(M.MemberName, SymFileOrErr.takeError());
-      SymFiles.push_back(std::move(*SymFileOrErr));
+      if (SymFileOrErr)
+        SymFiles[I] = std::move(*SymFileOrErr);
+      else
+        ReadErrs[I] = SymFileOrErr.takeError();
+    });
+
+    for (size_t I = 0; I != NumMembers; ++I) {
+      StringRef MemberName = NewMembers[I].MemberName;
+      if (WarnErrs[I])
+        Warn(createFileError(MemberName, std::move(WarnErrs[I])));
+      if (ReadErrs[I]) {
+        Error Err = createFileError(MemberName, std::move(ReadErrs[I]));
+        for (++I; I != NumMembers; ++I) {
+          consumeError(std::move(WarnErrs[I]));
+          consumeError(std::move(ReadErrs[I]));
+        }
+        return std::move(Err);
+      }
     }
   }
 
@@ -919,9 +954,12 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
           std::move(StringMsg), object::object_error::parse_failed);
     }
 
+    std::unique_ptr<LLVMContext> CurContext;
     std::unique_ptr<SymbolicFile> CurSymFile;
-    if (!SymFiles.empty())
+    if (!SymFiles.empty()) {
+      CurContext = std::move(Contexts[Index]);
       CurSymFile = std::move(SymFiles[Index]);
+    }
 
     // In the big archive file format, we need to calculate and include the next
     // member offset and previous member offset in the file member header.
@@ -974,7 +1012,8 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
 
     Pos += Header.size() + Data.size() + Padding.size();
     Ret.push_back({std::move(Symbols), std::move(Header), Data, Padding,
-                   MemHeadPadSize, std::move(CurSymFile)});
+                   MemHeadPadSize, std::move(CurContext),
+                   std::move(CurSymFile)});
   }
   // If there are no symbols, emit an empty symbol table, to satisfy Solaris
   // tools, older versions of which expect a symbol table in a non-empty
@@ -1048,13 +1087,9 @@ Error writeArchiveToStream(raw_ostream &Out,
   if (isCOFFArchive(Kind) && (NewMembers.size() > 0xfffe || !ShouldWriteSymtab))
     Kind = object::Archive::K_GNU;
 
-  // In the scenario when LLVMContext is populated SymbolicFile will contain a
-  // reference to it, thus SymbolicFile should be destroyed first.
-  LLVMContext Context;
-
   Expected<std::vector<MemberData>> DataOrErr = computeMemberData(
       StringTable, SymNames, Kind, Thin, Deterministic, WriteSymtab,
-      isCOFFArchive(Kind) ? &SymMap : nullptr, Context, NewMembers, IsEC, Warn);
+      isCOFFArchive(Kind) ? &SymMap : nullptr, NewMembers, IsEC, Warn);
   if (Error E = DataOrErr.takeError())
     return E;
   std::vector<MemberData> &Data = *DataOrErr;
@@ -34,6 +34,7 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/GraphWriter.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Program.h"
 #include "llvm/Support/Regex.h"
@@ -114,6 +115,16 @@ static cl::opt<std::string> OptBisectPrintIRPath(
     "opt-bisect-print-ir-path",
     cl::desc("Print IR to path when opt-bisect-limit is reached"), cl::Hidden);
 
+static cl::opt<unsigned> VerifyEachInterval(
+    "verify-each-interval", cl::init(1), cl::Hidden,
+    cl::desc("With -verify-each, only verify the IR after every N-th pass"));
+
+static cl::opt<unsigned> VerifyEachFunctionSample(
+    "verify-each-function-sample", cl::init(1), cl::Hidden,
+    cl::desc("With -verify-each, only verify one in N functions after "
+             "function and loop passes, selected by a hash of the function "
+             "name"));
+
 static cl::opt<bool> PrintPassNumbers(
     "print-pass-numbers", cl::init(false), cl::Hidden,
     cl::desc("Print pass names and their ordinals"));
@@ -140,6 +151,12 @@ static cl::opt<bool>
                     cl::desc("Dump dropped debug variables stats"),
                     cl::init(false));
 
+static cl::opt<std::string> AnalysisInvalidationReport(
+    "analysis-invalidation-report", cl::Hidden, cl::init(""),
+    cl::value_desc("filename"),
+    cl::desc("Write per-pass analysis invalidation and recomputation "
+             "statistics as JSON to the given file ('-' for stdout)"));
+
 template <typename IRUnitT> static const IRUnitT *unwrapIR(Any IR) {
   const IRUnitT **IRPtr = llvm::any_cast<const IRUnitT *>(&IR);
   return IRPtr ? *IRPtr : nullptr;
@@ -1458,6 +1475,10 @@ void VerifyInstrumentation::registerCallbacks(PassInstrumentationCallbacks &PIC,
       [this, MAM](StringRef P, Any IR, const PreservedAnalyses &PassPA) {
         if (isIgnored(P) || P == "VerifierPass")
           return;
+        // Sampling trades coverage for the verification time of long
+        // pipelines; the function sample stays the same for every pass.
+        if (VerifyEachInterval > 1 && NumPassesSeen++ % VerifyEachInterval)
+          return;
         const auto *F = unwrapIR<Function>(IR);
         if (!F) {
           if (const auto *L = unwrapIR<Loop>(IR))
@@ -1465,6 +1486,9 @@ void VerifyInstrumentation::registerCallbacks(PassInstrumentationCallbacks &PIC,
         }
 
         if (F) {
+          if (VerifyEachFunctionSample > 1 &&
+              xxh3_64bits(F->getName()) % VerifyEachFunctionSample)
+            return;
           if (DebugLogging)
             dbgs() << "Verifying function " << F->getName() << "\n";
 
@@ -1594,6 +1618,107 @@ void TimeProfilingPassesHandler::runBeforePass(StringRef PassID, Any IR) {
 
 void TimeProfilingPassesHandler::runAfterPass() { timeTraceProfilerEnd(); }
 
+AnalysisInvalidationReporter::~AnalysisInvalidationReporter() {
+  if (!Enabled || AnalysisInvalidationReport.empty())
+    return;
+  std::error_code EC;
+  raw_fd_ostream OS(AnalysisInvalidationReport, EC, sys::fs::OF_Text);
+  if (EC) {
+    errs() << "Could not open " << AnalysisInvalidationReport << ": "
+           << EC.message() << "\n";
+    return;
+  }
+  writeReport(OS);
+}
+
+void AnalysisInvalidationReporter::registerCallbacks(
+    PassInstrumentationCallbacks &PIC) {
+  if (!Enabled)
+    return;
+  PIC.registerBeforeNonSkippedPassCallback(
+      [this](StringRef P, Any) { runBeforePass(P); });
+  PIC.registerAfterPassCallback(
+      [this](StringRef, Any, const PreservedAnalyses &PA) {
+        runAfterPass(PA);
+      });
+  PIC.registerAfterPassInvalidatedCallback(
+      [this](StringRef, const PreservedAnalyses &PA) { runAfterPass(PA); });
+  PIC.registerAnalysisInvalidatedCallback(
+      [this](StringRef P, Any IR) { runAnalysisInvalidated(P, IR); });
+  PIC.registerBeforeAnalysisCallback(
+      [this](StringRef P, Any IR) { runBeforeAnalysis(P, IR); });
+}
+
+static const void *unwrapIRUnit(Any IR) {
+  if (const auto *M = unwrapIR<Module>(IR))
+    return M;
+  if (const auto *F = unwrapIR<Function>(IR))
+    return F;
+  if (const auto *C = unwrapIR<LazyCallGraph::SCC>(IR))
+    return C;
+  if (const auto *L = unwrapIR<Loop>(IR))
+    return L;
+  if (const auto *MF = unwrapIR<MachineFunction>(IR))
+    return MF;
+  return nullptr;
+}
+
+void AnalysisInvalidationReporter::runBeforePass(StringRef PassID) {
+  PassStats &PS = Stats[PassID.str()];
+  ++PS.Runs;
+  PassStack.push_back(&PS);
+}
+
+void AnalysisInvalidationReporter::runAfterPass(const PreservedAnalyses &PA) {
+  assert(!PassStack.empty() && "Unbalanced pass callbacks");
+  if (!PA.areAllPreserved())
+    ++PassStack.back()->Changed;
+  PassStack.pop_back();
+}
+
+void AnalysisInvalidationReporter::runAnalysisInvalidated(StringRef AnalysisID,
+                                                          Any IR) {
+  // Invalidation requested outside of any pass is not attributed.
+  if (PassStack.empty())
+    return;
+  PassStats *PS = PassStack.back();
+  ++PS->Invalidated[AnalysisID.str()];
+  InvalidatedBy[{AnalysisID, unwrapIRUnit(IR)}] = PS;
+}
+
+void AnalysisInvalidationReporter::runBeforeAnalysis(StringRef AnalysisID,
+                                                     Any IR) {
+  auto It = InvalidatedBy.find({AnalysisID, unwrapIRUnit(IR)});
+  if (It == InvalidatedBy.end())
+    return;
+  ++It->second->Recomputed[AnalysisID.str()];
+  InvalidatedBy.erase(It);
+}
+
+void AnalysisInvalidationReporter::writeReport(raw_ostream &OS) const {
+  json::OStream J(OS, /*IndentSize=*/2);
+  J.object([&] {
+    J.attributeArray("passes", [&] {
+      for (const auto &[Name, PS] : Stats) {
+        J.object([&] {
+          J.attribute("name", Name);
+          J.attribute("runs", PS.Runs);
+          J.attribute("changed", PS.Changed);
+          J.attributeObject("invalidated", [&] {
+            for (const auto &[Analysis, Count] : PS.Invalidated)
+              J.attribute(Analysis, Count);
+          });
+          J.attributeObject("recomputed", [&] {
+            for (const auto &[Analysis, Count] : PS.Recomputed)
+              J.attribute(Analysis, Count);
+          });
+        });
+      }
+    });
+  });
+  OS << "\n";
+}
+
 namespace {
 
 class DisplayNode;
@@ -2450,6 +2575,7 @@ StandardInstrumentations::StandardInstrumentations(
                            PrintChanged == ChangePrinter::ColourDiffQuiet),
       WebsiteChangeReporter(PrintChanged == ChangePrinter::DotCfgVerbose),
       Verify(DebugLogging), DroppedStatsIR(DroppedVarStats),
+      InvalidationReporter(!AnalysisInvalidationReport.empty()),
       VerifyEach(VerifyEach) {}
 
 PrintCrashIRInstrumentation *PrintCrashIRInstrumentation::CrashReporter =
@@ -2526,6 +2652,7 @@ void StandardInstrumentations::registerCallbacks(
   ChangeTester.registerCallbacks(PIC);
   PrintCrashIR.registerCallbacks(PIC);
   DroppedStatsIR.registerCallbacks(PIC);
+  InvalidationReporter.registerCallbacks(PIC);
   if (MAM)
     PreservedCFGChecker.registerCallbacks(PIC, *MAM);
 
@@ -14,6 +14,7 @@
 #include "llvm/ProfileData/Coverage/CoverageMapping.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallBitVector.h"
 #include "llvm/ADT/SmallVector.h"
@@ -1397,12 +1398,16 @@ public:
 } // end anonymous namespace
 
 std::vector<StringRef> CoverageMapping::getUniqueSourceFiles() const {
+  // Most functions share their filenames with many others (headers, or the
+  // other functions of the same file), so deduplicate before sorting instead
+  // of sorting every function's list of filenames.
+  DenseSet<StringRef> Seen;
   std::vector<StringRef> Filenames;
   for (const auto &Function : getCoveredFunctions())
-    llvm::append_range(Filenames, Function.Filenames);
+    for (const std::string &Filename : Function.Filenames)
+      if (Seen.insert(Filename).second)
+        Filenames.push_back(Filename);
   llvm::sort(Filenames);
-  auto Last = llvm::unique(Filenames);
-  Filenames.erase(Last, Filenames.end());
   return Filenames;
 }
 
@@ -72,9 +72,13 @@ static InstrProfKind getProfileKindFromVersion(uint64_t Version) {
 }
 
 static Expected<std::unique_ptr<MemoryBuffer>>
-setupMemoryBuffer(const Twine &Filename, vfs::FileSystem &FS) {
-  auto BufferOrErr = Filename.str() == "-" ? MemoryBuffer::getSTDIN()
-                                           : FS.getBufferForFile(Filename);
+setupMemoryBuffer(const Twine &Filename, vfs::FileSystem &FS,
+                  bool RequiresNullTerminator = true) {
+  auto BufferOrErr =
+      Filename.str() == "-"
+          ? MemoryBuffer::getSTDIN()
+          : FS.getBufferForFile(Filename, /*FileSize=*/-1,
+                                RequiresNullTerminator);
   if (std::error_code EC = BufferOrErr.getError())
     return errorCodeToError(EC);
   return std::move(BufferOrErr.get());
@@ -202,8 +206,11 @@ Expected<std::unique_ptr<InstrProfReader>> InstrProfReader::create(
 Expected<std::unique_ptr<IndexedInstrProfReader>>
 IndexedInstrProfReader::create(const Twine &Path, vfs::FileSystem &FS,
                                const Twine &RemappingPath) {
-  // Set up the buffer to read.
-  auto BufferOrError = setupMemoryBuffer(Path, FS);
+  // Set up the buffer to read. The indexed format is binary, so don't ask for
+  // a null terminator: that would force large page-aligned profiles to be
+  // read into memory instead of being mapped.
+  auto BufferOrError =
+      setupMemoryBuffer(Path, FS, /*RequiresNullTerminator=*/false);
   if (Error E = BufferOrError.takeError())
     return std::move(E);
 
@@ -1308,29 +1315,11 @@ Error IndexedInstrProfReader::readHeader() {
     // Expect at least two 64 bit fields: NumTraces, and TraceStreamSize
     if (Ptr + 2 * sizeof(uint64_t) > PtrEnd)
       return error(instrprof_error::truncated);
-    const uint64_t NumTraces =
+    NumTemporalProfTraces =
         support::endian::readNext<uint64_t, llvm::endianness::little>(Ptr);
     TemporalProfTraceStreamSize =
         support::endian::readNext<uint64_t, llvm::endianness::little>(Ptr);
-    for (unsigned i = 0; i < NumTraces; i++) {
-      // Expect at least two 64 bit fields: Weight and NumFunctions
-      if (Ptr + 2 * sizeof(uint64_t) > PtrEnd)
-        return error(instrprof_error::truncated);
-      TemporalProfTraceTy Trace;
-      Trace.Weight =
-          support::endian::readNext<uint64_t, llvm::endianness::little>(Ptr);
-      const uint64_t NumFunctions =
-          support::endian::readNext<uint64_t, llvm::endianness::little>(Ptr);
-      // Expect at least NumFunctions 64 bit fields
-      if (Ptr + NumFunctions * sizeof(uint64_t) > PtrEnd)
-        return error(instrprof_error::truncated);
-      for (unsigned j = 0; j < NumFunctions; j++) {
-        const uint64_t NameRef =
-            support::endian::readNext<uint64_t, llvm::endianness::little>(Ptr);
-        Trace.FunctionNameRefs.push_back(NameRef);
-      }
-      TemporalProfTraces.push_back(std::move(Trace));
-    }
+    TemporalProfTracesPtr = Ptr;
   }
 
   // Load the remapping table now if requested.
@@ -1369,6 +1358,42 @@ InstrProfSymtab &IndexedInstrProfReader::getSymtab() {
   return *Symtab;
 }
 
+Error IndexedInstrProfReader::readTemporalProfTraces() {
+  if (!TemporalProfTracesPtr)
+    return Error::success();
+
+  const unsigned char *Ptr = TemporalProfTracesPtr;
+  const auto *PtrEnd = (const unsigned char *)DataBuffer->getBufferEnd();
+  TemporalProfTracesPtr = nullptr;
+  for (uint64_t I = 0; I < NumTemporalProfTraces; I++) {
+    // Expect at least two 64 bit fields: Weight and NumFunctions
+    if (Ptr + 2 * sizeof(uint64_t) > PtrEnd)
+      return error(instrprof_error::truncated);
+    TemporalProfTraceTy Trace;
+    Trace.Weight =
+        support::endian::readNext<uint64_t, llvm::endianness::little>(Ptr);
+    const uint64_t NumFunctions =
+        support::endian::readNext<uint64_t, llvm::endianness::little>(Ptr);
+    // Expect at least NumFunctions 64 bit fields
+    if (Ptr + NumFunctions * sizeof(uint64_t) > PtrEnd)
+      return error(instrprof_error::truncated);
+    for (uint64_t J = 0; J < NumFunctions; J++) {
+      const uint64_t NameRef =
+          support::endian::readNext<uint64_t, llvm::endianness::little>(Ptr);
+      Trace.FunctionNameRefs.push_back(NameRef);
+    }
+    TemporalProfTraces.push_back(std::move(Trace));
+  }
+  return Error::success();
+}
+
+SmallVector<TemporalProfTraceTy> &
+IndexedInstrProfReader::getTemporalProfTraces(std::optional<uint64_t> Weight) {
+  // A truncated section is left in the reader's error state, see hasError().
+  consumeError(readTemporalProfTraces());
+  return TemporalProfTraces;
+}
+
 Expected<NamedInstrProfRecord> IndexedInstrProfReader::getInstrProfRecord(
     StringRef FuncName, uint64_t FuncHash, StringRef DeprecatedFuncName,
     uint64_t *MismatchedFuncSum) {
@@ -1611,8 +1636,19 @@ Error IndexedInstrProfReader::readNextRecord(NamedInstrProfRecord &Record) {
   ArrayRef<NamedInstrProfRecord> Data;
 
   Error E = Index->getRecords(Data);
-  if (E)
+  if (E) {
+    // The traces are decoded lazily. Decode them before reporting the end of
+    // the records, so that a consumer iterating over the whole profile sees a
+    // truncated trace section as an error instead of the end of the data.
+    E = handleErrors(std::move(E),
+                     [&](std::unique_ptr<InstrProfError> IPE) -> Error {
+                       if (IPE->get() == instrprof_error::eof)
+                         if (Error TracesErr = readTemporalProfTraces())
+                           return TracesErr;
+                       return Error(std::move(IPE));
+                     });
     return error(std::move(E));
+  }
 
   Record = Data[RecordIndex++];
   if (RecordIndex >= Data.size()) {
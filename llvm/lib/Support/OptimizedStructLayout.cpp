@@ -11,6 +11,8 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/OptimizedStructLayout.h"
+#include "llvm/ADT/STLExtras.h"
+#include <algorithm>
 #include <optional>
 
 using namespace llvm;
@@ -454,3 +456,17 @@ llvm::performOptimizedStructLayout(MutableArrayRef<Field> Fields) {
 
   return {LastEnd, MaxAlign};
 }
+
+std::pair<uint64_t, Align>
+llvm::performHotColdStructLayout(MutableArrayRef<Field> Fields,
+                                 function_ref<bool(const Field &)> IsHot) {
+  auto FirstFlexible = llvm::find_if(
+      Fields, [](const Field &F) { return !F.hasFixedOffset(); });
+  auto FirstCold = std::stable_partition(FirstFlexible, Fields.end(), IsHot);
+
+  // Lay out the fixed-offset and the hot fields first.  On return, they all
+  // have fixed offsets and are sorted by offset, so they form the fixed
+  // prefix in which the cold fields are then laid out.
+  performOptimizedStructLayout(Fields.take_front(FirstCold - Fields.begin()));
+  return performOptimizedStructLayout(Fields);
+}
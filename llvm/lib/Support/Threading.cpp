@@ -102,6 +102,8 @@ std::optional<ThreadPoolStrategy>
 llvm::get_threadpool_strategy(StringRef Num, ThreadPoolStrategy Default) {
   if (Num == "all")
     return llvm::hardware_concurrency();
+  if (Num == "jobserver")
+    return llvm::jobserver_concurrency();
   if (Num.empty())
     return Default;
   unsigned V;
@@ -36,6 +36,12 @@
 #include <libproc.h>
 #endif
 
+#if defined(__linux__) && defined(HAVE_UNISTD_H)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#define LLVM_TIMER_USE_PERF_EVENTS 1
+#endif
+
 using namespace llvm;
 
 //===----------------------------------------------------------------------===//
@@ -51,6 +57,8 @@ class Name2PairMap;
 
 static std::string &libSupportInfoOutputFilename();
 static bool trackSpace();
+[[maybe_unused]]
+static bool trackInstructions();
 static bool sortTimers();
 [[maybe_unused]]
 static SignpostEmitter &signposts();
@@ -114,6 +122,37 @@ static inline size_t getMemUsage() {
   return sys::Process::GetMallocUsage();
 }
 
+#ifdef LLVM_TIMER_USE_PERF_EVENTS
+namespace {
+/// A per-thread hardware counter of user-space instructions retired.
+struct InstructionCounter {
+  int FD = -1;
+
+  InstructionCounter() {
+    perf_event_attr Attr = {};
+    Attr.type = PERF_TYPE_HARDWARE;
+    Attr.size = sizeof(Attr);
+    Attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    Attr.exclude_kernel = 1;
+    Attr.exclude_hv = 1;
+    FD = ::syscall(SYS_perf_event_open, &Attr, /*pid=*/0, /*cpu=*/-1,
+                   /*group_fd=*/-1, PERF_FLAG_FD_CLOEXEC);
+  }
+  ~InstructionCounter() {
+    if (FD >= 0)
+      ::close(FD);
+  }
+
+  uint64_t read() const {
+    uint64_t Count;
+    if (FD < 0 || ::read(FD, &Count, sizeof(Count)) != sizeof(Count))
+      return 0;
+    return Count;
+  }
+};
+} // namespace
+#endif
+
 static uint64_t getCurInstructionsExecuted() {
 #if defined(HAVE_UNISTD_H) && defined(HAVE_PROC_PID_RUSAGE) &&                 \
     defined(RUSAGE_INFO_V4)
@@ -121,6 +160,14 @@ static uint64_t getCurInstructionsExecuted() {
   if (proc_pid_rusage(getpid(), RUSAGE_INFO_V4, (rusage_info_t *)&ru) == 0) {
     return ru.ri_instructions;
   }
+#elif defined(LLVM_TIMER_USE_PERF_EVENTS)
+  // Opening a counter costs a syscall and may be denied by
+  // perf_event_paranoid, so only do it on request. The counter is per thread,
+  // matching how timers are started and stopped.
+  if (trackInstructions()) {
+    static thread_local InstructionCounter Counter;
+    return Counter.read();
+  }
 #endif
   return 0;
 }
@@ -524,6 +571,11 @@ public:
       "track-memory",
       cl::desc("Enable -time-passes memory tracking (this may be slow)"),
       cl::Hidden};
+  cl::opt<bool> TrackInstructions{
+      "track-instructions",
+      cl::desc("Enable -time-passes instruction counting with hardware "
+               "performance counters (Linux only)"),
+      cl::Hidden};
   cl::opt<bool> SortTimers{
       "sort-timers",
       cl::desc("In the report, sort the timers in each group in wall clock"
@@ -554,6 +606,9 @@ static std::string &libSupportInfoOutputFilename() {
   return ManagedTimerGlobals->LibSupportInfoOutputFilename;
 }
 static bool trackSpace() { return ManagedTimerGlobals->TrackSpace; }
+static bool trackInstructions() {
+  return ManagedTimerGlobals->TrackInstructions;
+}
 static bool sortTimers() { return ManagedTimerGlobals->SortTimers; }
 static SignpostEmitter &signposts() { return ManagedTimerGlobals->Signposts; }
 static sys::SmartMutex<true> &timerLock() {
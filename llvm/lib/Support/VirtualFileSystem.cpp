@@ -2979,9 +2979,92 @@ void TracingFileSystem::printImpl(raw_ostream &OS, PrintType Type,
   getUnderlyingFS().print(OS, Type, IndentLevel + 1);
 }
 
+bool NegativeLookupCacheFileSystem::isKnownMissing(
+    const Twine &Path, SmallVectorImpl<char> &AbsPath) {
+  Path.toVector(AbsPath);
+  if (makeAbsolute(AbsPath)) {
+    AbsPath.clear();
+    return false;
+  }
+  StringRef Key(AbsPath.data(), AbsPath.size());
+  std::lock_guard<std::mutex> Lock(Mutex);
+  if (!Missing.contains(Key))
+    return false;
+  ++NumCacheHits;
+  return true;
+}
+
+void NegativeLookupCacheFileSystem::recordMissing(StringRef AbsPath) {
+  if (AbsPath.empty())
+    return;
+  std::lock_guard<std::mutex> Lock(Mutex);
+  Missing.insert(AbsPath);
+}
+
+ErrorOr<Status> NegativeLookupCacheFileSystem::status(const Twine &Path) {
+  SmallString<256> AbsPath;
+  if (isKnownMissing(Path, AbsPath))
+    return make_error_code(llvm::errc::no_such_file_or_directory);
+  ErrorOr<Status> Result = ProxyFileSystem::status(Path);
+  if (Result.getError() == llvm::errc::no_such_file_or_directory)
+    recordMissing(AbsPath);
+  return Result;
+}
+
+bool NegativeLookupCacheFileSystem::exists(const Twine &Path) {
+  SmallString<256> AbsPath;
+  if (isKnownMissing(Path, AbsPath))
+    return false;
+  // exists() does not say why a lookup failed, so it cannot populate the
+  // cache.
+  return ProxyFileSystem::exists(Path);
+}
+
+ErrorOr<std::unique_ptr<File>>
+NegativeLookupCacheFileSystem::openFileForRead(const Twine &Path) {
+  SmallString<256> AbsPath;
+  if (isKnownMissing(Path, AbsPath))
+    return make_error_code(llvm::errc::no_such_file_or_directory);
+  auto Result = ProxyFileSystem::openFileForRead(Path);
+  if (Result.getError() == llvm::errc::no_such_file_or_directory)
+    recordMissing(AbsPath);
+  return Result;
+}
+
+void NegativeLookupCacheFileSystem::clearCache() {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  Missing.clear();
+}
+
+std::size_t NegativeLookupCacheFileSystem::getNumCacheHits() const {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  return NumCacheHits;
+}
+
+void NegativeLookupCacheFileSystem::printImpl(raw_ostream &OS, PrintType Type,
+                                              unsigned IndentLevel) const {
+  printIndent(OS, IndentLevel);
+  OS << "NegativeLookupCacheFileSystem\n";
+  if (Type == PrintType::Summary)
+    return;
+
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    printIndent(OS, IndentLevel);
+    OS << "NumCachedMisses=" << Missing.size() << "\n";
+    printIndent(OS, IndentLevel);
+    OS << "NumCacheHits=" << NumCacheHits << "\n";
+  }
+
+  if (Type == PrintType::Contents)
+    Type = PrintType::Summary;
+  getUnderlyingFS().print(OS, Type, IndentLevel + 1);
+}
+
 const char FileSystem::ID = 0;
 const char OverlayFileSystem::ID = 0;
 const char ProxyFileSystem::ID = 0;
 const char InMemoryFileSystem::ID = 0;
 const char RedirectingFileSystem::ID = 0;
 const char TracingFileSystem::ID = 0;
+const char NegativeLookupCacheFileSystem::ID = 0;
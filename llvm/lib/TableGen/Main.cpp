@@ -17,6 +17,7 @@
 #include "llvm/TableGen/Main.h"
 #include "TGLexer.h"
 #include "TGParser.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Support/CommandLine.h"
@@ -59,6 +60,12 @@ static cl::list<std::string>
 MacroNames("D", cl::desc("Name of the macro to be defined"),
             cl::value_desc("macro name"), cl::Prefix);
 
+static cl::list<std::string> ExtraOutputs(
+    "emit",
+    cl::desc("Additionally run the backend for <action> (e.g. gen-instr-info) "
+             "on the parsed records and write its output to <filename>"),
+    cl::value_desc("action=filename"));
+
 static cl::opt<bool>
 WriteIfChanged("write-if-changed", cl::desc("Only write output if it changed"));
 
@@ -104,8 +111,42 @@ static int createDependencyFile(const TGParser &Parser, const char *argv0) {
   return 0;
 }
 
+/// Write \p Contents to \p Filename, leaving an unchanged file untouched if
+/// `-write-if-changed` is given.
+static int writeOutputFile(const char *argv0, StringRef Filename,
+                           StringRef Contents) {
+  if (WriteIfChanged) {
+    // Only updates the real output file if there are any differences.
+    // This prevents recompilation of all the files depending on it if there
+    // aren't any.
+    if (auto ExistingOrErr = MemoryBuffer::getFile(Filename, /*IsText=*/true))
+      if (std::move(ExistingOrErr.get())->getBuffer() == Contents)
+        return 0;
+  }
+  std::error_code EC;
+  ToolOutputFile OutFile(Filename, EC, sys::fs::OF_Text);
+  if (EC)
+    return reportError(argv0, "error opening " + Filename + ": " +
+                                  EC.message() + "\n");
+  OutFile.os() << Contents;
+  if (ErrorsPrinted == 0)
+    OutFile.keep();
+  return 0;
+}
+
 int llvm::TableGenMain(const char *argv0,
                        std::function<TableGenMainFn> MainFn) {
+  // Resolve the `-emit` backends before doing any work.
+  SmallVector<std::pair<TableGen::Emitter::FnT, StringRef>> ExtraBackends;
+  for (StringRef Extra : ExtraOutputs) {
+    auto [Action, Filename] = Extra.split('=');
+    TableGen::Emitter::FnT Fn = TableGen::Emitter::getCallback(Action);
+    if (!Fn || Filename.empty())
+      return reportError(argv0, "invalid -emit value '" + Extra +
+                                    "', expected <action>=<filename>\n");
+    ExtraBackends.emplace_back(Fn, Filename);
+  }
+
   RecordKeeper Records;
   TGTimer &Timer = Records.getTimer();
 
@@ -165,28 +206,29 @@ int llvm::TableGenMain(const char *argv0,
   }
 
   Timer.startTimer("Write output");
-  bool WriteFile = true;
-  if (WriteIfChanged) {
-    // Only updates the real output file if there are any differences.
-    // This prevents recompilation of all the files depending on it if there
-    // aren't any.
-    if (auto ExistingOrErr =
-            MemoryBuffer::getFile(OutputFilename, /*IsText=*/true))
-      if (std::move(ExistingOrErr.get())->getBuffer() == OutString)
-        WriteFile = false;
-  }
-  if (WriteFile) {
-    std::error_code EC;
-    ToolOutputFile OutFile(OutputFilename, EC, sys::fs::OF_Text);
-    if (EC)
-      return reportError(argv0, "error opening " + OutputFilename + ": " +
-                                    EC.message() + "\n");
-    OutFile.os() << OutString;
-    if (ErrorsPrinted == 0)
-      OutFile.keep();
+  if (int Ret = writeOutputFile(argv0, OutputFilename, OutString))
+    return Ret;
+  Timer.stopTimer();
+
+  // Run the additional backends on the same records, which saves re-parsing
+  // the (often large) input once per output file. Backends are run one after
+  // the other: they lazily create new Inits and cache queries in the shared
+  // RecordKeeper, neither of which is thread-safe.
+  for (const auto &[Fn, Filename] : ExtraBackends) {
+    if (ErrorsPrinted > 0)
+      break;
+    Timer.startBackendTimer("Backend overall");
+    std::string ExtraString;
+    raw_string_ostream ExtraOut(ExtraString);
+    Fn(Records, ExtraOut);
+    Timer.stopBackendTimer();
+
+    Timer.startTimer("Write output");
+    if (int Ret = writeOutputFile(argv0, Filename, ExtraString))
+      return Ret;
+    Timer.stopTimer();
   }
 
-  Timer.stopTimer();
   Timer.stopPhaseTiming();
 
   if (ErrorsPrinted > 0)
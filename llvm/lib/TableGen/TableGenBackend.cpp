@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/TableGen/TableGenBackend.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/ManagedStatic.h"
@@ -52,10 +53,15 @@ struct OptCreatorT {
 
 static ManagedStatic<cl::opt<FnT>, OptCreatorT> CallbackFunction;
 
+// All registered callbacks by option name, so that backends can also be
+// selected by name, e.g. to emit several outputs from one parse.
+static ManagedStatic<StringMap<FnT>> CallbacksByName;
+
 Opt::Opt(StringRef Name, FnT CB, StringRef Desc, bool ByDefault) {
   if (ByDefault)
     CallbackFunction->setInitialValue(CB);
   CallbackFunction->getParser().addLiteralOption(Name, CB, Desc);
+  CallbacksByName->try_emplace(Name, CB);
 }
 
 /// Apply callback specified on the command line. Returns true if no callback
@@ -69,6 +75,13 @@ bool llvm::TableGen::Emitter::ApplyCallback(const RecordKeeper &Records,
   return false;
 }
 
+FnT llvm::TableGen::Emitter::getCallback(StringRef Name) {
+  auto It = CallbacksByName->find(Name);
+  if (It == CallbacksByName->end())
+    return FnT();
+  return It->second;
+}
+
 static void printLine(raw_ostream &OS, const Twine &Prefix, char Fill,
                       StringRef Suffix) {
   size_t Pos = (size_t)OS.tell();
@@ -208,6 +208,12 @@ static cl::opt<bool> EnableGISelLoadStoreOptPreLegal(
     cl::desc("Enable GlobalISel's pre-legalizer load/store optimization pass"),
     cl::init(true), cl::Hidden);
 
+static cl::opt<bool> EnableGISelO0PreLegalizerCombiner(
+    "aarch64-enable-gisel-o0-prelegal-combiner",
+    cl::desc("Run GlobalISel's pre-legalizer combiner at -O0. Disabling it "
+             "trades code quality for compile time"),
+    cl::init(true), cl::Hidden);
+
 static cl::opt<bool> EnableGISelLoadStoreOptPostLegal(
     "aarch64-enable-gisel-ldst-postlegal",
     cl::desc("Enable GlobalISel's post-legalizer load/store optimization pass"),
@@ -725,7 +731,8 @@ bool AArch64PassConfig::addIRTranslator() {
 
 void AArch64PassConfig::addPreLegalizeMachineIR() {
   if (getOptLevel() == CodeGenOptLevel::None) {
-    addPass(createAArch64O0PreLegalizerCombiner());
+    if (EnableGISelO0PreLegalizerCombiner)
+      addPass(createAArch64O0PreLegalizerCombiner());
     addPass(new Localizer());
   } else {
     addPass(createAArch64PreLegalizerCombiner());
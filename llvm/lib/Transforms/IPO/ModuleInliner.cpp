@@ -41,6 +41,7 @@
 #include "llvm/Transforms/Utils/CallPromotionUtils.h"
 #include "llvm/Transforms/Utils/Cloning.h"
 #include <cassert>
+#include <optional>
 
 using namespace llvm;
 
@@ -56,6 +57,13 @@ static cl::opt<bool> CtxProfPromoteAlwaysInline(
              "promotion for that target. If multiple targets for an indirect "
              "call site fit this description, they are all promoted."));
 
+static cl::opt<unsigned> ModuleInlinerGrowthBudget(
+    "module-inliner-growth-budget", cl::init(0), cl::Hidden,
+    cl::desc("Only perform mandatory inlining once inlining has grown the "
+             "module by this percentage of its initial instruction count. "
+             "This bounds the compile time spent on very large modules. "
+             "0 means no limit."));
+
 /// Return true if the specified inline history ID
 /// indicates an inline history that includes the specified function.
 static bool inlineHistoryIncludes(
@@ -186,6 +194,17 @@ PreservedAnalyses ModuleInlinerPass::run(Module &M,
   if (Calls->empty())
     return PreservedAnalyses::all();
 
+  // With a growth budget, the size of each inlined callee is accumulated, and
+  // non-mandatory inlining stops once the budget is used up.
+  std::optional<uint64_t> GrowthBudget;
+  uint64_t Growth = 0;
+  if (ModuleInlinerGrowthBudget) {
+    uint64_t ModuleSize = 0;
+    for (Function &F : M)
+      ModuleSize += F.getInstructionCount();
+    GrowthBudget = ModuleSize * ModuleInlinerGrowthBudget / 100;
+  }
+
   // When inlining a callee produces new call sites, we want to keep track of
   // the fact that they were inlined from the callee.  This allows us to avoid
   // infinite inlining in some obscure cases.  To represent this, we use an
@@ -219,7 +238,8 @@ PreservedAnalyses ModuleInlinerPass::run(Module &M,
       continue;
     }
 
-    auto Advice = Advisor.getAdvice(*CB, /*OnlyMandatory*/ false);
+    bool OverBudget = GrowthBudget && Growth > *GrowthBudget;
+    auto Advice = Advisor.getAdvice(*CB, /*OnlyMandatory*/ OverBudget);
     // Check whether we want to inline this callsite.
     if (!Advice->isInliningRecommended()) {
       Advice->recordUnattemptedInlining();
@@ -233,6 +253,7 @@ PreservedAnalyses ModuleInlinerPass::run(Module &M,
         &FAM.getResult<BlockFrequencyAnalysis>(*(CB->getCaller())),
         &FAM.getResult<BlockFrequencyAnalysis>(Callee));
 
+    unsigned CalleeSize = GrowthBudget ? Callee.getInstructionCount() : 0;
     InlineResult IR =
         InlineFunction(*CB, IFI, CtxProf, /*MergeAttributes=*/true,
                        &FAM.getResult<AAManager>(*CB->getCaller()));
@@ -243,6 +264,7 @@ PreservedAnalyses ModuleInlinerPass::run(Module &M,
 
     Changed = true;
     ++NumInlined;
+    Growth += CalleeSize;
 
     LLVM_DEBUG(dbgs() << "    Size after inlining: " << F.getInstructionCount()
                       << "\n");
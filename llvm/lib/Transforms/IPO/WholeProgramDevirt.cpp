@@ -97,6 +97,7 @@
 #include "llvm/IR/ModuleSummaryIndexYAML.h"
 #include "llvm/IR/PassManager.h"
 #include "llvm/IR/ProfDataUtils.h"
+#include "llvm/ProfileData/InstrProf.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Errc.h"
@@ -113,7 +114,9 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <limits>
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
 
@@ -1204,6 +1207,21 @@ bool DevirtIndex::tryFindVirtualCallTargets(
   return !TargetsForSlot.empty();
 }
 
+/// Return the index of \p Fn in the indirect call value profile \p ValueData,
+/// if it was profiled as a target.
+static std::optional<size_t>
+findProfiledTarget(ArrayRef<InstrProfValueData> ValueData, const Function &Fn) {
+  // The value profile may hold either flavour of the PGO function name hash.
+  uint64_t IRPGOHash =
+      IndexedInstrProf::ComputeHash(getIRPGOFuncName(Fn, /*InLTO=*/true));
+  uint64_t PGOHash =
+      IndexedInstrProf::ComputeHash(getPGOFuncName(Fn, /*InLTO=*/true));
+  for (size_t I = 0, E = ValueData.size(); I != E; ++I)
+    if (ValueData[I].Value == IRPGOHash || ValueData[I].Value == PGOHash)
+      return I;
+  return std::nullopt;
+}
+
 void DevirtModule::applySingleImplDevirt(VTableSlotInfo &SlotInfo,
                                          Constant *TheFn, bool &IsExported) {
   // Don't devirtualize function if we're told to skip it
@@ -1211,6 +1229,8 @@ void DevirtModule::applySingleImplDevirt(VTableSlotInfo &SlotInfo,
   if (FunctionsToSkip.match(TheFn->stripPointerCasts()->getName()))
     return;
   auto Apply = [&](CallSiteInfo &CSInfo) {
+    // Whether a call site was left indirect because of its profile.
+    bool SkippedCallSite = false;
     for (auto &&VCallSite : CSInfo.CallSites) {
       if (!OptimizedCalls.insert(&VCallSite.CB).second)
         continue;
@@ -1220,12 +1240,37 @@ void DevirtModule::applySingleImplDevirt(VTableSlotInfo &SlotInfo,
           NumDevirtCalls >= WholeProgramDevirtCutoff)
         return;
 
+      auto &CB = VCallSite.CB;
+
+      // When speculating, consult the indirect call profile of the call site,
+      // if there is one. If most of the calls go to other targets, the guard
+      // would mostly fail, so leave the call site to indirect call promotion,
+      // which can speculate on the profiled targets instead.
+      SmallVector<InstrProfValueData, 4> ValueData;
+      uint64_t TotalCount = 0;
+      std::optional<size_t> ProfiledTarget;
+      if (ClDevirtualizeSpeculatively &&
+          DevirtCheckMode != WPDCheckMode::Fallback) {
+        ValueData = getValueProfDataFromInst(
+            CB, IPVK_IndirectCallTarget, std::numeric_limits<uint32_t>::max(),
+            TotalCount);
+        if (!ValueData.empty()) {
+          if (auto *Fn = dyn_cast<Function>(TheFn->stripPointerCasts()))
+            ProfiledTarget = findProfiledTarget(ValueData, *Fn);
+          if (!ProfiledTarget ||
+              ValueData[*ProfiledTarget].Count * 2 < TotalCount) {
+            OptimizedCalls.erase(&CB);
+            SkippedCallSite = true;
+            continue;
+          }
+        }
+      }
+
       if (RemarksEnabled)
         VCallSite.emitRemark("single-impl",
                              TheFn->stripPointerCasts()->getName(), OREGetter);
       NumSingleImpl++;
       NumDevirtCalls++;
-      auto &CB = VCallSite.CB;
       assert(!CB.getCalledFunction() && "devirtualizing direct call?");
       IRBuilder<> Builder(&CB);
       Value *Callee =
@@ -1252,7 +1297,16 @@ void DevirtModule::applySingleImplDevirt(VTableSlotInfo &SlotInfo,
       // call.
       if (DevirtCheckMode == WPDCheckMode::Fallback ||
           ClDevirtualizeSpeculatively) {
-        MDNode *Weights = MDBuilder(M.getContext()).createLikelyBranchWeights();
+        MDBuilder MDB(M.getContext());
+        MDNode *Weights = MDB.createLikelyBranchWeights();
+        uint64_t TargetCount = 0;
+        if (ProfiledTarget) {
+          TargetCount = ValueData[*ProfiledTarget].Count;
+          uint64_t Scale = calculateCountScale(TotalCount);
+          Weights = MDB.createBranchWeights(
+              scaleBranchCount(TargetCount, Scale),
+              scaleBranchCount(TotalCount - TargetCount, Scale));
+        }
         // Version the indirect call site. If the called value is equal to the
         // given callee, 'NewInst' will be executed, otherwise the original call
         // site will be executed.
@@ -1265,8 +1319,15 @@ void DevirtModule::applySingleImplDevirt(VTableSlotInfo &SlotInfo,
         NewInst.setMetadata(LLVMContext::MD_callees, nullptr);
         // Additionally, we should remove them from the fallback indirect call,
         // so that we don't attempt to perform indirect call promotion later.
+        // The exception is a value profile of the remaining targets, which
+        // lets indirect call promotion handle the other hot targets.
         CB.setMetadata(LLVMContext::MD_prof, nullptr);
         CB.setMetadata(LLVMContext::MD_callees, nullptr);
+        if (ProfiledTarget && ValueData.size() > 1) {
+          ValueData.erase(ValueData.begin() + *ProfiledTarget);
+          annotateValueSite(M, CB, ValueData, TotalCount - TargetCount,
+                            IPVK_IndirectCallTarget, ValueData.size());
+        }
       }
 
       // In either trapping or non-checking mode, devirtualize original call.
@@ -1294,7 +1355,8 @@ void DevirtModule::applySingleImplDevirt(VTableSlotInfo &SlotInfo,
     }
     if (CSInfo.isExported())
       IsExported = true;
-    CSInfo.markDevirt();
+    if (!SkippedCallSite)
+      CSInfo.markDevirt();
   };
   Apply(SlotInfo.CSInfo);
   for (auto &P : SlotInfo.ConstCSInfo)
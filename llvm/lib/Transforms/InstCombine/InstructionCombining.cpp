@@ -5621,6 +5621,12 @@ bool InstCombinerImpl::run() {
       if (!EnableCodeSinking)
         return std::nullopt;
 
+      // tryToSinkInstruction() never moves these, so don't bother walking
+      // their uses and querying the CFG for a destination.
+      if (I->use_empty() || isa<PHINode>(I) || isa<AllocaInst>(I) ||
+          I->isTerminator())
+        return std::nullopt;
+
       BasicBlock *BB = I->getParent();
       BasicBlock *UserParent = nullptr;
       unsigned NumUsers = 0;
@@ -15,6 +15,7 @@
 #include "llvm/Transforms/Instrumentation/InstrProfiling.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/Twine.h"
@@ -42,6 +43,7 @@
 #include "llvm/IR/MDBuilder.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
+#include "llvm/IR/ValueHandle.h"
 #include "llvm/Pass.h"
 #include "llvm/ProfileData/InstrProf.h"
 #include "llvm/ProfileData/InstrProfCorrelator.h"
@@ -119,6 +121,13 @@ cl::opt<bool> AtomicCounterUpdatePromoted(
              " for promoted counters only"),
     cl::init(false));
 
+cl::opt<bool> PromoteAtomicCounters(
+    "instrprof-promote-atomic-counters",
+    cl::desc("When counter updates are atomic, still register promote loop "
+             "counters and flush each with a single atomic add at the loop "
+             "exits, instead of an atomic add per iteration"),
+    cl::init(false));
+
 cl::opt<bool> AtomicFirstCounter(
     "atomic-first-counter",
     cl::desc("Use atomic fetch add for first counter in a function (usually "
@@ -291,6 +300,11 @@ private:
   // vector of counter load/store pairs to be register promoted.
   std::vector<LoadStorePair> PromotionCandidates;
 
+  // Stores of atomic counter updates that were lowered to a plain
+  // load/add/store so that they can be promoted. Those left in place after
+  // promotion are turned back into atomic adds.
+  std::vector<WeakVH> AtomicPromotionCandidates;
+
   int64_t TotalCountersPromoted = 0;
 
   /// Lower instrumentation intrinsics in the function. Returns true if there
@@ -306,6 +320,9 @@ private:
   /// Returns true if profile counter update register promotion is enabled.
   bool isCounterPromotionEnabled() const;
 
+  /// Returns true if atomic counter updates are promoted as well.
+  bool isAtomicCounterPromotionEnabled() const;
+
   /// Return true if profile sampling is enabled.
   bool isSamplingEnabled() const;
 
@@ -424,9 +441,10 @@ public:
       BasicBlock *PH, ArrayRef<BasicBlock *> ExitBlocks,
       ArrayRef<Instruction *> InsertPts,
       DenseMap<Loop *, SmallVector<LoadStorePair, 8>> &LoopToCands,
-      LoopInfo &LI)
+      LoopInfo &LI, bool AtomicUpdate)
       : LoadAndStorePromoter({L, S}, SSA), Store(S), ExitBlocks(ExitBlocks),
-        InsertPts(InsertPts), LoopToCandidates(LoopToCands), LI(LI) {
+        InsertPts(InsertPts), LoopToCandidates(LoopToCands), LI(LI),
+        AtomicUpdate(AtomicUpdate) {
     assert(isa<LoadInst>(L));
     assert(isa<StoreInst>(S));
     SSA.AddAvailableValue(PH, Init);
@@ -456,7 +474,7 @@ public:
         Addr = Builder.CreateIntToPtr(BiasInst,
                                       PointerType::getUnqual(Ty->getContext()));
       }
-      if (AtomicCounterUpdatePromoted)
+      if (AtomicCounterUpdatePromoted || AtomicUpdate)
         // automic update currently can only be promoted across the current
         // loop, not the whole loop nest.
         Builder.CreateAtomicRMW(AtomicRMWInst::Add, Addr, LiveInValue,
@@ -483,6 +501,8 @@ private:
   ArrayRef<Instruction *> InsertPts;
   DenseMap<Loop *, SmallVector<LoadStorePair, 8>> &LoopToCandidates;
   LoopInfo &LI;
+  // Flush the promoted counter with an atomic add.
+  bool AtomicUpdate;
 };
 
 /// A helper class to do register promotion for all profile counter
@@ -492,8 +512,10 @@ class PGOCounterPromoter {
 public:
   PGOCounterPromoter(
       DenseMap<Loop *, SmallVector<LoadStorePair, 8>> &LoopToCands,
-      Loop &CurLoop, LoopInfo &LI, BlockFrequencyInfo *BFI)
-      : LoopToCandidates(LoopToCands), L(CurLoop), LI(LI), BFI(BFI) {
+      Loop &CurLoop, LoopInfo &LI, BlockFrequencyInfo *BFI,
+      bool AtomicUpdate)
+      : LoopToCandidates(LoopToCands), L(CurLoop), LI(LI), BFI(BFI),
+        AtomicUpdate(AtomicUpdate) {
 
     // Skip collection of ExitBlocks and InsertPts for loops that will not be
     // able to have counters promoted.
@@ -557,7 +579,8 @@ public:
 
       PGOCounterPromoterHelper Promoter(Cand.first, Cand.second, SSA, InitVal,
                                         L.getLoopPreheader(), ExitBlocks,
-                                        InsertPts, LoopToCandidates, LI);
+                                        InsertPts, LoopToCandidates, LI,
+                                        AtomicUpdate);
       Promoter.run(SmallVector<Instruction *, 2>({Cand.first, Cand.second}));
       Promoted++;
       if (Promoted >= MaxProm)
@@ -652,6 +675,7 @@ private:
   Loop &L;
   LoopInfo &LI;
   BlockFrequencyInfo *BFI;
+  bool AtomicUpdate;
 };
 
 enum class ValueProfilingCallType {
@@ -796,6 +820,7 @@ void InstrLowerer::doSampling(Instruction *I) {
 bool InstrLowerer::lowerIntrinsics(Function *F) {
   bool MadeChange = false;
   PromotionCandidates.clear();
+  AtomicPromotionCandidates.clear();
   SmallVector<InstrProfInstBase *, 8> InstrProfInsts;
 
   // To ensure compatibility with sampling, we save the intrinsics into
@@ -866,10 +891,34 @@ bool InstrLowerer::isCounterPromotionEnabled() const {
   return Options.DoCounterPromotion;
 }
 
+bool InstrLowerer::isAtomicCounterPromotionEnabled() const {
+  return (Options.Atomic || AtomicCounterUpdateAll) && PromoteAtomicCounters &&
+         isCounterPromotionEnabled();
+}
+
 void InstrLowerer::promoteCounterLoadStores(Function *F) {
   if (!isCounterPromotionEnabled())
     return;
 
+  // Updates that must be atomic but could not be promoted get back their
+  // atomic add once promotion is done.
+  auto RestoreAtomicUpdates = make_scope_exit([&] {
+    for (WeakVH &V : AtomicPromotionCandidates) {
+      auto *Store = cast_or_null<StoreInst>(V);
+      if (!Store)
+        continue;
+      auto *Add = cast<BinaryOperator>(Store->getValueOperand());
+      auto *Load = cast<LoadInst>(Add->getOperand(0));
+      IRBuilder<> Builder(Store);
+      Builder.CreateAtomicRMW(AtomicRMWInst::Add, Store->getPointerOperand(),
+                              Add->getOperand(1), MaybeAlign(),
+                              AtomicOrdering::Monotonic);
+      Store->eraseFromParent();
+      Add->eraseFromParent();
+      Load->eraseFromParent();
+    }
+  });
+
   DominatorTree DT(*F);
   LoopInfo LI(DT);
   DenseMap<Loop *, SmallVector<LoadStorePair, 8>> LoopPromotionCandidates;
@@ -896,7 +945,8 @@ void InstrLowerer::promoteCounterLoadStores(Function *F) {
   // Do a post-order traversal of the loops so that counter updates can be
   // iteratively hoisted outside the loop nest.
   for (auto *Loop : llvm::reverse(Loops)) {
-    PGOCounterPromoter Promoter(LoopPromotionCandidates, *Loop, LI, BFI.get());
+    PGOCounterPromoter Promoter(LoopPromotionCandidates, *Loop, LI, BFI.get(),
+                                isAtomicCounterPromotionEnabled());
     Promoter.run(&TotalCountersPromoted);
   }
 }
@@ -1193,8 +1243,10 @@ void InstrLowerer::lowerIncrement(InstrProfIncrementInst *Inc) {
   auto *Addr = getCounterAddress(Inc);
 
   IRBuilder<> Builder(Inc);
-  if (Options.Atomic || AtomicCounterUpdateAll ||
-      (Inc->getIndex()->isZeroValue() && AtomicFirstCounter)) {
+  bool PromoteAtomic = isAtomicCounterPromotionEnabled();
+  if ((Options.Atomic || AtomicCounterUpdateAll ||
+       (Inc->getIndex()->isZeroValue() && AtomicFirstCounter)) &&
+      !PromoteAtomic) {
     Builder.CreateAtomicRMW(AtomicRMWInst::Add, Addr, Inc->getStep(),
                             MaybeAlign(), AtomicOrdering::Monotonic);
   } else {
@@ -1204,6 +1256,8 @@ void InstrLowerer::lowerIncrement(InstrProfIncrementInst *Inc) {
     auto *Store = Builder.CreateStore(Count, Addr);
     if (isCounterPromotionEnabled())
       PromotionCandidates.emplace_back(cast<Instruction>(Load), Store);
+    if (PromoteAtomic)
+      AtomicPromotionCandidates.emplace_back(Store);
   }
   Inc->eraseFromParent();
 }
@@ -4741,7 +4741,7 @@ bool SROA::presplitLoadsAndStores(AllocaInst &AI, AllocaSlices &AS) {
   // all the slices that end up split.
   struct SplitOffsets {
     Slice *S;
-    std::vector<uint64_t> Splits;
+    SmallVector<uint64_t, 4> Splits;
   };
   SmallDenseMap<Instruction *, SplitOffsets, 8> SplitOffsetsMap;
 
@@ -4920,8 +4920,8 @@ bool SROA::presplitLoadsAndStores(AllocaInst &AI, AllocaSlices &AS) {
   // First, we rewrite all of the split loads, and just accumulate each split
   // load in a parallel structure. We also build the slices for them and append
   // them to the alloca slices.
-  SmallDenseMap<LoadInst *, std::vector<LoadInst *>, 1> SplitLoadsMap;
-  std::vector<LoadInst *> SplitLoads;
+  SmallDenseMap<LoadInst *, SmallVector<LoadInst *, 4>, 1> SplitLoadsMap;
+  SmallVector<LoadInst *, 4> SplitLoads;
   const DataLayout &DL = AI.getDataLayout();
   for (LoadInst *LI : Loads) {
     SplitLoads.clear();
@@ -5074,7 +5074,7 @@ bool SROA::presplitLoadsAndStores(AllocaInst &AI, AllocaSlices &AS) {
 
     // Check whether we have an already split load.
     auto SplitLoadsMapI = SplitLoadsMap.find(LI);
-    std::vector<LoadInst *> *SplitLoads = nullptr;
+    SmallVector<LoadInst *, 4> *SplitLoads = nullptr;
     if (SplitLoadsMapI != SplitLoadsMap.end()) {
       SplitLoads = &SplitLoadsMapI->second;
       assert(SplitLoads->size() == Offsets.Splits.size() + 1 &&
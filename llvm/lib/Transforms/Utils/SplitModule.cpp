@@ -15,6 +15,7 @@
 #include "llvm/Transforms/Utils/SplitModule.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/EquivalenceClasses.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
@@ -31,6 +32,7 @@
 #include "llvm/IR/User.h"
 #include "llvm/IR/Value.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MD5.h"
@@ -48,6 +50,12 @@ using namespace llvm;
 
 #define DEBUG_TYPE "split-module"
 
+static cl::opt<bool> BalanceBySize(
+    "split-module-balance-by-size", cl::init(false), cl::Hidden,
+    cl::desc("Assign external functions to partitions so that the number of "
+             "instructions in each partition is balanced, largest functions "
+             "first, instead of distributing them by name hash"));
+
 namespace {
 
 using ClusterMapType = EquivalenceClasses<const GlobalValue *>;
@@ -255,6 +263,33 @@ void llvm::SplitModule(
   ClusterIDMapType ClusterIDMap;
   findPartitions(M, ClusterIDMap, N);
 
+  // Assign functions not mapped to modules in ClusterIDMap to the partition
+  // with the fewest instructions so far, largest functions first. Partitions
+  // are usually compiled in parallel, so this keeps a few large functions from
+  // ending up in the same partition and dominating the overall time.
+  if (BalanceBySize) {
+    SmallVector<uint64_t> PartitionSizes(N);
+    SmallVector<std::pair<const Function *, unsigned>> UnmappedFunctions;
+    for (const Function &F : M.functions()) {
+      if (F.isDeclaration())
+        continue;
+      unsigned Size = F.getInstructionCount();
+      if (auto It = ClusterIDMap.find(&F); It != ClusterIDMap.end())
+        PartitionSizes[It->second] += Size;
+      else if (F.getLinkage() == GlobalValue::ExternalLinkage &&
+               !F.hasComdat())
+        UnmappedFunctions.push_back({&F, Size});
+    }
+    llvm::stable_sort(UnmappedFunctions, [](const auto &A, const auto &B) {
+      return A.second > B.second;
+    });
+    for (const auto &[F, Size] : UnmappedFunctions) {
+      unsigned I = llvm::min_element(PartitionSizes) - PartitionSizes.begin();
+      ClusterIDMap.insert({F, I});
+      PartitionSizes[I] += Size;
+    }
+  }
+
   // Find functions not mapped to modules in ClusterIDMap and count functions
   // per module. Map unmapped functions using round-robin so that they skip
   // being distributed by isInPartition() based on function name hashes below.
@@ -6011,10 +6011,10 @@ LoopVectorizationCostModel::getInstructionCost(Instruction *I,
     return InstsToScalarize[VF][I];
 
   // Forced scalars do not have any scalarization overhead.
-  auto ForcedScalar = ForcedScalars.find(VF);
-  if (VF.isVector() && ForcedScalar != ForcedScalars.end()) {
-    auto InstSet = ForcedScalar->second;
-    if (InstSet.count(I))
+  if (VF.isVector()) {
+    auto ForcedScalar = ForcedScalars.find(VF);
+    if (ForcedScalar != ForcedScalars.end() &&
+        ForcedScalar->second.contains(I))
       return getInstructionCost(I, ElementCount::getFixed(1)) *
              VF.getKnownMinValue();
   }
@@ -162,6 +162,14 @@ static cl::opt<int>
 ScheduleRegionSizeBudget("slp-schedule-budget", cl::init(100000), cl::Hidden,
     cl::desc("Limit the size of the SLP scheduling region per block"));
 
+/// Limits the number of trees built for the slices of a single store chain.
+/// It avoids long compile times for huge straight-line kernels, where every
+/// chain is retried with many slice offsets and vector factors.
+static cl::opt<unsigned> MaxStoreChainTreeAttempts(
+    "slp-max-store-chain-attempts", cl::init(0), cl::Hidden,
+    cl::desc("Maximum number of SLP trees to try per store chain "
+             "(0=unlimited)"));
+
 static cl::opt<int> MinVectorRegSizeOption(
     "slp-min-reg-size", cl::init(128), cl::Hidden,
     cl::desc("Attempt to vectorize for this register size in bits"));
@@ -2454,7 +2462,7 @@ public:
           // A broadcast of a load can be cheaper on some targets.
           if (R.TTI->isLegalBroadcastLoad(V1->getType(),
                                           ElementCount::getFixed(NumLanes)) &&
-              ((int)V1->getNumUses() == NumLanes ||
+              (V1->hasNUses(NumLanes) ||
                AllUsersAreInternal(V1, V2)))
             return LookAheadHeuristics::ScoreSplatLoads;
         }
@@ -22941,7 +22949,7 @@ SLPVectorizerPass::vectorizeStoreChain(ArrayRef<Value *> Chain, BoUpSLP &R,
           any_of(ValOps.getArrayRef(),
                  [&](Value *V) {
                    return !isa<ExtractElementInst>(V) &&
-                          (V->getNumUses() > Chain.size() ||
+                          (V->hasNUsesOrMore(Chain.size() + 1) ||
                            any_of(V->users(), [&](User *U) {
                              return !Stores.contains(U);
                            }));
@@ -23232,6 +23240,8 @@ bool SLPVectorizerPass::vectorizeStores(
                               const std::pair<unsigned, unsigned> &P) {
         return Size == P.first;
       };
+      unsigned NumTreeAttempts = 0;
+      bool AttemptsExhausted = false;
       while (true) {
         ++Repeat;
         bool RepeatChanged = false;
@@ -23280,6 +23290,14 @@ bool SLPVectorizerPass::vectorizeStores(
                   continue;
                 }
               }
+              if (MaxStoreChainTreeAttempts &&
+                  NumTreeAttempts++ >= MaxStoreChainTreeAttempts) {
+                LLVM_DEBUG(dbgs() << "SLP: Giving up on store chain after "
+                                  << MaxStoreChainTreeAttempts
+                                  << " attempts.\n");
+                AttemptsExhausted = true;
+                break;
+              }
               unsigned TreeSize;
               std::optional<bool> Res =
                   vectorizeStoreChain(Slice, R, SliceStartIdx, MinVF, TreeSize);
@@ -23350,7 +23368,7 @@ bool SLPVectorizerPass::vectorizeStores(
               ++SliceStartIdx;
               AnyProfitableGraph = true;
             }
-            if (FirstUnvecStore >= End)
+            if (AttemptsExhausted || FirstUnvecStore >= End)
               break;
             if (MaxSliceEnd - FirstUnvecStore < VF &&
                 MaxSliceEnd - FirstUnvecStore >= MinVF)
@@ -23360,9 +23378,12 @@ bool SLPVectorizerPass::vectorizeStores(
                 find_if(RangeSizes.drop_front(MaxSliceEnd),
                         std::bind(IsNotVectorized, VF >= MaxRegVF, _1)));
           }
-          if (!AnyProfitableGraph && VF >= MaxRegVF && has_single_bit(VF))
+          if (AttemptsExhausted ||
+              (!AnyProfitableGraph && VF >= MaxRegVF && has_single_bit(VF)))
             break;
         }
+        if (AttemptsExhausted)
+          break;
         // All values vectorized - exit.
         if (all_of(RangeSizes, [](const std::pair<unsigned, unsigned> &P) {
               return P.first == 0 && P.second == 0;
@@ -111,6 +111,7 @@ struct DsymutilOptions {
   bool InputIsYAMLDebugMap = false;
   bool ForceKeepFunctionForStatic = false;
   bool NoObjectTimestamp = false;
+  bool SkipUpToDate = false;
   std::string OutputFile;
   std::string Toolchain;
   std::string ReproducerPath;
@@ -296,6 +297,7 @@ static Expected<DsymutilOptions> getOptions(opt::InputArgList &Args) {
   Options.Flat = Args.hasArg(OPT_flat);
   Options.InputIsYAMLDebugMap = Args.hasArg(OPT_yaml_input);
   Options.NoObjectTimestamp = Args.hasArg(OPT_no_object_timestamp);
+  Options.SkipUpToDate = Args.hasArg(OPT_skip_up_to_date);
 
   if (Expected<DWARFVerify> Verify = getVerifyKind(Args)) {
     Options.Verify = *Verify;
@@ -607,6 +609,34 @@ getOutputFileName(StringRef InputFile, const DsymutilOptions &Options) {
   return OutputLocation(std::string(Path), ResourceDir);
 }
 
+/// Returns true if \p DWARFFile exists and is newer than \p InputFile and
+/// every object file referenced by \p Maps, in which case relinking would
+/// produce the same output.
+static bool isOutputUpToDate(StringRef InputFile, StringRef DWARFFile,
+                             ArrayRef<std::unique_ptr<DebugMap>> Maps,
+                             vfs::FileSystem &VFS) {
+  sys::fs::file_status OutputStat;
+  if (sys::fs::status(DWARFFile, OutputStat))
+    return false;
+  sys::TimePoint<> OutputTime = OutputStat.getLastModificationTime();
+
+  auto IsOlderThanOutput = [&](StringRef Path) {
+    // Archive members are named "libfoo.a(bar.o)"; check the archive itself.
+    if (Path.ends_with(")"))
+      Path = Path.take_until([](char C) { return C == '('; });
+    ErrorOr<vfs::Status> Stat = VFS.status(Path);
+    return Stat && Stat->getLastModificationTime() < OutputTime;
+  };
+
+  if (!IsOlderThanOutput(InputFile))
+    return false;
+  for (const auto &Map : Maps)
+    for (const auto &Obj : Map->objects())
+      if (!IsOlderThanOutput(Obj->getObjectFilename()))
+        return false;
+  return true;
+}
+
 int dsymutil_main(int argc, char **argv, const llvm::ToolContext &) {
   // Parse arguments.
   DsymutilOptTable T;
@@ -724,6 +754,17 @@ int dsymutil_main(int argc, char **argv, const llvm::ToolContext &) {
     }
     Options.LinkOpts.ResourceDir = OutputLocationOrErr->getResourceDir();
 
+    if (Options.SkipUpToDate && !Options.DumpDebugMap &&
+        !Options.LinkOpts.Update && !Options.LinkOpts.NoOutput &&
+        InputFile != "-" && Options.OutputFile != "-" &&
+        isOutputUpToDate(InputFile, OutputLocationOrErr->DWARFFile,
+                         *DebugMapPtrsOrErr, *Options.LinkOpts.VFS)) {
+      if (Options.LinkOpts.Verbose)
+        outs() << "Skipping up-to-date output: "
+               << OutputLocationOrErr->DWARFFile << '\n';
+      continue;
+    }
+
     // Statistics only require different architectures to be processed
     // sequentially, the link itself can still happen in parallel. Change the
     // thread pool strategy here instead of modifying LinkOpts.Threads.
@@ -509,12 +509,13 @@ void CodeCoverageTool::remapPathNames(const CoverageMapping &Coverage) {
     return NativePath.c_str();
   };
 
+  std::vector<StringRef> CoveredFiles = Coverage.getUniqueSourceFiles();
   for (std::pair<std::string, std::string> &PathRemapping : *PathRemappings) {
     std::string RemapFrom = nativeWithTrailing(PathRemapping.first);
     std::string RemapTo = nativeWithTrailing(PathRemapping.second);
 
     // Create a mapping from coverage data file paths to local paths.
-    for (StringRef Filename : Coverage.getUniqueSourceFiles()) {
+    for (StringRef Filename : CoveredFiles) {
       if (RemappedFilenames.count(Filename) == 1)
         continue;
 
@@ -274,6 +274,18 @@ static cl::opt<int> BenchmarkProcessCPU(
     cl::desc("The CPU number that the benchmarking process should executon on"),
     cl::cat(BenchmarkOptions), cl::init(-1));
 
+static cl::opt<unsigned> NumShards(
+    "num-shards",
+    cl::desc("Split the opcodes or snippets to measure into this many shards, "
+             "so that they can be measured in parallel by one process per "
+             "isolated CPU (see --benchmark-process-cpu)"),
+    cl::cat(BenchmarkOptions), cl::init(1));
+
+static cl::opt<unsigned>
+    ShardIndex("shard-index",
+               cl::desc("The shard to measure, from 0 to --num-shards - 1"),
+               cl::cat(BenchmarkOptions), cl::init(0));
+
 static cl::opt<std::string> MAttr(
     "mattr", cl::desc("comma-separated list of target architecture features"),
     cl::value_desc("+feature1,-feature2,..."), cl::cat(Options), cl::init(""));
@@ -507,6 +519,11 @@ void benchmarkMain() {
     ExitWithError("cannot create benchmark runner");
   }
 
+  if (NumShards == 0 || ShardIndex >= NumShards) {
+    ExitOnErr.setBanner("llvm-exegesis: ");
+    ExitWithError("--shard-index must be less than --num-shards");
+  }
+
   const auto Opcodes = getOpcodesOrDie(State);
   std::vector<BenchmarkCode> Configurations;
 
@@ -526,6 +543,14 @@ void benchmarkMain() {
                       "execution mode");
     }
     LoopRegister = Configurations[0].Key.LoopRegister;
+    // Deal the snippets out round-robin. The results of all shards can be
+    // concatenated into a single benchmarks file for analysis.
+    if (NumShards > 1) {
+      std::vector<BenchmarkCode> ShardConfigurations;
+      for (size_t I = ShardIndex; I < Configurations.size(); I += NumShards)
+        ShardConfigurations.push_back(std::move(Configurations[I]));
+      Configurations = std::move(ShardConfigurations);
+    }
   }
 
   SmallVector<std::unique_ptr<const SnippetRepetitor>, 2> Repetitors;
@@ -545,7 +570,11 @@ void benchmarkMain() {
     AllReservedRegs |= Repetitor->getReservedRegs();
 
   if (!Opcodes.empty()) {
-    for (const unsigned Opcode : Opcodes) {
+    // Deal the opcodes out round-robin before generating their snippets, so
+    // that every shard gets a similar mix of opcodes and the shards agree on
+    // the split even though snippet generation is randomized.
+    for (size_t I = ShardIndex; I < Opcodes.size(); I += NumShards) {
+      const unsigned Opcode = Opcodes[I];
       // Ignore instructions without a sched class if
       // -ignore-invalid-sched-class is passed.
       if (IgnoreInvalidSchedClass &&
@@ -407,6 +407,7 @@ int main(int argc, char **argv) {
 
   MCTargetOptions MCOptions = mc::InitMCTargetOptionsFromFlags();
   MCOptions.CompressDebugSections = CompressDebugSections.getValue();
+  MCOptions.ParallelCompressDebugSections = true;
   MCOptions.ShowMCInst = ShowInst;
   MCOptions.AsmVerbose = true;
   MCOptions.MCUseDwarfDirectory = MCTargetOptions::EnableDwarfDirectory;
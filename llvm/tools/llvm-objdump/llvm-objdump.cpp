@@ -71,6 +71,7 @@
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/StringSaver.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/WithColor.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/TargetParser/Host.h"
@@ -78,6 +79,7 @@
 #include <algorithm>
 #include <cctype>
 #include <cstring>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <system_error>
@@ -299,6 +301,7 @@ enum class ColorOutput {
 };
 
 static uint64_t AdjustVMA;
+static unsigned NumThreads;
 static bool AllHeaders;
 static std::string ArchName;
 bool objdump::ArchiveHeaders;
@@ -1204,6 +1207,42 @@ DisassemblerTarget::DisassemblerTarget(DisassemblerTarget &Other,
       ObjectFileInfo(Other.ObjectFileInfo) {}
 } // namespace
 
+// Creates a disassembler for the same target as DT that shares no state with
+// it, so that both can be used from different threads.
+static std::unique_ptr<DisassemblerTarget>
+cloneDisassemblerTarget(const DisassemblerTarget &DT, ObjectFile &Obj) {
+  SubtargetFeatures Features(DT.SubtargetInfo->getFeatureString());
+  auto Clone = std::make_unique<DisassemblerTarget>(
+      DT.TheTarget, Obj, DT.TheTriple.str(), DT.SubtargetInfo->getCPU(),
+      Features);
+  for (StringRef Opt : DisassemblerOptions)
+    Clone->InstPrinter->applyTargetSpecificCLOption(Opt);
+  return Clone;
+}
+
+// Splits the symbols of a section into at most NumShards ranges of about the
+// same size, returned as the indices where the ranges begin followed by
+// Symbols.size(). All symbols at one address end up in the same range.
+static SmallVector<size_t, 0> partitionSymbols(ArrayRef<SymbolInfoTy> Symbols,
+                                               uint64_t SectionAddr,
+                                               uint64_t SectSize,
+                                               uint64_t NumShards) {
+  SmallVector<size_t, 0> Bounds = {0};
+  if (NumShards > 1) {
+    uint64_t ShardSize = divideCeil(SectSize, NumShards);
+    uint64_t NextBound = SectionAddr + ShardSize;
+    for (size_t SI = 1, SE = Symbols.size(); SI != SE; ++SI) {
+      if (Symbols[SI].Addr == Symbols[SI - 1].Addr ||
+          Symbols[SI].Addr < NextBound)
+        continue;
+      Bounds.push_back(SI);
+      NextBound = Symbols[SI].Addr + ShardSize;
+    }
+  }
+  Bounds.push_back(Symbols.size());
+  return Bounds;
+}
+
 static uint8_t getElfSymbolType(const ObjectFile &Obj, const SymbolRef &Sym) {
   assert(Obj.isELF());
   if (auto *Elf32LEObj = dyn_cast<ELF32LEObjectFile>(&Obj))
@@ -1953,6 +1992,25 @@ disassembleObject(ObjectFile &Obj, const ObjectFile &DbgObj,
       WithColor::defaultErrorHandler(std::move(E));
   }
 
+  // With --threads, large sections are disassembled in parallel, unless an
+  // option that keeps state across symbols, or that is not safe to use from
+  // several threads, is in effect.
+  std::optional<DefaultThreadPool> Pool;
+  std::mutex ShardTargetsMutex;
+  std::vector<std::unique_ptr<DisassemblerTarget>> ShardTargets;
+  if (NumThreads != 1 && !SecondaryTarget && !InlineRelocs &&
+      !Obj.isXCOFF() && !PrintSource && !PrintLines &&
+      DbgVariables == DFDisabled && DbgInlinedFunctions == DFDisabled &&
+      !PrimaryTarget.InstPrinter->getUseColor() &&
+      PrimaryTarget.TheTriple.getArch() != Triple::amdgcn &&
+      PrimaryTarget.TheTriple.getArch() != Triple::hexagon) {
+    Pool.emplace(hardware_concurrency(NumThreads));
+    // Looking up branch targets must not insert into AllSymbols once several
+    // threads do it.
+    for (const auto &[Addr, Sec] : SectionAddresses)
+      AllSymbols.try_emplace(Sec);
+  }
+
   for (const SectionRef &Section : ToolSectionFilter(Obj)) {
     if (FilterSections.empty() && !DisassembleAll &&
         (!Section.isText() || Section.isVirtual()))
@@ -2009,9 +2067,6 @@ disassembleObject(ObjectFile &Obj, const ObjectFile &DbgObj,
         Symbols.insert(llvm::lower_bound(Symbols, Sym), Sym);
     }
 
-    SmallString<40> Comments;
-    raw_svector_ostream CommentStream(Comments);
-
     uint64_t VMAAdjustment = 0;
     if (shouldAdjustVA(Section))
       VMAAdjustment = AdjustVMA;
@@ -2020,591 +2075,675 @@ disassembleObject(ObjectFile &Obj, const ObjectFile &DbgObj,
     // Subtract SectionAddr from the r_offset field of a relocation to get
     // the section offset.
     uint64_t RelAdjustment = Obj.isRelocatableObject() ? 0 : SectionAddr;
-    uint64_t Size;
-    uint64_t Index;
     bool PrintedSection = false;
     std::vector<RelocationRef> Rels = RelocMap[Section];
-    std::vector<RelocationRef>::const_iterator RelCur = Rels.begin();
-    std::vector<RelocationRef>::const_iterator RelEnd = Rels.end();
-
-    // Loop over each chunk of code between two points where at least
-    // one symbol is defined.
-    for (size_t SI = 0, SE = Symbols.size(); SI != SE;) {
-      // Advance SI past all the symbols starting at the same address,
-      // and make an ArrayRef of them.
-      unsigned FirstSI = SI;
-      uint64_t Start = Symbols[SI].Addr;
-      ArrayRef<SymbolInfoTy> SymbolsHere;
-      while (SI != SE && Symbols[SI].Addr == Start)
-        ++SI;
-      SymbolsHere = ArrayRef<SymbolInfoTy>(&Symbols[FirstSI], SI - FirstSI);
-
-      // Get the demangled names of all those symbols. We end up with a vector
-      // of StringRef that holds the names we're going to use, and a vector of
-      // std::string that stores the new strings returned by demangle(), if
-      // any. If we don't call demangle() then that vector can stay empty.
-      std::vector<StringRef> SymNamesHere;
-      std::vector<std::string> DemangledSymNamesHere;
-      if (Demangle) {
-        // Fetch the demangled names and store them locally.
-        for (const SymbolInfoTy &Symbol : SymbolsHere)
-          DemangledSymNamesHere.push_back(demangle(Symbol.Name));
-        // Now we've finished modifying that vector, it's safe to make
-        // a vector of StringRefs pointing into it.
-        SymNamesHere.insert(SymNamesHere.begin(), DemangledSymNamesHere.begin(),
-                            DemangledSymNamesHere.end());
-      } else {
-        for (const SymbolInfoTy &Symbol : SymbolsHere)
-          SymNamesHere.push_back(Symbol.Name);
-      }
 
-      // Distinguish ELF data from code symbols, which will be used later on to
-      // decide whether to 'disassemble' this chunk as a data declaration via
-      // dumpELFData(), or whether to treat it as code.
-      //
-      // If data _and_ code symbols are defined at the same address, the code
-      // takes priority, on the grounds that disassembling code is our main
-      // purpose here, and it would be a worse failure to _not_ interpret
-      // something that _was_ meaningful as code than vice versa.
-      //
-      // Any ELF symbol type that is not clearly data will be regarded as code.
-      // In particular, one of the uses of STT_NOTYPE is for branch targets
-      // inside functions, for which STT_FUNC would be inaccurate.
-      //
-      // So here, we spot whether there's any non-data symbol present at all,
-      // and only set the DisassembleAsELFData flag if there isn't. Also, we use
-      // this distinction to inform the decision of which symbol to print at
-      // the head of the section, so that if we're printing code, we print a
-      // code-related symbol name to go with it.
-      bool DisassembleAsELFData = false;
-      size_t DisplaySymIndex = SymbolsHere.size() - 1;
-      if (Obj.isELF() && !DisassembleAll && Section.isText()) {
-        DisassembleAsELFData = true; // unless we find a code symbol below
+    std::string SectionHeader = "\nDisassembly of section ";
+    if (!SegmentName.empty())
+      SectionHeader += (SegmentName + ",").str();
+    SectionHeader += (SectionName + ":\n").str();
+
+    // Disassembles the chunks of code starting at Symbols[SIBegin] up to, but
+    // not including, Symbols[SIEnd]. DT carries the target selected by mapping
+    // symbols over to the next call.
+    auto DisassembleSymbols = [&](size_t SIBegin, size_t SIEnd,
+                                  DisassemblerTarget *&DT,
+                                  LiveElementPrinter &LEP,
+                                  bool &PrintedSection,
+                                  StringSet<> &FoundDisasmSymbolSet,
+                                  raw_ostream &OS) {
+      SmallString<40> Comments;
+      raw_svector_ostream CommentStream(Comments);
+      uint64_t Size;
+      uint64_t Index;
+      std::vector<RelocationRef>::const_iterator RelCur = Rels.begin();
+      std::vector<RelocationRef>::const_iterator RelEnd = Rels.end();
+      // Loop over each chunk of code between two points where at least
+      // one symbol is defined.
+      for (size_t SI = SIBegin, SE = Symbols.size(); SI != SIEnd;) {
+        // Advance SI past all the symbols starting at the same address,
+        // and make an ArrayRef of them.
+        unsigned FirstSI = SI;
+        uint64_t Start = Symbols[SI].Addr;
+        ArrayRef<SymbolInfoTy> SymbolsHere;
+        while (SI != SE && Symbols[SI].Addr == Start)
+          ++SI;
+        SymbolsHere = ArrayRef<SymbolInfoTy>(&Symbols[FirstSI], SI - FirstSI);
+
+        // Get the demangled names of all those symbols. We end up with a vector
+        // of StringRef that holds the names we're going to use, and a vector of
+        // std::string that stores the new strings returned by demangle(), if
+        // any. If we don't call demangle() then that vector can stay empty.
+        std::vector<StringRef> SymNamesHere;
+        std::vector<std::string> DemangledSymNamesHere;
+        if (Demangle) {
+          // Fetch the demangled names and store them locally.
+          for (const SymbolInfoTy &Symbol : SymbolsHere)
+            DemangledSymNamesHere.push_back(demangle(Symbol.Name));
+          // Now we've finished modifying that vector, it's safe to make
+          // a vector of StringRefs pointing into it.
+          SymNamesHere.insert(SymNamesHere.begin(),
+                              DemangledSymNamesHere.begin(),
+                              DemangledSymNamesHere.end());
+        } else {
+          for (const SymbolInfoTy &Symbol : SymbolsHere)
+            SymNamesHere.push_back(Symbol.Name);
+        }
 
-        for (size_t i = 0; i < SymbolsHere.size(); ++i) {
-          uint8_t SymTy = SymbolsHere[i].Type;
-          if (SymTy != ELF::STT_OBJECT && SymTy != ELF::STT_COMMON) {
-            DisassembleAsELFData = false;
-            DisplaySymIndex = i;
+        // Distinguish ELF data from code symbols, which will be used later on
+        // to decide whether to 'disassemble' this chunk as a data declaration
+        // via dumpELFData(), or whether to treat it as code.
+        //
+        // If data _and_ code symbols are defined at the same address, the code
+        // takes priority, on the grounds that disassembling code is our main
+        // purpose here, and it would be a worse failure to _not_ interpret
+        // something that _was_ meaningful as code than vice versa.
+        //
+        // Any ELF symbol type that is not clearly data will be regarded as
+        // code. In particular, one of the uses of STT_NOTYPE is for branch
+        // targets inside functions, for which STT_FUNC would be inaccurate.
+        //
+        // So here, we spot whether there's any non-data symbol present at all,
+        // and only set the DisassembleAsELFData flag if there isn't. Also, we
+        // use this distinction to inform the decision of which symbol to print
+        // at the head of the section, so that if we're printing code, we print
+        // a code-related symbol name to go with it.
+        bool DisassembleAsELFData = false;
+        size_t DisplaySymIndex = SymbolsHere.size() - 1;
+        if (Obj.isELF() && !DisassembleAll && Section.isText()) {
+          DisassembleAsELFData = true; // unless we find a code symbol below
+
+          for (size_t i = 0; i < SymbolsHere.size(); ++i) {
+            uint8_t SymTy = SymbolsHere[i].Type;
+            if (SymTy != ELF::STT_OBJECT && SymTy != ELF::STT_COMMON) {
+              DisassembleAsELFData = false;
+              DisplaySymIndex = i;
+            }
           }
         }
-      }
 
-      // Decide which symbol(s) from this collection we're going to print.
-      std::vector<bool> SymsToPrint(SymbolsHere.size(), false);
-      // If the user has given the --disassemble-symbols option, then we must
-      // display every symbol in that set, and no others.
-      if (!DisasmSymbolSet.empty()) {
-        bool FoundAny = false;
-        for (size_t i = 0; i < SymbolsHere.size(); ++i) {
-          if (DisasmSymbolSet.count(SymNamesHere[i])) {
-            SymsToPrint[i] = true;
-            FoundAny = true;
+        // Decide which symbol(s) from this collection we're going to print.
+        std::vector<bool> SymsToPrint(SymbolsHere.size(), false);
+        // If the user has given the --disassemble-symbols option, then we must
+        // display every symbol in that set, and no others.
+        if (!DisasmSymbolSet.empty()) {
+          bool FoundAny = false;
+          for (size_t i = 0; i < SymbolsHere.size(); ++i) {
+            if (DisasmSymbolSet.count(SymNamesHere[i])) {
+              SymsToPrint[i] = true;
+              FoundAny = true;
+            }
           }
+
+          // And if none of the symbols here is one that the user asked for,
+          // skip disassembling this entire chunk of code.
+          if (!FoundAny)
+            continue;
+        } else if (!SymbolsHere[DisplaySymIndex].IsMappingSymbol) {
+          // Otherwise, print whichever symbol at this location is last in the
+          // Symbols array, because that array is pre-sorted in a way intended
+          // to correlate with priority of which symbol to display.
+          SymsToPrint[DisplaySymIndex] = true;
         }
 
-        // And if none of the symbols here is one that the user asked for, skip
-        // disassembling this entire chunk of code.
-        if (!FoundAny)
-          continue;
-      } else if (!SymbolsHere[DisplaySymIndex].IsMappingSymbol) {
-        // Otherwise, print whichever symbol at this location is last in the
-        // Symbols array, because that array is pre-sorted in a way intended to
-        // correlate with priority of which symbol to display.
-        SymsToPrint[DisplaySymIndex] = true;
-      }
+        // Now that we know we're disassembling this section, override the
+        // choice of which symbols to display by printing _all_ of them at this
+        // address if the user asked for all symbols.
+        //
+        // That way, '--show-all-symbols --disassemble-symbol=foo' will print
+        // only the chunk of code headed by 'foo', but also show any other
+        // symbols defined at that address, such as aliases for 'foo', or the
+        // ARM mapping symbol preceding its code.
+        if (ShowAllSymbols) {
+          for (size_t i = 0; i < SymbolsHere.size(); ++i)
+            SymsToPrint[i] = true;
+        }
 
-      // Now that we know we're disassembling this section, override the choice
-      // of which symbols to display by printing _all_ of them at this address
-      // if the user asked for all symbols.
-      //
-      // That way, '--show-all-symbols --disassemble-symbol=foo' will print
-      // only the chunk of code headed by 'foo', but also show any other
-      // symbols defined at that address, such as aliases for 'foo', or the ARM
-      // mapping symbol preceding its code.
-      if (ShowAllSymbols) {
-        for (size_t i = 0; i < SymbolsHere.size(); ++i)
-          SymsToPrint[i] = true;
-      }
+        if (Start < SectionAddr || StopAddress <= Start)
+          continue;
 
-      if (Start < SectionAddr || StopAddress <= Start)
-        continue;
+        FoundDisasmSymbolSet.insert_range(SymNamesHere);
 
-      FoundDisasmSymbolSet.insert_range(SymNamesHere);
+        // The end is the section end, the beginning of the next symbol, or
+        // --stop-address.
+        uint64_t End = std::min<uint64_t>(SectionAddr + SectSize, StopAddress);
+        if (SI < SE)
+          End = std::min(End, Symbols[SI].Addr);
+        if (Start >= End || End <= StartAddress)
+          continue;
+        Start -= SectionAddr;
+        End -= SectionAddr;
 
-      // The end is the section end, the beginning of the next symbol, or
-      // --stop-address.
-      uint64_t End = std::min<uint64_t>(SectionAddr + SectSize, StopAddress);
-      if (SI < SE)
-        End = std::min(End, Symbols[SI].Addr);
-      if (Start >= End || End <= StartAddress)
-        continue;
-      Start -= SectionAddr;
-      End -= SectionAddr;
-
-      if (!PrintedSection) {
-        PrintedSection = true;
-        OS << "\nDisassembly of section ";
-        if (!SegmentName.empty())
-          OS << SegmentName << ",";
-        OS << SectionName << ":\n";
-      }
+        if (!PrintedSection) {
+          PrintedSection = true;
+          OS << SectionHeader;
+        }
 
-      bool PrintedLabel = false;
-      for (size_t i = 0; i < SymbolsHere.size(); ++i) {
-        if (!SymsToPrint[i])
-          continue;
+        bool PrintedLabel = false;
+        for (size_t i = 0; i < SymbolsHere.size(); ++i) {
+          if (!SymsToPrint[i])
+            continue;
 
-        const SymbolInfoTy &Symbol = SymbolsHere[i];
-        const StringRef SymbolName = SymNamesHere[i];
+          const SymbolInfoTy &Symbol = SymbolsHere[i];
+          const StringRef SymbolName = SymNamesHere[i];
 
-        if (!PrintedLabel) {
-          OS << '\n';
-          PrintedLabel = true;
+          if (!PrintedLabel) {
+            OS << '\n';
+            PrintedLabel = true;
+          }
+          if (LeadingAddr)
+            OS << format(Is64Bits ? "%016" PRIx64 " " : "%08" PRIx64 " ",
+                         SectionAddr + Start + VMAAdjustment);
+          if (Obj.isXCOFF() && SymbolDescription) {
+            OS << getXCOFFSymbolDescription(Symbol, SymbolName) << ":\n";
+          } else
+            OS << '<' << SymbolName << ">:\n";
         }
-        if (LeadingAddr)
-          OS << format(Is64Bits ? "%016" PRIx64 " " : "%08" PRIx64 " ",
-                       SectionAddr + Start + VMAAdjustment);
-        if (Obj.isXCOFF() && SymbolDescription) {
-          OS << getXCOFFSymbolDescription(Symbol, SymbolName) << ":\n";
-        } else
-          OS << '<' << SymbolName << ">:\n";
-      }
 
-      // Don't print raw contents of a virtual section. A virtual section
-      // doesn't have any contents in the file.
-      if (Section.isVirtual()) {
-        OS << "...\n";
-        continue;
-      }
-
-      // See if any of the symbols defined at this location triggers target-
-      // specific disassembly behavior, e.g. of special descriptors or function
-      // prelude information.
-      //
-      // We stop this loop at the first symbol that triggers some kind of
-      // interesting behavior (if any), on the assumption that if two symbols
-      // defined at the same address trigger two conflicting symbol handlers,
-      // the object file is probably confused anyway, and it would make even
-      // less sense to present the output of _both_ handlers, because that
-      // would describe the same data twice.
-      for (size_t SHI = 0; SHI < SymbolsHere.size(); ++SHI) {
-        SymbolInfoTy Symbol = SymbolsHere[SHI];
-
-        Expected<bool> RespondedOrErr = DT->DisAsm->onSymbolStart(
-            Symbol, Size, Bytes.slice(Start, End - Start), SectionAddr + Start);
-
-        if (RespondedOrErr && !*RespondedOrErr) {
-          // This symbol didn't trigger any interesting handling. Try the other
-          // symbols defined at this address.
+        // Don't print raw contents of a virtual section. A virtual section
+        // doesn't have any contents in the file.
+        if (Section.isVirtual()) {
+          OS << "...\n";
           continue;
         }
 
-        // If onSymbolStart returned an Error, that means it identified some
-        // kind of special data at this address, but wasn't able to disassemble
-        // it meaningfully. So we fall back to printing the error out and
-        // disassembling the failed region as bytes, assuming that the target
-        // detected the failure before printing anything.
-        if (!RespondedOrErr) {
-          std::string ErrMsgStr = toString(RespondedOrErr.takeError());
-          StringRef ErrMsg = ErrMsgStr;
-          do {
-            StringRef Line;
-            std::tie(Line, ErrMsg) = ErrMsg.split('\n');
-            OS << DT->Context->getAsmInfo()->getCommentString()
-               << " error decoding " << SymNamesHere[SHI] << ": " << Line
-               << '\n';
-          } while (!ErrMsg.empty());
-
-          if (Size) {
-            OS << DT->Context->getAsmInfo()->getCommentString()
-               << " decoding failed region as bytes\n";
-            for (uint64_t I = 0; I < Size; ++I)
-              OS << "\t.byte\t " << format_hex(Bytes[I], 1, /*Upper=*/true)
-                 << '\n';
+        // See if any of the symbols defined at this location triggers target-
+        // specific disassembly behavior, e.g. of special descriptors or
+        // function prelude information.
+        //
+        // We stop this loop at the first symbol that triggers some kind of
+        // interesting behavior (if any), on the assumption that if two symbols
+        // defined at the same address trigger two conflicting symbol handlers,
+        // the object file is probably confused anyway, and it would make even
+        // less sense to present the output of _both_ handlers, because that
+        // would describe the same data twice.
+        for (size_t SHI = 0; SHI < SymbolsHere.size(); ++SHI) {
+          SymbolInfoTy Symbol = SymbolsHere[SHI];
+
+          Expected<bool> RespondedOrErr =
+              DT->DisAsm->onSymbolStart(Symbol, Size,
+                                        Bytes.slice(Start, End - Start),
+                                        SectionAddr + Start);
+
+          if (RespondedOrErr && !*RespondedOrErr) {
+            // This symbol didn't trigger any interesting handling. Try the
+            // other symbols defined at this address.
+            continue;
           }
-        }
 
-        // Regardless of whether onSymbolStart returned an Error or true, 'Size'
-        // will have been set to the amount of data covered by whatever prologue
-        // the target identified. So we advance our own position to beyond that.
-        // Sometimes that will be the entire distance to the next symbol, and
-        // sometimes it will be just a prologue and we should start
-        // disassembling instructions from where it left off.
-        Start += Size;
-        break;
-      }
-      // Allow targets to reset any per-symbol state.
-      DT->Printer->onSymbolStart();
-      formatted_raw_ostream FOS(OS);
-      Index = Start;
-      if (SectionAddr < StartAddress)
-        Index = std::max<uint64_t>(Index, StartAddress - SectionAddr);
-
-      if (DisassembleAsELFData) {
-        dumpELFData(SectionAddr, Index, End, Bytes, FOS);
-        Index = End;
-        continue;
-      }
+          // If onSymbolStart returned an Error, that means it identified some
+          // kind of special data at this address, but wasn't able to
+          // disassemble it meaningfully. So we fall back to printing the error
+          // out and disassembling the failed region as bytes, assuming that the
+          // target detected the failure before printing anything.
+          if (!RespondedOrErr) {
+            std::string ErrMsgStr = toString(RespondedOrErr.takeError());
+            StringRef ErrMsg = ErrMsgStr;
+            do {
+              StringRef Line;
+              std::tie(Line, ErrMsg) = ErrMsg.split('\n');
+              OS << DT->Context->getAsmInfo()->getCommentString()
+                 << " error decoding " << SymNamesHere[SHI] << ": " << Line
+                 << '\n';
+            } while (!ErrMsg.empty());
+
+            if (Size) {
+              OS << DT->Context->getAsmInfo()->getCommentString()
+                 << " decoding failed region as bytes\n";
+              for (uint64_t I = 0; I < Size; ++I)
+                OS << "\t.byte\t " << format_hex(Bytes[I], 1, /*Upper=*/true)
+                   << '\n';
+            }
+          }
 
-      // Skip relocations from symbols that are not dumped.
-      for (; RelCur != RelEnd; ++RelCur) {
-        uint64_t Offset = RelCur->getOffset() - RelAdjustment;
-        if (Index <= Offset)
+          // Regardless of whether onSymbolStart returned an Error or true,
+          // 'Size' will have been set to the amount of data covered by whatever
+          // prologue the target identified. So we advance our own position to
+          // beyond that. Sometimes that will be the entire distance to the next
+          // symbol, and sometimes it will be just a prologue and we should
+          // start disassembling instructions from where it left off.
+          Start += Size;
           break;
-      }
+        }
+        // Allow targets to reset any per-symbol state.
+        DT->Printer->onSymbolStart();
+        formatted_raw_ostream FOS(OS);
+        Index = Start;
+        if (SectionAddr < StartAddress)
+          Index = std::max<uint64_t>(Index, StartAddress - SectionAddr);
+
+        if (DisassembleAsELFData) {
+          dumpELFData(SectionAddr, Index, End, Bytes, FOS);
+          Index = End;
+          continue;
+        }
 
-      bool DumpARMELFData = false;
-      bool DumpTracebackTableForXCOFFFunction =
-          Obj.isXCOFF() && Section.isText() && TracebackTable &&
-          Symbols[SI - 1].XCOFFSymInfo.StorageMappingClass &&
-          (*Symbols[SI - 1].XCOFFSymInfo.StorageMappingClass == XCOFF::XMC_PR);
-
-      std::unordered_map<uint64_t, std::string> AllLabels;
-      std::unordered_map<uint64_t, std::vector<BBAddrMapLabel>> BBAddrMapLabels;
-      if (SymbolizeOperands) {
-        collectLocalBranchTargets(Bytes, DT->InstrAnalysis.get(),
-                                  DT->DisAsm.get(), DT->InstPrinter.get(),
-                                  PrimaryTarget.SubtargetInfo.get(),
-                                  SectionAddr, Index, End, AllLabels);
-        collectBBAddrMapLabels(FullAddrMap, SectionAddr, Index, End,
-                               BBAddrMapLabels);
-      }
+        // Skip relocations from symbols that are not dumped.
+        for (; RelCur != RelEnd; ++RelCur) {
+          uint64_t Offset = RelCur->getOffset() - RelAdjustment;
+          if (Index <= Offset)
+            break;
+        }
 
-      if (DT->InstrAnalysis)
-        DT->InstrAnalysis->resetState();
-
-      while (Index < End) {
-        uint64_t RelOffset;
-
-        // ARM and AArch64 ELF binaries can interleave data and text in the
-        // same section. We rely on the markers introduced to understand what
-        // we need to dump. If the data marker is within a function, it is
-        // denoted as a word/short etc.
-        if (!MappingSymbols.empty()) {
-          char Kind = getMappingSymbolKind(MappingSymbols, Index);
-          DumpARMELFData = Kind == 'd';
-          if (SecondaryTarget) {
-            if (Kind == 'a') {
-              DT = PrimaryIsThumb ? &*SecondaryTarget : &PrimaryTarget;
-            } else if (Kind == 't') {
-              DT = PrimaryIsThumb ? &PrimaryTarget : &*SecondaryTarget;
+        bool DumpARMELFData = false;
+        bool DumpTracebackTableForXCOFFFunction =
+            Obj.isXCOFF() && Section.isText() && TracebackTable &&
+            Symbols[SI - 1].XCOFFSymInfo.StorageMappingClass &&
+            (*Symbols[SI - 1].XCOFFSymInfo.StorageMappingClass ==
+             XCOFF::XMC_PR);
+
+        std::unordered_map<uint64_t, std::string> AllLabels;
+        std::unordered_map<uint64_t, std::vector<BBAddrMapLabel>>
+            BBAddrMapLabels;
+        if (SymbolizeOperands) {
+          collectLocalBranchTargets(Bytes, DT->InstrAnalysis.get(),
+                                    DT->DisAsm.get(), DT->InstPrinter.get(),
+                                    PrimaryTarget.SubtargetInfo.get(),
+                                    SectionAddr, Index, End, AllLabels);
+          collectBBAddrMapLabels(FullAddrMap, SectionAddr, Index, End,
+                                 BBAddrMapLabels);
+        }
+
+        if (DT->InstrAnalysis)
+          DT->InstrAnalysis->resetState();
+
+        while (Index < End) {
+          uint64_t RelOffset;
+
+          // ARM and AArch64 ELF binaries can interleave data and text in the
+          // same section. We rely on the markers introduced to understand what
+          // we need to dump. If the data marker is within a function, it is
+          // denoted as a word/short etc.
+          if (!MappingSymbols.empty()) {
+            char Kind = getMappingSymbolKind(MappingSymbols, Index);
+            DumpARMELFData = Kind == 'd';
+            if (SecondaryTarget) {
+              if (Kind == 'a') {
+                DT = PrimaryIsThumb ? &*SecondaryTarget : &PrimaryTarget;
+              } else if (Kind == 't') {
+                DT = PrimaryIsThumb ? &PrimaryTarget : &*SecondaryTarget;
+              }
+            }
+          } else if (!CHPECodeMap.empty()) {
+            uint64_t Address = SectionAddr + Index;
+            auto It = partition_point(
+                CHPECodeMap,
+                [Address](const std::pair<uint64_t, uint64_t> &Entry) {
+                  return Entry.first <= Address;
+                });
+            if (It != CHPECodeMap.begin() && Address < (It - 1)->second) {
+              DT = &*SecondaryTarget;
+            } else {
+              DT = &PrimaryTarget;
+              // X64 disassembler range may have left Index unaligned, so
+              // make sure that it's aligned when we switch back to ARM64
+              // code.
+              Index = llvm::alignTo(Index, 4);
+              if (Index >= End)
+                break;
             }
           }
-        } else if (!CHPECodeMap.empty()) {
-          uint64_t Address = SectionAddr + Index;
-          auto It = partition_point(
-              CHPECodeMap,
-              [Address](const std::pair<uint64_t, uint64_t> &Entry) {
-                return Entry.first <= Address;
-              });
-          if (It != CHPECodeMap.begin() && Address < (It - 1)->second) {
-            DT = &*SecondaryTarget;
-          } else {
-            DT = &PrimaryTarget;
-            // X64 disassembler range may have left Index unaligned, so
-            // make sure that it's aligned when we switch back to ARM64
-            // code.
-            Index = llvm::alignTo(Index, 4);
-            if (Index >= End)
-              break;
-          }
-        }
 
-        auto findRel = [&]() {
-          while (RelCur != RelEnd) {
-            RelOffset = RelCur->getOffset() - RelAdjustment;
-            // If this relocation is hidden, skip it.
-            if (getHidden(*RelCur) || SectionAddr + RelOffset < StartAddress) {
+          auto findRel = [&]() {
+            while (RelCur != RelEnd) {
+              RelOffset = RelCur->getOffset() - RelAdjustment;
+              // If this relocation is hidden, skip it.
+              if (getHidden(*RelCur) ||
+                  SectionAddr + RelOffset < StartAddress) {
+                ++RelCur;
+                continue;
+              }
+
+              // Stop when RelCur's offset is past the disassembled
+              // instruction/data.
+              if (RelOffset >= Index + Size)
+                return false;
+              if (RelOffset >= Index)
+                return true;
               ++RelCur;
+            }
+            return false;
+          };
+
+          // When -z or --disassemble-zeroes are given we always dissasemble
+          // them. Otherwise we might want to skip zero bytes we see.
+          if (!DisassembleZeroes) {
+            uint64_t MaxOffset = End - Index;
+            // For --reloc: print zero blocks patched by relocations, so that
+            // relocations can be shown in the dump.
+            if (InlineRelocs && RelCur != RelEnd)
+              MaxOffset = std::min(RelCur->getOffset() - RelAdjustment - Index,
+                                   MaxOffset);
+
+            if (size_t N =
+                    countSkippableZeroBytes(Bytes.slice(Index, MaxOffset))) {
+              FOS << "\t\t..." << '\n';
+              Index += N;
               continue;
             }
-
-            // Stop when RelCur's offset is past the disassembled
-            // instruction/data.
-            if (RelOffset >= Index + Size)
-              return false;
-            if (RelOffset >= Index)
-              return true;
-            ++RelCur;
           }
-          return false;
-        };
-
-        // When -z or --disassemble-zeroes are given we always dissasemble
-        // them. Otherwise we might want to skip zero bytes we see.
-        if (!DisassembleZeroes) {
-          uint64_t MaxOffset = End - Index;
-          // For --reloc: print zero blocks patched by relocations, so that
-          // relocations can be shown in the dump.
-          if (InlineRelocs && RelCur != RelEnd)
-            MaxOffset = std::min(RelCur->getOffset() - RelAdjustment - Index,
-                                 MaxOffset);
-
-          if (size_t N =
-                  countSkippableZeroBytes(Bytes.slice(Index, MaxOffset))) {
-            FOS << "\t\t..." << '\n';
-            Index += N;
-            continue;
-          }
-        }
 
-        if (DumpARMELFData) {
-          Size = dumpARMELFData(SectionAddr, Index, End, Obj, Bytes,
-                                MappingSymbols, *DT->SubtargetInfo, FOS);
-        } else {
+          if (DumpARMELFData) {
+            Size = dumpARMELFData(SectionAddr, Index, End, Obj, Bytes,
+                                  MappingSymbols, *DT->SubtargetInfo, FOS);
+          } else {
 
-          if (DumpTracebackTableForXCOFFFunction &&
-              doesXCOFFTracebackTableBegin(Bytes.slice(Index, 4))) {
-            dumpTracebackTable(Bytes.slice(Index),
-                               SectionAddr + Index + VMAAdjustment, FOS,
-                               SectionAddr + End + VMAAdjustment,
-                               *DT->SubtargetInfo, cast<XCOFFObjectFile>(&Obj));
-            Index = End;
-            continue;
-          }
+            if (DumpTracebackTableForXCOFFFunction &&
+                doesXCOFFTracebackTableBegin(Bytes.slice(Index, 4))) {
+              dumpTracebackTable(Bytes.slice(Index),
+                                 SectionAddr + Index + VMAAdjustment, FOS,
+                                 SectionAddr + End + VMAAdjustment,
+                                 *DT->SubtargetInfo,
+                                 cast<XCOFFObjectFile>(&Obj));
+              Index = End;
+              continue;
+            }
 
-          // Print local label if there's any.
-          auto Iter1 = BBAddrMapLabels.find(SectionAddr + Index);
-          if (Iter1 != BBAddrMapLabels.end()) {
-            for (const auto &BBLabel : Iter1->second)
-              FOS << "<" << BBLabel.BlockLabel << ">" << BBLabel.PGOAnalysis
-                  << ":\n";
-          } else {
-            auto Iter2 = AllLabels.find(SectionAddr + Index);
-            if (Iter2 != AllLabels.end())
-              FOS << "<" << Iter2->second << ">:\n";
-          }
+            // Print local label if there's any.
+            auto Iter1 = BBAddrMapLabels.find(SectionAddr + Index);
+            if (Iter1 != BBAddrMapLabels.end()) {
+              for (const auto &BBLabel : Iter1->second)
+                FOS << "<" << BBLabel.BlockLabel << ">" << BBLabel.PGOAnalysis
+                    << ":\n";
+            } else {
+              auto Iter2 = AllLabels.find(SectionAddr + Index);
+              if (Iter2 != AllLabels.end())
+                FOS << "<" << Iter2->second << ">:\n";
+            }
 
-          // Disassemble a real instruction or a data when disassemble all is
-          // provided
-          MCInst Inst;
-          ArrayRef<uint8_t> ThisBytes = Bytes.slice(Index);
-          uint64_t ThisAddr = SectionAddr + Index + VMAAdjustment;
-          bool Disassembled = DT->DisAsm->getInstruction(
-              Inst, Size, ThisBytes, ThisAddr, CommentStream);
-          if (Size == 0)
-            Size = std::min<uint64_t>(
-                ThisBytes.size(),
-                DT->DisAsm->suggestBytesToSkip(ThisBytes, ThisAddr));
-
-          LEP.update({ThisAddr, Section.getIndex()},
-                     {ThisAddr + Size, Section.getIndex()},
-                     Index + Size != End);
-
-          DT->InstPrinter->setCommentStream(CommentStream);
-
-          DT->Printer->printInst(
-              *DT->InstPrinter, Disassembled ? &Inst : nullptr,
-              Bytes.slice(Index, Size),
-              {SectionAddr + Index + VMAAdjustment, Section.getIndex()}, FOS,
-              "", *DT->SubtargetInfo, &SP, Obj.getFileName(), &Rels, LEP);
-
-          DT->InstPrinter->setCommentStream(llvm::nulls());
-
-          // If disassembly succeeds, we try to resolve the target address
-          // (jump target or memory operand address) and print it to the
-          // right of the instruction.
-          //
-          // Otherwise, we don't print anything else so that we avoid
-          // analyzing invalid or incomplete instruction information.
-          if (Disassembled && DT->InstrAnalysis) {
-            llvm::raw_ostream *TargetOS = &FOS;
-            uint64_t Target;
-            bool PrintTarget = DT->InstrAnalysis->evaluateBranch(
-                Inst, SectionAddr + Index, Size, Target);
-
-            if (!PrintTarget) {
-              if (std::optional<uint64_t> MaybeTarget =
-                      DT->InstrAnalysis->evaluateMemoryOperandAddress(
-                          Inst, DT->SubtargetInfo.get(), SectionAddr + Index,
-                          Size)) {
-                Target = *MaybeTarget;
-                PrintTarget = true;
-                // Do not print real address when symbolizing.
-                if (!SymbolizeOperands) {
-                  // Memory operand addresses are printed as comments.
-                  TargetOS = &CommentStream;
-                  *TargetOS << "0x" << Twine::utohexstr(Target);
+            // Disassemble a real instruction or a data when disassemble all is
+            // provided
+            MCInst Inst;
+            ArrayRef<uint8_t> ThisBytes = Bytes.slice(Index);
+            uint64_t ThisAddr = SectionAddr + Index + VMAAdjustment;
+            bool Disassembled = DT->DisAsm->getInstruction(
+                Inst, Size, ThisBytes, ThisAddr, CommentStream);
+            if (Size == 0)
+              Size = std::min<uint64_t>(
+                  ThisBytes.size(),
+                  DT->DisAsm->suggestBytesToSkip(ThisBytes, ThisAddr));
+
+            LEP.update({ThisAddr, Section.getIndex()},
+                       {ThisAddr + Size, Section.getIndex()},
+                       Index + Size != End);
+
+            DT->InstPrinter->setCommentStream(CommentStream);
+
+            DT->Printer->printInst(
+                *DT->InstPrinter, Disassembled ? &Inst : nullptr,
+                Bytes.slice(Index, Size),
+                {SectionAddr + Index + VMAAdjustment, Section.getIndex()}, FOS,
+                "", *DT->SubtargetInfo, &SP, Obj.getFileName(), &Rels, LEP);
+
+            DT->InstPrinter->setCommentStream(llvm::nulls());
+
+            // If disassembly succeeds, we try to resolve the target address
+            // (jump target or memory operand address) and print it to the
+            // right of the instruction.
+            //
+            // Otherwise, we don't print anything else so that we avoid
+            // analyzing invalid or incomplete instruction information.
+            if (Disassembled && DT->InstrAnalysis) {
+              llvm::raw_ostream *TargetOS = &FOS;
+              uint64_t Target;
+              bool PrintTarget = DT->InstrAnalysis->evaluateBranch(
+                  Inst, SectionAddr + Index, Size, Target);
+
+              if (!PrintTarget) {
+                if (std::optional<uint64_t> MaybeTarget =
+                        DT->InstrAnalysis->evaluateMemoryOperandAddress(
+                            Inst, DT->SubtargetInfo.get(), SectionAddr + Index,
+                            Size)) {
+                  Target = *MaybeTarget;
+                  PrintTarget = true;
+                  // Do not print real address when symbolizing.
+                  if (!SymbolizeOperands) {
+                    // Memory operand addresses are printed as comments.
+                    TargetOS = &CommentStream;
+                    *TargetOS << "0x" << Twine::utohexstr(Target);
+                  }
                 }
               }
-            }
 
-            if (PrintTarget) {
-              // In a relocatable object, the target's section must reside in
-              // the same section as the call instruction or it is accessed
-              // through a relocation.
-              //
-              // In a non-relocatable object, the target may be in any section.
-              // In that case, locate the section(s) containing the target
-              // address and find the symbol in one of those, if possible.
-              //
-              // N.B. Except for XCOFF, we don't walk the relocations in the
-              // relocatable case yet.
-              std::vector<const SectionSymbolsTy *> TargetSectionSymbols;
-              if (!Obj.isRelocatableObject()) {
-                auto It = llvm::partition_point(
-                    SectionAddresses,
-                    [=](const std::pair<uint64_t, SectionRef> &O) {
-                      return O.first <= Target;
-                    });
-                uint64_t TargetSecAddr = 0;
-                while (It != SectionAddresses.begin()) {
-                  --It;
-                  if (TargetSecAddr == 0)
-                    TargetSecAddr = It->first;
-                  if (It->first != TargetSecAddr)
-                    break;
-                  TargetSectionSymbols.push_back(&AllSymbols[It->second]);
+              if (PrintTarget) {
+                // In a relocatable object, the target's section must reside in
+                // the same section as the call instruction or it is accessed
+                // through a relocation.
+                //
+                // In a non-relocatable object, the target may be in any
+                // section. In that case, locate the section(s) containing the
+                // target address and find the symbol in one of those, if
+                // possible.
+                //
+                // N.B. Except for XCOFF, we don't walk the relocations in the
+                // relocatable case yet.
+                std::vector<const SectionSymbolsTy *> TargetSectionSymbols;
+                if (!Obj.isRelocatableObject()) {
+                  auto It = llvm::partition_point(
+                      SectionAddresses,
+                      [=](const std::pair<uint64_t, SectionRef> &O) {
+                        return O.first <= Target;
+                      });
+                  uint64_t TargetSecAddr = 0;
+                  while (It != SectionAddresses.begin()) {
+                    --It;
+                    if (TargetSecAddr == 0)
+                      TargetSecAddr = It->first;
+                    if (It->first != TargetSecAddr)
+                      break;
+                    TargetSectionSymbols.push_back(&AllSymbols[It->second]);
+                  }
+                } else {
+                  TargetSectionSymbols.push_back(&Symbols);
                 }
-              } else {
-                TargetSectionSymbols.push_back(&Symbols);
-              }
-              TargetSectionSymbols.push_back(&AbsoluteSymbols);
-
-              // Find the last symbol in the first candidate section whose
-              // offset is less than or equal to the target. If there are no
-              // such symbols, try in the next section and so on, before finally
-              // using the nearest preceding absolute symbol (if any), if there
-              // are no other valid symbols.
-              const SymbolInfoTy *TargetSym = nullptr;
-              for (const SectionSymbolsTy *TargetSymbols :
-                   TargetSectionSymbols) {
-                auto It = llvm::partition_point(
-                    *TargetSymbols,
-                    [=](const SymbolInfoTy &O) { return O.Addr <= Target; });
-                while (It != TargetSymbols->begin()) {
-                  --It;
-                  // Skip mapping symbols to avoid possible ambiguity as they
-                  // do not allow uniquely identifying the target address.
-                  if (!It->IsMappingSymbol) {
-                    TargetSym = &*It;
-                    break;
+                TargetSectionSymbols.push_back(&AbsoluteSymbols);
+
+                // Find the last symbol in the first candidate section whose
+                // offset is less than or equal to the target. If there are no
+                // such symbols, try in the next section and so on, before
+                // finally using the nearest preceding absolute symbol (if any),
+                // if there are no other valid symbols.
+                const SymbolInfoTy *TargetSym = nullptr;
+                for (const SectionSymbolsTy *TargetSymbols :
+                     TargetSectionSymbols) {
+                  auto It = llvm::partition_point(
+                      *TargetSymbols,
+                      [=](const SymbolInfoTy &O) { return O.Addr <= Target; });
+                  while (It != TargetSymbols->begin()) {
+                    --It;
+                    // Skip mapping symbols to avoid possible ambiguity as they
+                    // do not allow uniquely identifying the target address.
+                    if (!It->IsMappingSymbol) {
+                      TargetSym = &*It;
+                      break;
+                    }
                   }
+                  if (TargetSym)
+                    break;
                 }
-                if (TargetSym)
-                  break;
-              }
 
-              // Branch targets are printed just after the instructions.
-              // Print the labels corresponding to the target if there's any.
-              bool BBAddrMapLabelAvailable = BBAddrMapLabels.count(Target);
-              bool LabelAvailable = AllLabels.count(Target);
-
-              if (TargetSym != nullptr) {
-                uint64_t TargetAddress = TargetSym->Addr;
-                uint64_t Disp = Target - TargetAddress;
-                std::string TargetName = Demangle ? demangle(TargetSym->Name)
-                                                  : TargetSym->Name.str();
-                bool RelFixedUp = false;
-                SmallString<32> Val;
-
-                *TargetOS << " <";
-                // On XCOFF, we use relocations, even without -r, so we
-                // can print the correct name for an extern function call.
-                if (Obj.isXCOFF() && findRel()) {
-                  // Check for possible branch relocations and
-                  // branches to fixup code.
-                  bool BranchRelocationType = true;
-                  XCOFF::RelocationType RelocType;
-                  if (Obj.is64Bit()) {
-                    const XCOFFRelocation64 *Reloc =
-                        reinterpret_cast<XCOFFRelocation64 *>(
-                            RelCur->getRawDataRefImpl().p);
-                    RelFixedUp = Reloc->isFixupIndicated();
-                    RelocType = Reloc->Type;
+                // Branch targets are printed just after the instructions.
+                // Print the labels corresponding to the target if there's any.
+                bool BBAddrMapLabelAvailable = BBAddrMapLabels.count(Target);
+                bool LabelAvailable = AllLabels.count(Target);
+
+                if (TargetSym != nullptr) {
+                  uint64_t TargetAddress = TargetSym->Addr;
+                  uint64_t Disp = Target - TargetAddress;
+                  std::string TargetName = Demangle ? demangle(TargetSym->Name)
+                                                    : TargetSym->Name.str();
+                  bool RelFixedUp = false;
+                  SmallString<32> Val;
+
+                  *TargetOS << " <";
+                  // On XCOFF, we use relocations, even without -r, so we
+                  // can print the correct name for an extern function call.
+                  if (Obj.isXCOFF() && findRel()) {
+                    // Check for possible branch relocations and
+                    // branches to fixup code.
+                    bool BranchRelocationType = true;
+                    XCOFF::RelocationType RelocType;
+                    if (Obj.is64Bit()) {
+                      const XCOFFRelocation64 *Reloc =
+                          reinterpret_cast<XCOFFRelocation64 *>(
+                              RelCur->getRawDataRefImpl().p);
+                      RelFixedUp = Reloc->isFixupIndicated();
+                      RelocType = Reloc->Type;
+                    } else {
+                      const XCOFFRelocation32 *Reloc =
+                          reinterpret_cast<XCOFFRelocation32 *>(
+                              RelCur->getRawDataRefImpl().p);
+                      RelFixedUp = Reloc->isFixupIndicated();
+                      RelocType = Reloc->Type;
+                    }
+                    BranchRelocationType =
+                        RelocType == XCOFF::R_BA || RelocType == XCOFF::R_BR ||
+                        RelocType == XCOFF::R_RBA || RelocType == XCOFF::R_RBR;
+
+                    // If we have a valid relocation, try to print its
+                    // corresponding symbol name. Multiple relocations on the
+                    // same instruction are not handled. Branches to fixup code
+                    // will have the RelFixedUp flag set in the RLD. For these
+                    // instructions, we print the correct branch target, but
+                    // print the referenced symbol as a comment.
+                    if (Error E =
+                            getRelocationValueString(*RelCur, false, Val)) {
+                      // If -r was used, this error will be printed later.
+                      // Otherwise, we ignore the error and print what
+                      // would have been printed without using relocations.
+                      consumeError(std::move(E));
+                      *TargetOS << TargetName;
+                      RelFixedUp = false; // Suppress comment for RLD sym name
+                    } else if (BranchRelocationType && !RelFixedUp)
+                      *TargetOS << Val;
+                    else
+                      *TargetOS << TargetName;
+                    if (Disp)
+                      *TargetOS << "+0x" << Twine::utohexstr(Disp);
+                  } else if (!Disp) {
+                    *TargetOS << TargetName;
+                  } else if (BBAddrMapLabelAvailable) {
+                    *TargetOS << BBAddrMapLabels[Target].front().BlockLabel;
+                  } else if (LabelAvailable) {
+                    *TargetOS << AllLabels[Target];
                   } else {
-                    const XCOFFRelocation32 *Reloc =
-                        reinterpret_cast<XCOFFRelocation32 *>(
-                            RelCur->getRawDataRefImpl().p);
-                    RelFixedUp = Reloc->isFixupIndicated();
-                    RelocType = Reloc->Type;
+                    // Always Print the binary symbol plus an offset if there's
+                    // no local label corresponding to the target address.
+                    *TargetOS << TargetName << "+0x" << Twine::utohexstr(Disp);
                   }
-                  BranchRelocationType =
-                      RelocType == XCOFF::R_BA || RelocType == XCOFF::R_BR ||
-                      RelocType == XCOFF::R_RBA || RelocType == XCOFF::R_RBR;
-
-                  // If we have a valid relocation, try to print its
-                  // corresponding symbol name. Multiple relocations on the
-                  // same instruction are not handled.
-                  // Branches to fixup code will have the RelFixedUp flag set in
-                  // the RLD. For these instructions, we print the correct
-                  // branch target, but print the referenced symbol as a
-                  // comment.
-                  if (Error E = getRelocationValueString(*RelCur, false, Val)) {
-                    // If -r was used, this error will be printed later.
-                    // Otherwise, we ignore the error and print what
-                    // would have been printed without using relocations.
-                    consumeError(std::move(E));
-                    *TargetOS << TargetName;
-                    RelFixedUp = false; // Suppress comment for RLD sym name
-                  } else if (BranchRelocationType && !RelFixedUp)
-                    *TargetOS << Val;
-                  else
-                    *TargetOS << TargetName;
-                  if (Disp)
-                    *TargetOS << "+0x" << Twine::utohexstr(Disp);
-                } else if (!Disp) {
-                  *TargetOS << TargetName;
+                  *TargetOS << ">";
+                  if (RelFixedUp && !InlineRelocs) {
+                    // We have fixup code for a relocation. We print the
+                    // referenced symbol as a comment.
+                    *TargetOS << "\t# " << Val;
+                  }
+
                 } else if (BBAddrMapLabelAvailable) {
-                  *TargetOS << BBAddrMapLabels[Target].front().BlockLabel;
+                  *TargetOS << " <"
+                            << BBAddrMapLabels[Target].front().BlockLabel
+                            << ">";
                 } else if (LabelAvailable) {
-                  *TargetOS << AllLabels[Target];
-                } else {
-                  // Always Print the binary symbol plus an offset if there's no
-                  // local label corresponding to the target address.
-                  *TargetOS << TargetName << "+0x" << Twine::utohexstr(Disp);
+                  *TargetOS << " <" << AllLabels[Target] << ">";
                 }
-                *TargetOS << ">";
-                if (RelFixedUp && !InlineRelocs) {
-                  // We have fixup code for a relocation. We print the
-                  // referenced symbol as a comment.
-                  *TargetOS << "\t# " << Val;
-                }
-
-              } else if (BBAddrMapLabelAvailable) {
-                *TargetOS << " <" << BBAddrMapLabels[Target].front().BlockLabel
-                          << ">";
-              } else if (LabelAvailable) {
-                *TargetOS << " <" << AllLabels[Target] << ">";
+                // By convention, each record in the comment stream should be
+                // terminated.
+                if (TargetOS == &CommentStream)
+                  *TargetOS << "\n";
               }
-              // By convention, each record in the comment stream should be
-              // terminated.
-              if (TargetOS == &CommentStream)
-                *TargetOS << "\n";
-            }
 
-            DT->InstrAnalysis->updateState(Inst, SectionAddr + Index);
-          } else if (!Disassembled && DT->InstrAnalysis) {
-            DT->InstrAnalysis->resetState();
+              DT->InstrAnalysis->updateState(Inst, SectionAddr + Index);
+            } else if (!Disassembled && DT->InstrAnalysis) {
+              DT->InstrAnalysis->resetState();
+            }
           }
-        }
 
-        assert(DT->Context->getAsmInfo());
-        DT->Printer->emitPostInstructionInfo(FOS, *DT->Context->getAsmInfo(),
-                                             *DT->SubtargetInfo,
-                                             CommentStream.str(), LEP);
-        Comments.clear();
-
-        if (BTF)
-          printBTFRelocation(FOS, *BTF, {Index, Section.getIndex()}, LEP);
-
-        if (InlineRelocs) {
-          while (findRel()) {
-            // When --adjust-vma is used, update the address printed.
-            printRelocation(FOS, Obj.getFileName(), *RelCur,
-                            SectionAddr + RelOffset + VMAAdjustment, Is64Bits);
-            LEP.printAfterOtherLine(FOS, true);
-            ++RelCur;
+          assert(DT->Context->getAsmInfo());
+          DT->Printer->emitPostInstructionInfo(FOS, *DT->Context->getAsmInfo(),
+                                               *DT->SubtargetInfo,
+                                               CommentStream.str(), LEP);
+          Comments.clear();
+
+          if (BTF)
+            printBTFRelocation(FOS, *BTF, {Index, Section.getIndex()}, LEP);
+
+          if (InlineRelocs) {
+            while (findRel()) {
+              // When --adjust-vma is used, update the address printed.
+              printRelocation(FOS, Obj.getFileName(), *RelCur,
+                              SectionAddr + RelOffset + VMAAdjustment,
+                              Is64Bits);
+              LEP.printAfterOtherLine(FOS, true);
+              ++RelCur;
+            }
           }
-        }
 
-        object::SectionedAddress NextAddr = {
-            SectionAddr + Index + VMAAdjustment + Size, Section.getIndex()};
-        LEP.printEndLine(FOS, NextAddr);
+          object::SectionedAddress NextAddr = {
+              SectionAddr + Index + VMAAdjustment + Size, Section.getIndex()};
+          LEP.printEndLine(FOS, NextAddr);
 
-        Index += Size;
+          Index += Size;
+        }
       }
+    };
+
+    SmallVector<size_t, 0> Bounds;
+    if (Pool) {
+      // Don't bother with sections that are too small to be worth splitting.
+      uint64_t NumShards = std::min<uint64_t>(4 * Pool->getMaxConcurrency(),
+                                              SectSize / (64 * 1024));
+      Bounds = partitionSymbols(Symbols, SectionAddr, SectSize, NumShards);
+    }
+    if (Bounds.size() <= 2) {
+      DisassembleSymbols(0, Symbols.size(), DT, LEP, PrintedSection,
+                         FoundDisasmSymbolSet, OS);
+      continue;
+    }
+
+    // Disassemble every range of symbols into a buffer of its own, with a
+    // disassembler that no other thread uses at the same time, and print the
+    // buffers in order so that the output matches the serial one.
+    struct ShardResult {
+      std::string Output;
+      StringSet<> FoundSymbols;
+      bool PrintedSection = false;
+    };
+    std::vector<ShardResult> Results(Bounds.size() - 1);
+    for (size_t I = 0, E = Results.size(); I != E; ++I) {
+      Pool->async([&, I] {
+        std::unique_ptr<DisassemblerTarget> ShardTarget;
+        {
+          std::lock_guard<std::mutex> Lock(ShardTargetsMutex);
+          if (!ShardTargets.empty()) {
+            ShardTarget = std::move(ShardTargets.back());
+            ShardTargets.pop_back();
+          }
+        }
+        if (!ShardTarget)
+          ShardTarget = cloneDisassemblerTarget(PrimaryTarget, Obj);
+
+        DisassemblerTarget *ShardDT = ShardTarget.get();
+        LiveElementPrinter ShardLEP(*ShardDT->Context->getRegisterInfo(),
+                                    *ShardDT->SubtargetInfo);
+        raw_string_ostream ShardOS(Results[I].Output);
+        DisassembleSymbols(Bounds[I], Bounds[I + 1], ShardDT, ShardLEP,
+                           Results[I].PrintedSection, Results[I].FoundSymbols,
+                           ShardOS);
+
+        std::lock_guard<std::mutex> Lock(ShardTargetsMutex);
+        ShardTargets.push_back(std::move(ShardTarget));
+      });
+    }
+    Pool->wait();
+
+    for (ShardResult &Result : Results) {
+      StringRef Output = Result.Output;
+      // Every range that found something to disassemble starts with the
+      // section header, but only the first one prints it.
+      if (Result.PrintedSection && PrintedSection)
+        Output = Output.drop_front(SectionHeader.size());
+      PrintedSection |= Result.PrintedSection;
+      OS << Output;
+      FoundDisasmSymbolSet.insert_range(Result.FoundSymbols.keys());
     }
   }
   StringSet<> MissingDisasmSymbolSet =
@@ -3631,6 +3770,8 @@ static void parseObjdumpOptions(const llvm::opt::InputArgList &InputArgs) {
   parseIntArg(InputArgs, OBJDUMP_stop_address_EQ, StopAddress);
   HasStopAddressFlag = InputArgs.hasArg(OBJDUMP_stop_address_EQ);
   SymbolTable = InputArgs.hasArg(OBJDUMP_syms);
+  NumThreads = 1;
+  parseIntArg(InputArgs, OBJDUMP_threads_EQ, NumThreads);
   SymbolizeOperands = InputArgs.hasArg(OBJDUMP_symbolize_operands);
   PrettyPGOAnalysisMap = InputArgs.hasArg(OBJDUMP_pretty_pgo_analysis_map);
   if (PrettyPGOAnalysisMap && !SymbolizeOperands)
@@ -297,6 +297,22 @@ static cl::opt<unsigned> NumThreads(
     cl::desc("Number of merge threads to use (default: autodetect)"));
 static cl::alias NumThreadsA("j", cl::desc("Alias for --num-threads"),
                              cl::aliasopt(NumThreads));
+static cl::opt<unsigned> NumPartitions(
+    "partitions", cl::init(0), cl::sub(MergeSubcommand),
+    cl::desc("Split function records into this many partitions by name hash "
+             "and merge each partition independently. Every input is read "
+             "once per partition, but each merged record is held in memory "
+             "only once instead of once per thread (default: 0, disabled)"));
+static cl::opt<unsigned> SampledInstrPeriod(
+    "sampled-instr-period", cl::init(0), cl::sub(MergeSubcommand),
+    cl::desc("Scale the counters of profiles collected with "
+             "-sampled-instrumentation back up to estimated full counts. Set "
+             "to the sampling period the program was built with "
+             "(default: 0, no scaling)"));
+static cl::opt<unsigned> SampledInstrBurstDuration(
+    "sampled-instr-burst-duration", cl::init(200), cl::sub(MergeSubcommand),
+    cl::desc("The burst duration the sampled profiles were built with; only "
+             "used with --sampled-instr-period (default: 200)"));
 
 static cl::opt<std::string> ProfileSymbolListFile(
     "prof-sym-list", cl::init(""), cl::sub(MergeSubcommand),
@@ -695,15 +711,26 @@ static void
 loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
           const InstrProfCorrelator *Correlator, const StringRef ProfiledBinary,
           WriterContext *WC, const object::BuildIDFetcher *BIDFetcher = nullptr,
-          const ProfCorrelatorKind *BIDFetcherCorrelatorKind = nullptr) {
+          const ProfCorrelatorKind *BIDFetcherCorrelatorKind = nullptr,
+          unsigned Partition = 0, unsigned NumPartitions = 1) {
   std::unique_lock<std::mutex> CtxGuard{WC->Lock};
 
+  // When merging in partitions, only the first partition records
+  // everything besides function records, so that data and errors are not
+  // duplicated.
+  bool IsPrimaryPartition = Partition == 0;
+
   // Copy the filename, because llvm::ThreadPool copied the input "const
   // WeightedFile &" by value, making a reference to the filename within it
   // invalid outside of this packaged task.
   std::string Filename = Input.Filename;
 
   using ::llvm::memprof::RawMemProfReader;
+  using ::llvm::memprof::YAMLMemProfReader;
+  if (!IsPrimaryPartition && (RawMemProfReader::hasFormat(Input.Filename) ||
+                              YAMLMemProfReader::hasFormat(Input.Filename)))
+    return;
+
   if (RawMemProfReader::hasFormat(Input.Filename)) {
     auto ReaderOrErr = RawMemProfReader::create(Input.Filename, ProfiledBinary);
     if (!ReaderOrErr) {
@@ -732,7 +759,6 @@ loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
     return;
   }
 
-  using ::llvm::memprof::YAMLMemProfReader;
   if (YAMLMemProfReader::hasFormat(Input.Filename)) {
     auto ReaderOrErr = YAMLMemProfReader::create(Input.Filename);
     if (!ReaderOrErr)
@@ -803,7 +829,7 @@ loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
   if (Error E = ReaderOrErr.takeError()) {
     // Skip the empty profiles by returning silently.
     auto [ErrCode, Msg] = InstrProfError::take(std::move(E));
-    if (ErrCode != instrprof_error::empty_raw_profile)
+    if (ErrCode != instrprof_error::empty_raw_profile && IsPrimaryPartition)
       WC->Errors.emplace_back(make_error<InstrProfError>(ErrCode, Msg),
                               Filename);
     return;
@@ -812,11 +838,12 @@ loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
   auto Reader = std::move(ReaderOrErr.get());
   if (Error E = WC->Writer.mergeProfileKind(Reader->getProfileKind())) {
     consumeError(std::move(E));
-    WC->Errors.emplace_back(
-        make_error<StringError>(
-            "Merge IR generated profile with Clang generated profile.",
-            std::error_code()),
-        Filename);
+    if (IsPrimaryPartition)
+      WC->Errors.emplace_back(
+          make_error<StringError>(
+              "Merge IR generated profile with Clang generated profile.",
+              std::error_code()),
+          Filename);
     return;
   }
 
@@ -824,8 +851,10 @@ loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
     if (Remapper)
       I.Name = (*Remapper)(I.Name);
     const StringRef FuncName = I.Name;
+    if (NumPartitions > 1 && MD5Hash(FuncName) % NumPartitions != Partition)
+      continue;
     bool Reported = false;
-    WC->Writer.addRecord(std::move(I), Input.Weight, [&](Error E) {
+    auto Warn = [&](Error E) {
       if (Reported) {
         consumeError(std::move(E));
         return;
@@ -837,9 +866,19 @@ loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
       bool firstTime = WC->WriterErrorCodes.insert(ErrCode).second;
       handleMergeWriterError(make_error<InstrProfError>(ErrCode, Msg),
                              Input.Filename, FuncName, firstTime);
-    });
+    };
+    // Sampled instrumentation only counts SampledInstrBurstDuration out of
+    // every SampledInstrPeriod executions, so scale the counters back up to
+    // make them comparable with those of fully instrumented runs.
+    if (SampledInstrPeriod && !Reader->hasSingleByteCoverage())
+      I.scale(SampledInstrPeriod, SampledInstrBurstDuration,
+              [&](instrprof_error E) { Warn(make_error<InstrProfError>(E)); });
+    WC->Writer.addRecord(std::move(I), Input.Weight, Warn);
   }
 
+  if (!IsPrimaryPartition)
+    return;
+
   if (KeepVTableSymbols) {
     const InstrProfSymtab &symtab = Reader->getSymtab();
     const auto &VTableNames = symtab.getVTableNames();
@@ -980,6 +1019,10 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
   if (OutputFormat != PF_Binary && OutputFormat != PF_Ext_Binary &&
       OutputFormat != PF_Text)
     exitWithError("unknown format is specified");
+  if (SampledInstrPeriod && (SampledInstrBurstDuration == 0 ||
+                             SampledInstrBurstDuration > SampledInstrPeriod))
+    exitWithError("--sampled-instr-burst-duration must be between 1 and "
+                  "--sampled-instr-period");
 
   // TODO: Maybe we should support correlation with mixture of different
   // correlation modes(w/wo debug-info/object correlation).
@@ -1033,32 +1076,50 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
   std::mutex ErrorLock;
   SmallSet<instrprof_error, 4> WriterErrorCodes;
 
-  // If NumThreads is not specified, auto-detect a good default.
+  // If NumThreads is not specified, auto-detect a good default. Every
+  // partition reads all inputs, so partitions need a thread each to run
+  // side by side rather than one after another.
   if (NumThreads == 0)
     NumThreads = std::min(hardware_concurrency().compute_thread_count(),
-                          unsigned((Inputs.size() + 1) / 2));
+                          NumPartitions > 1
+                              ? unsigned(NumPartitions)
+                              : unsigned((Inputs.size() + 1) / 2));
 
-  // Initialize the writer contexts.
+  // Initialize the writer contexts, one per thread or one per partition.
+  unsigned NumContexts = NumPartitions > 1 ? NumPartitions : NumThreads;
   SmallVector<std::unique_ptr<WriterContext>, 4> Contexts;
-  for (unsigned I = 0; I < NumThreads; ++I)
+  for (unsigned I = 0; I < NumContexts; ++I)
     Contexts.emplace_back(std::make_unique<WriterContext>(
         OutputSparse, ErrorLock, WriterErrorCodes, TraceReservoirSize,
         MaxTraceLength));
 
-  if (NumThreads == 1) {
+  if (NumContexts == 1) {
     for (const auto &Input : Inputs)
       loadInput(Input, Remapper, Correlator.get(), ProfiledBinary,
                 Contexts[0].get(), BIDFetcher.get(), &BIDFetcherCorrelateKind);
   } else {
     DefaultThreadPool Pool(hardware_concurrency(NumThreads));
 
-    // Load the inputs in parallel (N/NumThreads serial steps).
-    unsigned Ctx = 0;
-    for (const auto &Input : Inputs) {
-      Pool.async(loadInput, Input, Remapper, Correlator.get(), ProfiledBinary,
-                 Contexts[Ctx].get(), BIDFetcher.get(),
-                 &BIDFetcherCorrelateKind);
-      Ctx = (Ctx + 1) % NumThreads;
+    if (NumPartitions > 1) {
+      // Each partition walks all inputs and keeps only its own share of the
+      // function records, so the partitions are disjoint and the final merge
+      // only moves records.
+      for (unsigned P = 0; P < NumPartitions; ++P)
+        Pool.async([&, P] {
+          for (const auto &Input : Inputs)
+            loadInput(Input, Remapper, Correlator.get(), ProfiledBinary,
+                      Contexts[P].get(), BIDFetcher.get(),
+                      &BIDFetcherCorrelateKind, P, NumPartitions);
+        });
+    } else {
+      // Load the inputs in parallel (N/NumThreads serial steps).
+      unsigned Ctx = 0;
+      for (const auto &Input : Inputs) {
+        Pool.async(loadInput, Input, Remapper, Correlator.get(),
+                   ProfiledBinary, Contexts[Ctx].get(), BIDFetcher.get(),
+                   &BIDFetcherCorrelateKind, 0, 1);
+        Ctx = (Ctx + 1) % NumThreads;
+      }
     }
     Pool.wait();
 
@@ -1643,8 +1704,13 @@ static void mergeSampleProfile(const WeightedFileVector &Inputs,
                    : FunctionSamples();
       FunctionSamples &Samples = Remapper ? Remapped : I->second;
       SampleContext FContext = Samples.getContext();
-      mergeSampleProfErrors(Result,
-                            ProfileMap[FContext].merge(Samples, Input.Weight));
+      // The reader's copy is not needed after merging, so a function seen for
+      // the first time with unit weight is moved instead of being merged into
+      // an empty profile, which would deep copy all of its nested samples.
+      if (Input.Weight != 1 ||
+          !ProfileMap.try_emplace(FContext, std::move(Samples)).second)
+        mergeSampleProfErrors(
+            Result, ProfileMap[FContext].merge(Samples, Input.Weight));
       if (Result != sampleprof_error::success) {
         std::error_code EC = make_error_code(Result);
         handleMergeWriterError(errorCodeToError(EC), Input.Filename,
@@ -3421,6 +3487,8 @@ static int order_main() {
     // Read all entries
     (void)I;
   }
+  if (Reader->hasError())
+    exitWithError(Reader->getError(), Filename);
   ArrayRef Traces = Reader->getTemporalProfTraces();
   if (NumTestTraces && NumTestTraces >= Traces.size())
     exitWithError(
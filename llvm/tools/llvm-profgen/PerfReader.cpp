@@ -688,14 +688,16 @@ bool PerfScriptReader::extractLBRStack(TraceStream &TraceIt,
     if (Token.size() == 0)
       continue;
 
-    SmallVector<StringRef, 8> Addresses;
-    Token.split(Addresses, "/");
+    // Only the source and target fields are used, so don't split off the
+    // prediction, transaction and cycle fields of the record.
+    auto [SrcStr, Rest] = Token.split('/');
+    StringRef DstStr = Rest.split('/').first;
     uint64_t Src;
     uint64_t Dst;
 
-    // Stop at broken LBR records.
-    if (Addresses.size() < 2 || Addresses[0].substr(2).getAsInteger(16, Src) ||
-        Addresses[1].substr(2).getAsInteger(16, Dst)) {
+    // Stop at broken LBR records. A record without a '/' has an empty target.
+    if (SrcStr.substr(2).getAsInteger(16, Src) ||
+        DstStr.substr(2).getAsInteger(16, Dst)) {
       WarnInvalidLBR(TraceIt);
       break;
     }
@@ -36,6 +36,7 @@
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/WithColor.h"
+#include "llvm/Support/xxhash.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/TargetParser/Host.h"
 #include "llvm/Transforms/IPO/ThinLTOBitcodeWriter.h"
@@ -62,6 +63,12 @@ static cl::opt<bool> TmpFilesAsBitcode(
     cl::desc("Always write temporary files as bitcode instead of textual IR"),
     cl::init(false), cl::cat(LLVMReduceOptions));
 
+static cl::opt<bool> CacheInterestingness(
+    "cache-interestingness",
+    cl::desc("Reuse the interestingness result of a previously tested "
+             "identical test case instead of running the test again"),
+    cl::init(true), cl::cat(LLVMReduceOptions));
+
 static SaveRestorePoints constructSaveRestorePoints(
     const SaveRestorePoints &SRPoints,
     const DenseMap<MachineBasicBlock *, MachineBasicBlock *> &BBMap) {
@@ -491,6 +498,20 @@ bool ReducerWorkItem::verify(raw_fd_ostream *OS) const {
 bool ReducerWorkItem::isReduced(const TestRunner &Test) const {
   const bool UseBitcode = Test.inputIsBitcode() || TmpFilesAsBitcode;
 
+  // Different chunks and delta passes frequently produce the same test case,
+  // e.g. when a chunk only covers already-trivial entities. Serialize it first
+  // so that a previous result for identical content can be reused.
+  SmallString<0> Contents;
+  raw_svector_ostream ContentsOS(Contents);
+  writeOutput(ContentsOS, UseBitcode);
+
+  XXH128_hash_t Hash{};
+  if (CacheInterestingness) {
+    Hash = xxh3_128bits(arrayRefFromStringRef(Contents.str()));
+    if (std::optional<bool> Cached = Test.lookupCachedResult(Hash))
+      return *Cached;
+  }
+
   SmallString<128> CurrentFilepath;
 
   // Write ReducerWorkItem to tmp file
@@ -507,7 +528,7 @@ bool ReducerWorkItem::isReduced(const TestRunner &Test) const {
 
   ToolOutputFile Out(CurrentFilepath, FD);
 
-  writeOutput(Out.os(), UseBitcode);
+  Out.os() << Contents;
 
   Out.os().close();
   if (Out.os().has_error()) {
@@ -518,7 +539,10 @@ bool ReducerWorkItem::isReduced(const TestRunner &Test) const {
   }
 
   // Current Chunks aren't interesting
-  return Test.run(CurrentFilepath);
+  bool Interesting = Test.run(CurrentFilepath);
+  if (CacheInterestingness)
+    Test.cacheResult(Hash, Interesting);
+  return Interesting;
 }
 
 std::unique_ptr<ReducerWorkItem>
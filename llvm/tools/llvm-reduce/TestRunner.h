@@ -10,12 +10,16 @@
 #define LLVM_TOOLS_LLVM_REDUCE_TESTRUNNER_H
 
 #include "ReducerWorkItem.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Program.h"
+#include "llvm/Support/xxhash.h"
 #include "llvm/Target/TargetMachine.h"
+#include <mutex>
+#include <optional>
 
 namespace llvm {
 
@@ -51,6 +55,14 @@ public:
     return InputIsBitcode;
   }
 
+  /// Returns the result of a previous interesting-ness test run on a test
+  /// case whose serialized contents hash to \p Hash, if there was one.
+  std::optional<bool> lookupCachedResult(XXH128_hash_t Hash) const;
+
+  /// Records the interesting-ness test result for the test case whose
+  /// serialized contents hash to \p Hash.
+  void cacheResult(XXH128_hash_t Hash, bool Interesting) const;
+
 private:
   StringRef TestName;
   StringRef ToolName;
@@ -60,6 +72,10 @@ private:
   StringRef OutputFilename;
   const bool InputIsBitcode;
   bool EmitBitcode;
+
+  // Test cases may be checked from several threads with -j.
+  mutable std::mutex ResultCacheMutex;
+  mutable DenseMap<std::pair<uint64_t, uint64_t>, bool> ResultCache;
 };
 
 } // namespace llvm
@@ -335,8 +335,9 @@ static void printUnknownLineInfo(std::string ModuleName, DIPrinter &Printer) {
 static void symbolizeInput(const opt::InputArgList &Args,
                            object::BuildIDRef IncomingBuildID,
                            uint64_t AdjustVMA, bool IsAddr2Line,
-                           OutputStyle Style, StringRef InputString,
-                           LLVMSymbolizer &Symbolizer, DIPrinter &Printer) {
+                           bool ShouldInline, OutputStyle Style,
+                           StringRef InputString, LLVMSymbolizer &Symbolizer,
+                           DIPrinter &Printer) {
   Command Cmd;
   std::string ModuleName;
   object::BuildID BuildID(IncomingBuildID.begin(), IncomingBuildID.end());
@@ -359,7 +360,6 @@ static void symbolizeInput(const opt::InputArgList &Args,
     });
     return;
   }
-  bool ShouldInline = Args.hasFlag(OPT_inlines, OPT_no_inlines, !IsAddr2Line);
   if (!BuildID.empty()) {
     assert(ModuleName.empty());
     if (!Args.hasArg(OPT_no_debuginfod))
@@ -583,6 +583,9 @@ int llvm_symbolizer_main(int argc, char **argv, const llvm::ToolContext &) {
     }
   }
 
+  // Evaluated once rather than for every address read from stdin.
+  bool ShouldInline = Args.hasFlag(OPT_inlines, OPT_no_inlines, !IsAddr2Line);
+
   std::vector<std::string> InputAddresses = Args.getAllArgValues(OPT_INPUT);
   if (InputAddresses.empty()) {
     const int kMaxInputStringLength = 1024;
@@ -593,15 +596,15 @@ int llvm_symbolizer_main(int argc, char **argv, const llvm::ToolContext &) {
       std::string StrippedInputString(InputString);
       llvm::erase_if(StrippedInputString,
                      [](char c) { return c == '\r' || c == '\n'; });
-      symbolizeInput(Args, BuildID, AdjustVMA, IsAddr2Line, Style,
-                     StrippedInputString, Symbolizer, *Printer);
+      symbolizeInput(Args, BuildID, AdjustVMA, IsAddr2Line, ShouldInline,
+                     Style, StrippedInputString, Symbolizer, *Printer);
       outs().flush();
     }
   } else {
     Printer->listBegin();
     for (StringRef Address : InputAddresses)
-      symbolizeInput(Args, BuildID, AdjustVMA, IsAddr2Line, Style, Address,
-                     Symbolizer, *Printer);
+      symbolizeInput(Args, BuildID, AdjustVMA, IsAddr2Line, ShouldInline,
+                     Style, Address, Symbolizer, *Printer);
     Printer->listEnd();
   }
 
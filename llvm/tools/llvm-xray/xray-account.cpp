@@ -11,7 +11,9 @@
 //===----------------------------------------------------------------------===//
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <memory>
 #include <numeric>
 #include <system_error>
 #include <utility>
@@ -20,6 +22,7 @@
 #include "xray-registry.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/XRay/InstrumentationMap.h"
 #include "llvm/XRay/Trace.h"
 
@@ -37,6 +40,11 @@ static cl::opt<bool>
                      cl::sub(Account), cl::init(false));
 static cl::alias AccountKeepGoing2("k", cl::aliasopt(AccountKeepGoing),
                                    cl::desc("Alias for -keep_going"));
+static cl::opt<unsigned> AccountThreads(
+    "threads",
+    cl::desc("number of threads used to account the records of different "
+             "threads in parallel; 0 uses all available hardware threads"),
+    cl::value_desc("N"), cl::sub(Account), cl::init(0));
 static cl::opt<bool> AccountRecursiveCallsOnly(
     "recursive-calls-only", cl::desc("Only count the calls that are recursive"),
     cl::sub(Account), cl::init(false));
@@ -256,6 +264,24 @@ bool LatencyAccountant::accountRecord(const XRayRecord &Record) {
   return true;
 }
 
+void LatencyAccountant::mergeFrom(LatencyAccountant &&Other) {
+  for (auto &[FuncId, Latencies] : Other.FunctionLatencies) {
+    auto &Dest = FunctionLatencies[FuncId];
+    if (Dest.empty())
+      Dest = std::move(Latencies);
+    else
+      Dest.append(Latencies.begin(), Latencies.end());
+  }
+  for (const auto &[CPU, MinMax] : Other.PerCPUMinMaxTSC) {
+    setMinMax(PerCPUMinMaxTSC[CPU], MinMax.first);
+    setMinMax(PerCPUMinMaxTSC[CPU], MinMax.second);
+  }
+  for (auto &[TId, MinMax] : Other.PerThreadMinMaxTSC)
+    PerThreadMinMaxTSC[TId] = MinMax;
+  for (auto &[TId, Stack] : Other.PerThreadFunctionStack)
+    PerThreadFunctionStack[TId] = std::move(Stack);
+}
+
 namespace {
 
 // We consolidate the data into a struct which we can output in various forms.
@@ -476,7 +502,55 @@ static CommandRegistration Unused(&Account, []() -> Error {
         TraceOrErr.takeError());
 
   auto &T = *TraceOrErr;
-  for (const auto &Record : T) {
+
+  // Threads have independent call stacks, so split the records by thread and
+  // account each thread separately in parallel. If any record cannot be
+  // accounted, redo the whole trace sequentially below so that diagnostics
+  // (and -keep-going) behave exactly as for a single accountant.
+  bool Accounted = false;
+  if (AccountThreads != 1 && T.size() != 0) {
+    parallel::strategy = AccountThreads == 0
+                             ? hardware_concurrency(hardware_concurrency()
+                                                        .compute_thread_count())
+                             : hardware_concurrency(AccountThreads);
+    DenseMap<uint32_t, unsigned> ThreadIndex;
+    std::vector<std::vector<const XRayRecord *>> ThreadRecords;
+    for (const auto &Record : T) {
+      auto [It, Inserted] =
+          ThreadIndex.try_emplace(Record.TId, ThreadRecords.size());
+      if (Inserted)
+        ThreadRecords.emplace_back();
+      ThreadRecords[It->second].push_back(&Record);
+    }
+
+    std::vector<std::unique_ptr<LatencyAccountant>> Accountants(
+        ThreadRecords.size());
+    std::atomic<bool> Failed{false};
+    uint64_t StartTSC = T.begin()->TSC;
+    parallelFor(0, ThreadRecords.size(), [&](size_t I) {
+      auto A = std::make_unique<LatencyAccountant>(
+          FuncIdHelper, AccountRecursiveCallsOnly, AccountDeduceSiblingCalls);
+      A->setStartTSC(StartTSC);
+      for (const XRayRecord *Record : ThreadRecords[I]) {
+        if (Failed.load(std::memory_order_relaxed))
+          return;
+        if (!A->accountRecord(*Record)) {
+          Failed.store(true, std::memory_order_relaxed);
+          return;
+        }
+      }
+      Accountants[I] = std::move(A);
+    });
+
+    if (!Failed) {
+      for (auto &A : Accountants)
+        FCA.mergeFrom(std::move(*A));
+      Accounted = true;
+    }
+  }
+
+  for (const auto &Record :
+       make_range(Accounted ? T.end() : T.begin(), T.end())) {
     if (FCA.accountRecord(Record))
       continue;
     errs()
@@ -90,6 +90,15 @@ public:
   ///
   bool accountRecord(const XRayRecord &Record);
 
+  /// Sets the TSC before which records are rejected, as if a record with this
+  /// TSC had been accounted first. Used when the records are split by thread
+  /// and accounted by several accountants.
+  void setStartTSC(uint64_t TSC) { CurrentMaxTSC = TSC; }
+
+  /// Moves the results of \p Other, which accounted the records of a disjoint
+  /// set of threads, into this accountant.
+  void mergeFrom(LatencyAccountant &&Other);
+
   const PerThreadFunctionStackMap &getPerThreadFunctionStack() const {
     return PerThreadFunctionStack;
   }
@@ -195,4 +195,21 @@ TEST_F(ImmutableSetTest, RemoveIfNotFoundTest) {
   ImmutableSet<long> U = f.remove(S, 3);
   EXPECT_NE(S.getRoot(), U.getRoot());
 }
+
+TEST_F(ImmutableSetTest, CanonicalTreeReleaseTest) {
+  ImmutableSet<long>::Factory f;
+  ImmutableSet<long> S = f.getEmptySet();
+  {
+    ImmutableSet<long> A = f.add(f.add(S, 1), 2);
+    ImmutableSet<long> B = f.add(A, 3);
+    ImmutableSet<long> C = f.add(f.add(f.add(S, 3), 2), 1);
+    EXPECT_EQ(B.getRoot(), C.getRoot());
+  }
+
+  // The trees above have been released and dropped from the cache; building
+  // them again must still result in a single canonical tree.
+  ImmutableSet<long> D = f.add(f.add(f.add(S, 1), 2), 3);
+  ImmutableSet<long> E = f.add(f.add(f.add(S, 2), 3), 1);
+  EXPECT_EQ(D.getRoot(), E.getRoot());
+}
 } // namespace
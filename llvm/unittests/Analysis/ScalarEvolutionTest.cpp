@@ -22,6 +22,7 @@
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Verifier.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/SourceMgr.h"
 #include "gtest/gtest.h"
 
@@ -1903,4 +1904,46 @@ TEST_F(ScalarEvolutionsTest, SimplifyICmpOperands) {
   });
 }
 
+TEST_F(ScalarEvolutionsTest, MaxAnalyzedValues) {
+  LLVMContext C;
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M = parseAssemblyString(
+      "define i32 @foo(i32 %a) { "
+      "entry: "
+      "  br label %body "
+      "dead: "
+      "  %d0 = add i32 %a, 1 "
+      "  %d1 = add i32 %d0, 1 "
+      "  br label %body "
+      "body: "
+      "  %x0 = add i32 %a, 1 "
+      "  %x1 = add i32 %x0, 1 "
+      "  %x2 = add i32 %x1, 1 "
+      "  ret i32 %x2 "
+      "} ",
+      Err, C);
+  ASSERT_TRUE(M && "Could not parse module?");
+
+  auto *Opt =
+      cl::getRegisteredOptions().lookup("scalar-evolution-max-analyzed-values");
+  ASSERT_NE(Opt, nullptr);
+  Opt->addOccurrence(0, "scalar-evolution-max-analyzed-values", "2");
+
+  runWithSE(*M, "foo", [](Function &F, LoopInfo &LI, ScalarEvolution &SE) {
+    // Instructions in unreachable blocks are not analyzed, so they don't use
+    // up the budget.
+    SE.getSCEV(getInstructionByName(F, "d1"));
+    SE.getSCEV(getInstructionByName(F, "d0"));
+
+    // %x0 and %x1 use up the budget, after which %x2 is left unanalyzed.
+    EXPECT_TRUE(isa<SCEVAddExpr>(SE.getSCEV(getInstructionByName(F, "x1"))));
+    Instruction *X2 = getInstructionByName(F, "x2");
+    const auto *U = dyn_cast<SCEVUnknown>(SE.getSCEV(X2));
+    ASSERT_NE(U, nullptr);
+    EXPECT_EQ(U->getValue(), X2);
+  });
+
+  Opt->addOccurrence(0, "scalar-evolution-max-analyzed-values", "0");
+}
+
 }  // end namespace llvm
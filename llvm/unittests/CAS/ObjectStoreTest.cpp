@@ -270,6 +270,40 @@ TEST_P(CASTest, NodesBig) {
     ASSERT_THAT_ERROR(CAS->validateObject(CAS->getID(ID)), Succeeded());
 }
 
+TEST_P(CASTest, ImportObject) {
+  std::unique_ptr<ObjectStore> Upstream = createObjectStore();
+  std::unique_ptr<ObjectStore> CAS = createObjectStore();
+
+  std::optional<ObjectRef> Shared, Leaf, Inner, Root;
+  ASSERT_THAT_ERROR(Upstream->storeFromString({}, "shared").moveInto(Shared),
+                    Succeeded());
+  ASSERT_THAT_ERROR(Upstream->storeFromString({}, "leaf").moveInto(Leaf),
+                    Succeeded());
+  ASSERT_THAT_ERROR(
+      Upstream->storeFromString({*Shared, *Leaf}, "inner").moveInto(Inner),
+      Succeeded());
+  ASSERT_THAT_ERROR(
+      Upstream->storeFromString({*Inner, *Shared}, "root").moveInto(Root),
+      Succeeded());
+
+  // Part of the graph is already present downstream.
+  std::optional<ObjectRef> LocalShared;
+  ASSERT_THAT_ERROR(CAS->storeFromString({}, "shared").moveInto(LocalShared),
+                    Succeeded());
+
+  std::optional<ObjectRef> Imported;
+  ASSERT_THAT_ERROR(CAS->importObject(*Upstream, *Root).moveInto(Imported),
+                    Succeeded());
+  EXPECT_EQ(CAS->getID(*Imported), Upstream->getID(*Root));
+  ASSERT_THAT_ERROR(CAS->validateTree(*Imported), Succeeded());
+
+  // Importing again finds the whole tree locally.
+  std::optional<ObjectRef> Reimported;
+  ASSERT_THAT_ERROR(CAS->importObject(*Upstream, *Root).moveInto(Reimported),
+                    Succeeded());
+  EXPECT_EQ(*Reimported, *Imported);
+}
+
 #if LLVM_ENABLE_THREADS
 /// Common test functionality for creating blobs in parallel. You can vary which
 /// cas instances are the same or different, and the size of the created blobs.
@@ -168,13 +168,16 @@ TEST_F(OnDiskCASTest, UnifiedOnDiskCacheTest) {
   ASSERT_THAT_ERROR(countFileSizes(Temp.path()).moveInto(DirSizeBefore),
                     Succeeded());
 
-  ASSERT_THAT_ERROR(UnifiedOnDiskCache::collectGarbage(Temp.path()),
-                    Succeeded());
+  uint64_t ReclaimedBytes = 0;
+  ASSERT_THAT_ERROR(
+      UnifiedOnDiskCache::collectGarbage(Temp.path(), &ReclaimedBytes),
+      Succeeded());
 
   std::optional<size_t> DirSizeAfter;
   ASSERT_THAT_ERROR(countFileSizes(Temp.path()).moveInto(DirSizeAfter),
                     Succeeded());
   EXPECT_LT(*DirSizeAfter, *DirSizeBefore);
+  EXPECT_EQ(ReclaimedBytes, *DirSizeBefore - *DirSizeAfter);
 
   reopenDB();
   EXPECT_FALSE(UniDB->needsGarbageCollection());
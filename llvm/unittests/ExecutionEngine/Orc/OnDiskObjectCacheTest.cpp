@@ -0,0 +1,110 @@
+//===-- OnDiskObjectCacheTest.cpp - Unit tests for the on-disk cache ------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/OnDiskObjectCache.h"
+#include "OrcTestCommon.h"
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+std::unique_ptr<Module> parseModule(StringRef Source, LLVMContext &Ctx) {
+  SMDiagnostic Err;
+  auto M = parseIR(MemoryBufferRef(Source, "test"), Err, Ctx);
+  EXPECT_TRUE(M) << "Testcase source failed to parse";
+  return M;
+}
+
+TEST(OnDiskObjectCacheTest, HitsOnlyForIdenticalModuleAndTarget) {
+  unittest::TempDir Dir("orc-object-cache", /*Unique=*/true);
+  LLVMContext Ctx;
+  auto Foo = parseModule("define i32 @foo() { ret i32 1 }", Ctx);
+  auto Bar = parseModule("define i32 @foo() { ret i32 2 }", Ctx);
+  ASSERT_TRUE(Foo && Bar);
+
+  StringRef Obj = "not really an object file";
+  {
+    OnDiskObjectCache Cache(Dir.path().str(), "target-a");
+    EXPECT_EQ(Cache.getObject(Foo.get()), nullptr);
+    Cache.notifyObjectCompiled(Foo.get(), MemoryBufferRef(Obj, "foo.o"));
+  }
+
+  // A fresh cache over the same directory, as after a process restart.
+  OnDiskObjectCache Cache(Dir.path().str(), "target-a");
+  auto Hit = Cache.getObject(Foo.get());
+  ASSERT_NE(Hit, nullptr);
+  EXPECT_EQ(Hit->getBuffer(), Obj);
+  EXPECT_EQ(Cache.getObject(Bar.get()), nullptr);
+
+  OnDiskObjectCache OtherTarget(Dir.path().str(), "target-b");
+  EXPECT_EQ(OtherTarget.getObject(Foo.get()), nullptr);
+}
+
+TEST(OnDiskObjectCacheTest, HitsThroughSimpleCompiler) {
+  OrcNativeTarget::initialize();
+  auto JTMB = JITTargetMachineBuilder::detectHost();
+  if (!JTMB) {
+    consumeError(JTMB.takeError());
+    GTEST_SKIP();
+  }
+  auto TM = JTMB->createTargetMachine();
+  if (!TM) {
+    consumeError(TM.takeError());
+    GTEST_SKIP();
+  }
+
+  class CountingCache : public OnDiskObjectCache {
+  public:
+    using OnDiskObjectCache::OnDiskObjectCache;
+    void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override {
+      ++NumCompiled;
+      OnDiskObjectCache::notifyObjectCompiled(M, Obj);
+    }
+    unsigned NumCompiled = 0;
+  };
+
+  // Codegen lowers llvm.is.constant, so the module that is passed to
+  // notifyObjectCompiled differs from the one that was looked up.
+  StringRef Source = R"(
+    declare i1 @llvm.is.constant.i32(i32)
+    define i1 @foo(i32 %x) {
+      %c = call i1 @llvm.is.constant.i32(i32 %x)
+      ret i1 %c
+    }
+  )";
+  unittest::TempDir Dir("orc-object-cache", /*Unique=*/true);
+  CountingCache Cache(Dir.path().str(), OnDiskObjectCache::getTargetKey(**TM));
+  SimpleCompiler Compile(**TM, &Cache);
+
+  LLVMContext Ctx;
+  auto First = parseModule(Source, Ctx);
+  ASSERT_TRUE(First);
+  First->setDataLayout((*TM)->createDataLayout());
+  auto FirstObj = cantFail(Compile(*First));
+  EXPECT_EQ(Cache.NumCompiled, 1U);
+
+  auto Second = parseModule(Source, Ctx);
+  ASSERT_TRUE(Second);
+  Second->setDataLayout((*TM)->createDataLayout());
+  auto SecondObj = cantFail(Compile(*Second));
+  EXPECT_EQ(Cache.NumCompiled, 1U);
+  EXPECT_EQ(FirstObj->getBuffer(), SecondObj->getBuffer());
+}
+
+} // namespace
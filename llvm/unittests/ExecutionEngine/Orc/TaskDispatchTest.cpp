@@ -34,3 +34,41 @@ TEST(DynamicThreadPoolDispatchTest, GenericNamedTask) {
   D->shutdown();
 }
 #endif
+
+#if LLVM_ENABLE_THREADS
+namespace {
+class TestIdleTask : public RTTIExtends<TestIdleTask, IdleTask> {
+public:
+  TestIdleTask(std::promise<void> P) : P(std::move(P)) {}
+  void printDescription(raw_ostream &OS) override { OS << "test idle task"; }
+  void run() override { P.set_value(); }
+
+private:
+  std::promise<void> P;
+};
+} // namespace
+
+TEST(DynamicThreadPoolDispatchTest, IdleQueueStats) {
+  auto D = std::make_unique<DynamicThreadPoolTaskDispatcher>(1);
+
+  // Occupy the only slot so that the idle task has to wait.
+  std::promise<void> Release;
+  auto Released = Release.get_future().share();
+  D->dispatch(makeGenericNamedTask([Released]() { Released.wait(); }));
+
+  std::promise<void> IdleRan;
+  auto IdleDone = IdleRan.get_future();
+  D->dispatch(std::make_unique<TestIdleTask>(std::move(IdleRan)));
+
+  auto Stats = D->getIdleQueueStats();
+  EXPECT_EQ(Stats.NumQueued, 1u);
+  EXPECT_EQ(Stats.MaxQueueLength, 1u);
+
+  Release.set_value();
+  IdleDone.wait();
+  D->shutdown();
+
+  EXPECT_EQ(D->getMaterializationQueueStats().NumQueued, 0u);
+  EXPECT_GT(D->getIdleQueueStats().TotalWait.count(), 0);
+}
+#endif
@@ -16,6 +16,7 @@
 #include "llvm/IR/Module.h"
 #include "llvm/IR/PassManagerImpl.h"
 #include "llvm/Passes/StandardInstrumentations.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Transforms/Scalar/SimplifyCFG.h"
 #include "gtest/gtest.h"
@@ -808,6 +809,62 @@ TEST_F(PassManagerTest, IndirectAnalysisInvalidation) {
   EXPECT_EQ(3 * 4 * 3, FunctionCount);
 }
 
+TEST_F(PassManagerTest, AnalysisInvalidationReport) {
+  FunctionAnalysisManager FAM;
+  ModuleAnalysisManager MAM;
+  int FunctionAnalysisRuns = 0, ModuleAnalysisRuns = 0;
+  FAM.registerPass([&] { return TestFunctionAnalysis(FunctionAnalysisRuns); });
+  MAM.registerPass([&] { return TestModuleAnalysis(ModuleAnalysisRuns); });
+  MAM.registerPass([&] { return FunctionAnalysisManagerModuleProxy(FAM); });
+  FAM.registerPass([&] { return ModuleAnalysisManagerFunctionProxy(MAM); });
+
+  PassInstrumentationCallbacks PIC;
+  AnalysisInvalidationReporter Reporter(/*Enabled=*/true);
+  Reporter.registerCallbacks(PIC);
+  MAM.registerPass([&] { return PassInstrumentationAnalysis(&PIC); });
+  FAM.registerPass([&] { return PassInstrumentationAnalysis(&PIC); });
+
+  // Compute the analysis for every function, invalidate it for "f" only and
+  // then request it again.
+  int RunCount = 0, InstrCount = 0, FunctionCount = 0;
+  FunctionPassManager FPM;
+  FPM.addPass(TestFunctionPass(RunCount, InstrCount, FunctionCount, MAM));
+  FPM.addPass(TestInvalidationFunctionPass("f"));
+  FPM.addPass(TestFunctionPass(RunCount, InstrCount, FunctionCount, MAM));
+  ModulePassManager MPM;
+  MPM.addPass(createModuleToFunctionPassAdaptor(std::move(FPM)));
+  MPM.run(*M, MAM);
+  EXPECT_EQ(4, FunctionAnalysisRuns);
+
+  std::string Report;
+  raw_string_ostream OS(Report);
+  Reporter.writeReport(OS);
+  Expected<json::Value> Parsed = json::parse(Report);
+  ASSERT_TRUE(bool(Parsed)) << toString(Parsed.takeError());
+  const json::Array *Passes = Parsed->getAsObject()->getArray("passes");
+  ASSERT_TRUE(Passes);
+
+  const json::Object *Invalidating = nullptr;
+  for (const json::Value &P : *Passes) {
+    const json::Object *Obj = P.getAsObject();
+    if (Obj->getString("name")->contains("TestInvalidationFunctionPass"))
+      Invalidating = Obj;
+  }
+  ASSERT_TRUE(Invalidating);
+  EXPECT_EQ(3, Invalidating->getInteger("runs"));
+  EXPECT_EQ(1, Invalidating->getInteger("changed"));
+
+  const json::Object *Invalidated = Invalidating->getObject("invalidated");
+  ASSERT_TRUE(Invalidated);
+  ASSERT_EQ(1u, Invalidated->size());
+  EXPECT_EQ(1, Invalidated->begin()->second.getAsInteger());
+
+  const json::Object *Recomputed = Invalidating->getObject("recomputed");
+  ASSERT_TRUE(Recomputed);
+  ASSERT_EQ(1u, Recomputed->size());
+  EXPECT_EQ(1, Recomputed->begin()->second.getAsInteger());
+}
+
 // Run SimplifyCFGPass that makes CFG changes and reports PreservedAnalyses
 // without CFGAnalyses. So the CFGChecker does not complain.
 TEST_F(PassManagerTest, FunctionPassCFGChecker) {
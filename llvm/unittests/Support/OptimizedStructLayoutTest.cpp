@@ -19,6 +19,7 @@ class LayoutTest {
     Align Alignment;
     uint64_t ForcedOffset;
     uint64_t ExpectedOffset;
+    bool Hot;
   };
 
   SmallVector<Field, 16> Fields;
@@ -33,12 +34,20 @@ public:
   LayoutTest &flexible(uint64_t Size, uint64_t Alignment,
                        uint64_t ExpectedOffset) {
     Fields.push_back({Size, Align(Alignment),
-                      OptimizedStructLayoutField::FlexibleOffset, ExpectedOffset});
+                      OptimizedStructLayoutField::FlexibleOffset,
+                      ExpectedOffset, false});
+    return *this;
+  }
+
+  LayoutTest &hot(uint64_t Size, uint64_t Alignment, uint64_t ExpectedOffset) {
+    Fields.push_back({Size, Align(Alignment),
+                      OptimizedStructLayoutField::FlexibleOffset,
+                      ExpectedOffset, true});
     return *this;
   }
 
   LayoutTest &fixed(uint64_t Size, uint64_t Alignment, uint64_t Offset) {
-    Fields.push_back({Size, Align(Alignment), Offset, Offset});
+    Fields.push_back({Size, Align(Alignment), Offset, Offset, false});
     return *this;
   }
 
@@ -48,7 +57,12 @@ public:
     for (auto &F : Fields)
       LayoutFields.emplace_back(&F, F.Size, F.Alignment, F.ForcedOffset);
 
-    auto SizeAndAlign = performOptimizedStructLayout(LayoutFields);
+    auto IsHot = [](const OptimizedStructLayoutField &LF) {
+      return static_cast<const Field *>(LF.Id)->Hot;
+    };
+    auto SizeAndAlign = any_of(Fields, [](const Field &F) { return F.Hot; })
+                            ? performHotColdStructLayout(LayoutFields, IsHot)
+                            : performOptimizedStructLayout(LayoutFields);
 
     EXPECT_EQ(SizeAndAlign.first, ExpectedSize);
     EXPECT_EQ(SizeAndAlign.second, Align(ExpectedAlignment));
@@ -147,3 +161,24 @@ TEST(OptimizedStructLayoutTest, HighAlignment) {
     .flexible(1, 1, 19)
     .verify(132, 128);
 }
+
+TEST(OptimizedStructLayoutTest, HotCold) {
+  LayoutTest()
+    .flexible(8, 8, 8)
+    .hot(4, 4, 0)
+    .flexible(8, 8, 16)
+    .hot(4, 4, 4)
+    .verify(24, 8);
+}
+
+TEST(OptimizedStructLayoutTest, HotColdPadding) {
+  // Cold fields are laid out after the hot ones, apart from being allowed
+  // into the padding between them.
+  LayoutTest()
+    .fixed(2, 2, 0)
+    .hot(8, 8, 8)
+    .flexible(2, 2, 16)
+    .hot(1, 1, 2)
+    .flexible(4, 4, 4)
+    .verify(18, 8);
+}
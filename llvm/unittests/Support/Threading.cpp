@@ -87,6 +87,13 @@ private:
   mutable std::mutex M;
 };
 
+TEST(Threading, ThreadPoolStrategyFromString) {
+  EXPECT_TRUE(get_threadpool_strategy("jobserver")->UseJobserver);
+  EXPECT_FALSE(get_threadpool_strategy("all")->UseJobserver);
+  EXPECT_EQ(get_threadpool_strategy("3")->ThreadsRequested, 3u);
+  EXPECT_FALSE(get_threadpool_strategy("three"));
+}
+
 TEST(Threading, RunOnThreadSyncAsync) {
   Notification ThreadStarted, ThreadAdvanced, ThreadFinished;
 
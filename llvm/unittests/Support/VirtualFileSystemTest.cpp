@@ -3706,3 +3706,38 @@ TEST(TracingFileSystemTest, PrintOutput) {
             "  InMemoryFileSystem\n",
             Output);
 }
+
+TEST(NegativeLookupCacheFileSystemTest, CachesMisses) {
+  auto InMemoryFS = makeIntrusiveRefCnt<vfs::InMemoryFileSystem>();
+  InMemoryFS->setCurrentWorkingDirectory("/");
+  InMemoryFS->addFile("/present", 0, MemoryBuffer::getMemBuffer("a"));
+  auto TracingFS = makeIntrusiveRefCnt<vfs::TracingFileSystem>(InMemoryFS);
+  auto CachingFS =
+      makeIntrusiveRefCnt<vfs::NegativeLookupCacheFileSystem>(TracingFS);
+
+  auto Missing = CachingFS->status("/missing");
+  EXPECT_EQ(Missing.getError(), errc::no_such_file_or_directory);
+  EXPECT_EQ(TracingFS->NumStatusCalls, 1u);
+
+  // Later lookups of the same path, in any spelling, hit the cache.
+  EXPECT_EQ(CachingFS->status("missing").getError(),
+            errc::no_such_file_or_directory);
+  EXPECT_FALSE(CachingFS->exists("/missing"));
+  EXPECT_EQ(CachingFS->openFileForRead("/missing").getError(),
+            errc::no_such_file_or_directory);
+  EXPECT_EQ(TracingFS->NumStatusCalls, 1u);
+  EXPECT_EQ(TracingFS->NumExistsCalls, 0u);
+  EXPECT_EQ(TracingFS->NumOpenFileForReadCalls, 0u);
+  EXPECT_EQ(CachingFS->getNumCacheHits(), 3u);
+
+  // Files that exist are always looked up.
+  EXPECT_TRUE(CachingFS->status("/present"));
+  EXPECT_TRUE(CachingFS->status("/present"));
+  EXPECT_EQ(TracingFS->NumStatusCalls, 3u);
+
+  // After clearing the cache a newly created file becomes visible.
+  InMemoryFS->addFile("/missing", 0, MemoryBuffer::getMemBuffer("b"));
+  EXPECT_FALSE(CachingFS->status("/missing"));
+  CachingFS->clearCache();
+  EXPECT_TRUE(CachingFS->status("/missing"));
+}
@@ -8,6 +8,15 @@
 
 #include "llvm/Transforms/IPO/WholeProgramDevirt.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/ProfileData/InstrProf.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/SourceMgr.h"
 #include "gtest/gtest.h"
 
 using namespace llvm;
@@ -162,3 +171,131 @@ TEST(WholeProgramDevirt, setReturnValues) {
   EXPECT_EQ((std::vector<uint8_t>{0x81, 0xff, 0xff, 0xff}),
             VT2.After.BytesUsed);
 }
+
+namespace {
+
+// A call through a vtable whose only implementation is @impl. @other is only
+// there to have a second profiled target.
+const char *SpeculativeIR = R"IR(
+  @vt = constant [1 x ptr] [ptr @impl], !type !0
+
+  define i32 @impl(ptr %this) {
+    ret i32 1
+  }
+
+  define i32 @other(ptr %this) {
+    ret i32 2
+  }
+
+  define i32 @call(ptr %obj) {
+    %vtable = load ptr, ptr %obj
+    %p = call i1 @llvm.type.test(ptr %vtable, metadata !"typeid")
+    call void @llvm.assume(i1 %p)
+    %fptr = load ptr, ptr %vtable
+    %r = call i32 %fptr(ptr %obj)
+    ret i32 %r
+  }
+
+  declare i1 @llvm.type.test(ptr, metadata)
+  declare void @llvm.assume(i1)
+
+  !0 = !{i64 0, !"typeid"}
+)IR";
+
+class SpeculativeDevirtTest : public testing::Test {
+protected:
+  void SetUp() override {
+    SMDiagnostic Err;
+    M = parseAssemblyString(SpeculativeIR, Err, Ctx);
+    ASSERT_TRUE(M);
+    Speculate = cl::getRegisteredOptions().lookup("devirtualize-speculatively");
+    ASSERT_NE(Speculate, nullptr);
+    Speculate->addOccurrence(0, "devirtualize-speculatively", "true");
+  }
+
+  void TearDown() override {
+    if (Speculate)
+      Speculate->addOccurrence(0, "devirtualize-speculatively", "false");
+  }
+
+  uint64_t hashOf(StringRef Name) {
+    return IndexedInstrProf::ComputeHash(
+        getIRPGOFuncName(*M->getFunction(Name), /*InLTO=*/true));
+  }
+
+  // Attaches an indirect call value profile to the virtual call in @call.
+  void annotate(ArrayRef<InstrProfValueData> VDs, uint64_t Total) {
+    annotateValueSite(*M, *findIndirectCall(), VDs, Total,
+                      IPVK_IndirectCallTarget, VDs.size());
+  }
+
+  void runDevirt() {
+    LoopAnalysisManager LAM;
+    FunctionAnalysisManager FAM;
+    CGSCCAnalysisManager CGAM;
+    ModuleAnalysisManager MAM;
+    PassBuilder PB;
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+    WholeProgramDevirtPass().run(*M, MAM);
+  }
+
+  CallBase *findIndirectCall() {
+    for (Instruction &I : instructions(M->getFunction("call")))
+      if (auto *CB = dyn_cast<CallBase>(&I))
+        if (!isa<IntrinsicInst>(CB) && CB->isIndirectCall())
+          return CB;
+    return nullptr;
+  }
+
+  bool hasDirectCallToImpl() {
+    for (Instruction &I : instructions(M->getFunction("call")))
+      if (auto *CB = dyn_cast<CallBase>(&I))
+        if (CB->getCalledFunction() == M->getFunction("impl"))
+          return true;
+    return false;
+  }
+
+  LLVMContext Ctx;
+  std::unique_ptr<Module> M;
+  cl::Option *Speculate = nullptr;
+};
+
+} // namespace
+
+TEST_F(SpeculativeDevirtTest, SkipsMostlyMispredictedTarget) {
+  // @impl only gets 30 of the 100 profiled calls.
+  annotate({{hashOf("other"), 70}, {hashOf("impl"), 30}}, 100);
+  runDevirt();
+
+  EXPECT_FALSE(hasDirectCallToImpl());
+  CallBase *CB = findIndirectCall();
+  ASSERT_NE(CB, nullptr);
+  // The profile is left for indirect call promotion.
+  uint64_t Total;
+  auto VDs = getValueProfDataFromInst(*CB, IPVK_IndirectCallTarget,
+                                      /*MaxNumValueData=*/4, Total);
+  EXPECT_EQ(VDs.size(), 2U);
+  EXPECT_EQ(Total, 100U);
+}
+
+TEST_F(SpeculativeDevirtTest, KeepsRemainingTargetsInProfile) {
+  // @impl gets 80 of the 100 profiled calls.
+  annotate({{hashOf("impl"), 80}, {hashOf("other"), 20}}, 100);
+  runDevirt();
+
+  EXPECT_TRUE(hasDirectCallToImpl());
+  CallBase *CB = findIndirectCall();
+  ASSERT_NE(CB, nullptr);
+  // The fallback call only keeps the targets other than @impl.
+  uint64_t Total;
+  auto VDs = getValueProfDataFromInst(*CB, IPVK_IndirectCallTarget,
+                                      /*MaxNumValueData=*/4, Total);
+  ASSERT_EQ(VDs.size(), 1U);
+  EXPECT_EQ(VDs[0].Value, hashOf("other"));
+  EXPECT_EQ(VDs[0].Count, 20U);
+  EXPECT_EQ(Total, 20U);
+}